@@ -18,6 +18,7 @@
 #define C_BASE_TEN_C
 
 #include "c_BaseTen.h"
+#include "c_cryptoRandom.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -43,11 +44,19 @@ extern "C" {
         _baseTen.leftShift = &standardLeftShift;
         
         _baseTen.multiplication = &base10Multiplication;
+        _baseTen.square = &base10Square;
         _baseTen.division = &base10Division;
 		_baseTen.modulo = &base10Modulo;
+		_baseTen.multiplicationFull = &base10MultiplicationFull;
+		_baseTen.moduloFull = &base10ModuloFull;
+		_baseTen.addWord = &base10AdditionWord;
+		_baseTen.mulWord = &base10MultiplicationWord;
+		_baseTen.divmodWord = &base10DivisionWord;
+		_baseTen.modWord = &base10ModuloWord;
         
 		_baseTen.exponentiation = &base10Exponentiation;
 		_baseTen.moduloExponentiation = &base10ModuloExponentiation;
+		_baseTen.moduloExponentiationWord = &base10ModuloExponentiationWord;
 
 		_baseTen.gcd = &base10GCD;
 		_baseTen.modInverse = &base10ModInverse;
@@ -98,193 +107,689 @@ extern "C" {
         if(borrow>0) return 0;
         return 1;
     }
-    //Multiplication
-    int base10Multiplication(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length)
+    //Word addition
+    int base10AdditionWord(const uint32_t* src1, uint32_t src2, uint32_t* dest, uint16_t length)
     {
         if(length<=0) return 0;
 
-		int ret = 1;
-		uint32_t* temp = (uint32_t*) malloc(length*sizeof(uint32_t));
-		uint32_t* targ = (uint32_t*) malloc(length*sizeof(uint32_t));
+        //Stop once the carry is absorbed
+        uint64_t carry=src2;
+        uint16_t cnt=0;
+        for(;cnt<length && carry>0;cnt++)
+        {
+            uint64_t tm=(uint64_t)src1[cnt]+carry;
+            dest[cnt]=(uint32_t)tm;
+            carry=tm>>32;
+        }
+        if(carry>0) return 0;
+        if(dest!=src1)
+            memcpy(dest+cnt,src1+cnt,sizeof(uint32_t)*(length-cnt));
+        return 1;
+    }
+    //Word multiplication
+    int base10MultiplicationWord(const uint32_t* src1, uint32_t src2, uint32_t* dest, uint16_t length)
+    {
+        if(length<=0) return 0;
 
-		//Zero the target
-		memset(targ,0,sizeof(uint32_t)*length);
-		
-		//Preform multiplication
-		for(int cnt=0;cnt<length*32;cnt++)
-		{
-			int bigPos=cnt/32;
-			int smallPos=cnt%32;
-			if(src1[bigPos]&(1<<smallPos))
-			{
-				if(!standardLeftShift(src2,cnt,temp,length))
-					ret = 0;
-				if(!base10Addition(targ,temp,targ,length))
-					ret = 0;
-			}
-		}
+        uint64_t carry=0;
+        for(uint16_t cnt=0;cnt<length;cnt++)
+        {
+            uint64_t tm=(uint64_t)src1[cnt]*src2+carry;
+            dest[cnt]=(uint32_t)tm;
+            carry=tm>>32;
+        }
+        if(carry>0) return 0;
+        return 1;
+    }
+    //Word division
+    int base10DivisionWord(const uint32_t* src1, uint32_t src2, uint32_t* dest, uint32_t* rem, uint16_t length)
+    {
+        if(length<=0) return 0;
+        if(src2==0)
+        {
+            memset(dest,0,sizeof(uint32_t)*length);
+            return 0;
+        }
 
-		memcpy(dest,targ,sizeof(uint32_t)*length);
-		free(targ);
-		free(temp);
-        return ret;
+        //Descending, so dest may overlap src1
+        uint64_t r=0;
+        for(int cnt=length-1;cnt>=0;cnt--)
+        {
+            r=(r<<32)|src1[cnt];
+            dest[cnt]=(uint32_t)(r/src2);
+            r%=src2;
+        }
+        if(rem) *rem=(uint32_t)r;
+        return 1;
     }
-    //Division
-    int base10Division(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length)
+    //Word modulo
+    int base10ModuloWord(const uint32_t* src1, uint32_t src2, uint32_t* rem, uint16_t length)
+    {
+        if(length<=0 || src2==0) return 0;
+
+        uint64_t r=0;
+        for(int cnt=standardUsedLength(src1,length)-1;cnt>=0;cnt--)
+            r=((r<<32)|src1[cnt])%src2;
+        *rem=(uint32_t)r;
+        return 1;
+    }
+    //Multiplication
+    int base10Multiplication(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length)
     {
         if(length<=0) return 0;
+        struct numberScratch* scratch=numberScratchThread();
+        if(!numberScratchReserve(scratch,NUMBER_SCRATCH_SIZE(length))) return 0;
+        return base10MultiplicationScratch(src1,src2,dest,length,scratch);
+    }
+	int base10MultiplicationScratch(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length, struct numberScratch* scratch)
+	{
+		if(length<=0) return 0;
 
-		//Exit if divide by zero
-		int found = 0;
-		for(int cnt=0;cnt<length && !found;cnt++)
+		uint16_t len1=standardUsedLength(src1,length);
+		uint16_t len2=standardUsedLength(src2,length);
+		uint32_t mark=scratch->used;
+
+		//Product may not fit, let the schoolbook loop detect overflow
+		if(len1+len2>length)
 		{
-			if(src2[cnt]!=0)
-				found = 1;
+			uint32_t* targ=numberScratchPush(scratch,length);
+			int ret=base10MultiplyLimbs(src1,len1,src2,len2,targ,length);
+			memcpy(dest,targ,sizeof(uint32_t)*length);
+			scratch->used=mark;
+			return ret;
 		}
 
-		//Zero the target
-		uint32_t* targ = (uint32_t*) malloc(length*sizeof(uint32_t));
-		memset(targ,0,sizeof(uint32_t)*length);
+		uint32_t* targ=dest;
+		if(dest==src1 || dest==src2)
+			targ=numberScratchPush(scratch,len1+len2);
+		base10MultiplyFull(src1,len1,src2,len2,targ,scratch);
 
-		if(!found)
+		if(targ!=dest)
+			memcpy(dest,targ,sizeof(uint32_t)*(len1+len2));
+		memset(dest+len1+len2,0,sizeof(uint32_t)*(length-len1-len2));
+		scratch->used=mark;
+		return 1;
+	}
+	//Squaring
+	int base10Square(const uint32_t* src1, uint32_t* dest, uint16_t length)
+	{
+		if(length<=0) return 0;
+		struct numberScratch* scratch=numberScratchThread();
+		if(!numberScratchReserve(scratch,NUMBER_SCRATCH_SIZE(length))) return 0;
+		return base10SquareScratch(src1,dest,length,scratch);
+	}
+	int base10SquareScratch(const uint32_t* src1, uint32_t* dest, uint16_t length, struct numberScratch* scratch)
+	{
+		if(length<=0) return 0;
+
+		//Product may not fit, let multiplication detect overflow
+		uint16_t len1=standardUsedLength(src1,length);
+		if(2*len1>length)
+			return base10MultiplicationScratch(src1,src1,dest,length,scratch);
+
+		uint32_t mark=scratch->used;
+		uint32_t* targ=numberScratchPush(scratch,2*len1);
+		base10SquareFull(src1,len1,targ,scratch);
+
+		memcpy(dest,targ,sizeof(uint32_t)*2*len1);
+		memset(dest+2*len1,0,sizeof(uint32_t)*(length-2*len1));
+		scratch->used=mark;
+		return 1;
+	}
+	//Schoolbook multiplication
+	int base10MultiplyLimbs(const uint32_t* src1, uint16_t len1, const uint32_t* src2, uint16_t len2, uint32_t* dest, uint16_t length)
+	{
+		int ret = 1;
+		memset(dest,0,sizeof(uint32_t)*length);
+
+		for(int cnt1=0;cnt1<len1;cnt1++)
 		{
-			for(int cnt=0;cnt<length;cnt++)
-				dest[cnt]=targ[cnt];
-			free(targ);
-			return 0;
+			if(src1[cnt1]==0) continue;
+			if(cnt1>=length)
+				return 0;
+
+			//Multiply-accumulate one row
+			uint64_t carry = 0;
+			int cnt2;
+			for(cnt2=0;cnt2<len2 && cnt1+cnt2<length;cnt2++)
+			{
+				uint64_t tm = (uint64_t) src1[cnt1] * (uint64_t) src2[cnt2] + (uint64_t) dest[cnt1+cnt2] + carry;
+				dest[cnt1+cnt2]=(uint32_t)tm;
+				carry = tm>>32;
+			}
+
+			//Row ran off the end of the target
+			if(cnt2<len2)
+				ret = 0;
+			else if(cnt1+len2<length)
+				dest[cnt1+len2]=(uint32_t)carry;
+			else if(carry>0)
+				ret = 0;
 		}
+		return ret;
+	}
+	//Schoolbook squaring
+	void base10SquareLimbs(const uint32_t* src1, uint16_t len1, uint32_t* dest)
+	{
+		memset(dest,0,sizeof(uint32_t)*2*len1);
 
-		uint32_t* temp1 = (uint32_t*) malloc(length*sizeof(uint32_t));
-		uint32_t* temp2 = (uint32_t*) malloc(length*sizeof(uint32_t));
-		
-		//Set temp1 to current src1
-		for(int cnt =0;cnt<length;cnt++)
-			temp1[cnt]=src1[cnt];
+		//Cross products, calculated once
+		for(int cnt1=0;cnt1<len1;cnt1++)
+		{
+			uint64_t carry = 0;
+			for(int cnt2=cnt1+1;cnt2<len1;cnt2++)
+			{
+				uint64_t tm = (uint64_t) src1[cnt1] * (uint64_t) src1[cnt2] + (uint64_t) dest[cnt1+cnt2] + carry;
+				dest[cnt1+cnt2]=(uint32_t)tm;
+				carry = tm>>32;
+			}
+			dest[cnt1+len1]=(uint32_t)carry;
+		}
 
-		//Find starting position of src1
-		int src1_pos=length*32-1;
-		found = 0;
-		while(src1_pos>=0 && !found)
+		//Double the cross products
+		uint32_t topBit = 0;
+		for(int cnt=0;cnt<2*len1;cnt++)
 		{
-			if(src1[src1_pos/32] & (1<<(src1_pos%32)))
-				found = 1;
-			src1_pos--;
+			uint32_t nextBit = dest[cnt]>>31;
+			dest[cnt] = (dest[cnt]<<1) | topBit;
+			topBit = nextBit;
 		}
 
-		//Find starting position of src2
-		int src2_pos=length*32-1;
-		found = 0;
-		while(src2_pos>=0 && !found)
+		//Add the diagonal
+		uint64_t carry = 0;
+		for(int cnt=0;cnt<len1;cnt++)
 		{
-			if(src2[src2_pos/32] & (1<<(src2_pos%32)))
-				found = 1;
-			src2_pos--;
+			uint64_t sq = (uint64_t) src1[cnt] * (uint64_t) src1[cnt];
+			uint64_t tm = (uint64_t) dest[2*cnt] + (uint32_t) sq + carry;
+			dest[2*cnt]=(uint32_t)tm;
+			tm = (uint64_t) dest[2*cnt+1] + (sq>>32) + (tm>>32);
+			dest[2*cnt+1]=(uint32_t)tm;
+			carry = tm>>32;
+		}
+	}
+	//Karatsuba thresholds, test/cryptoBenchmark.cpp measures the crossover on x86-64 at 32-48 and 48-64 uint32_t
+	static uint16_t karatsubaThreshold=32;
+	static uint16_t karatsubaSquareThreshold=64;
+	uint16_t base10GetKaratsubaThreshold() {return karatsubaThreshold;}
+	uint16_t base10GetKaratsubaSquareThreshold() {return karatsubaSquareThreshold;}
+	void base10SetKaratsubaThreshold(uint16_t multiply, uint16_t square)
+	{
+		if(multiply<4) multiply=4;
+		if(square<4) square=4;
+		karatsubaThreshold=multiply;
+		karatsubaSquareThreshold=square;
+	}
+	//Add src1 into dest, propagating the carry through length elements
+	static void addLimbsInto(const uint32_t* src1, uint16_t len1, uint32_t* dest, uint32_t length)
+	{
+		uint64_t carry=0;
+		uint32_t cnt;
+		for(cnt=0;cnt<len1;cnt++)
+		{
+			carry+=(uint64_t)dest[cnt]+src1[cnt];
+			dest[cnt]=(uint32_t)carry;
+			carry>>=32;
+		}
+		for(;carry && cnt<length;cnt++)
+		{
+			carry+=dest[cnt];
+			dest[cnt]=(uint32_t)carry;
+			carry>>=32;
+		}
+	}
+	//Subtract src1 from dest, propagating the borrow through length elements
+	static void subLimbsFrom(const uint32_t* src1, uint16_t len1, uint32_t* dest, uint32_t length)
+	{
+		uint64_t borrow=0;
+		uint32_t cnt;
+		for(cnt=0;cnt<len1;cnt++)
+		{
+			uint64_t sub=(uint64_t)src1[cnt]+borrow;
+			borrow=dest[cnt]<sub;
+			dest[cnt]=(uint32_t)(dest[cnt]-sub);
+		}
+		for(;borrow && cnt<length;cnt++)
+		{
+			borrow=dest[cnt]==0;
+			dest[cnt]--;
+		}
+	}
+	//Full width multiplication
+	void base10MultiplyFull(const uint32_t* src1, uint16_t len1, const uint32_t* src2, uint16_t len2, uint32_t* dest, struct numberScratch* scratch)
+	{
+		if(len1<len2)
+		{
+			const uint32_t* tsrc=src1;
+			src1=src2;
+			src2=tsrc;
+			uint16_t tlen=len1;
+			len1=len2;
+			len2=tlen;
+		}
+		if(len2<karatsubaThreshold)
+		{
+			base10MultiplyLimbs(src1,len1,src2,len2,dest,len1+len2);
+			return;
 		}
+		uint32_t mark=scratch->used;
 
-		//Found the two starting positions, calculate division
-		for(int cnt=src1_pos-src2_pos;cnt>=0;cnt--)
+		//Unbalanced, multiply src2 by len2 sized pieces of src1
+		if(len1!=len2)
 		{
-			//Preform shift
-			if(!standardLeftShift(src2,cnt,temp2,length))
+			memset(dest,0,sizeof(uint32_t)*(len1+len2));
+			uint32_t* temp=numberScratchPush(scratch,2*len2);
+			for(uint16_t off=0;off<len1;off+=len2)
 			{
-				//Shouldn't ever get here
-				free(temp1);
-				free(temp2);
-				for(int cnt=0;cnt<length;cnt++)
-					dest[cnt]=targ[cnt];
-				free(targ);
-				return 0;
+				uint16_t chunk=len1-off<len2?len1-off:len2;
+				base10MultiplyFull(src1+off,chunk,src2,len2,temp,scratch);
+				addLimbsInto(temp,chunk+len2,dest+off,len1+len2-off);
 			}
+			scratch->used=mark;
+			return;
+		}
 
-			//If temp1>=temp2, subtract and bind to output
-			if(standardCompare(temp1,temp2,length)>=0)
-			{
-				targ[cnt/32]=targ[cnt/32] | (1<<(cnt%32));
-				base10Subtraction(temp1,temp2,temp1,length);
-				
-			}
+		//(a1*B+a0)*(b1*B+b0)=z2*B^2+z1*B+z0, z1=(a0+a1)*(b0+b1)-z2-z0
+		uint16_t low=len1/2;
+		uint16_t high=len1-low;
+		base10MultiplyFull(src1,low,src2,low,dest,scratch);
+		base10MultiplyFull(src1+low,high,src2+low,high,dest+2*low,scratch);
+
+		uint32_t* sum1=numberScratchPush(scratch,high+1);
+		uint32_t* sum2=numberScratchPush(scratch,high+1);
+		uint32_t* mid=numberScratchPush(scratch,2*high+2);
+		memcpy(sum1,src1+low,sizeof(uint32_t)*high);
+		sum1[high]=0;
+		addLimbsInto(src1,low,sum1,high+1);
+		memcpy(sum2,src2+low,sizeof(uint32_t)*high);
+		sum2[high]=0;
+		addLimbsInto(src2,low,sum2,high+1);
+
+		base10MultiplyFull(sum1,high+1,sum2,high+1,mid,scratch);
+		subLimbsFrom(dest,2*low,mid,2*high+2);
+		subLimbsFrom(dest+2*low,2*high,mid,2*high+2);
+		addLimbsInto(mid,2*high+2,dest+low,2*len1-low);
+		scratch->used=mark;
+	}
+	//Full width squaring
+	void base10SquareFull(const uint32_t* src1, uint16_t len1, uint32_t* dest, struct numberScratch* scratch)
+	{
+		if(len1<karatsubaSquareThreshold)
+		{
+			base10SquareLimbs(src1,len1,dest);
+			return;
 		}
+		uint32_t mark=scratch->used;
+
+		//(a1*B+a0)^2=z2*B^2+z1*B+z0, z1=(a0+a1)^2-z2-z0
+		uint16_t low=len1/2;
+		uint16_t high=len1-low;
+		base10SquareFull(src1,low,dest,scratch);
+		base10SquareFull(src1+low,high,dest+2*low,scratch);
+
+		uint32_t* sum=numberScratchPush(scratch,high+1);
+		uint32_t* mid=numberScratchPush(scratch,2*high+2);
+		memcpy(sum,src1+low,sizeof(uint32_t)*high);
+		sum[high]=0;
+		addLimbsInto(src1,low,sum,high+1);
+
+		base10SquareFull(sum,high+1,mid,scratch);
+		subLimbsFrom(dest,2*low,mid,2*high+2);
+		subLimbsFrom(dest+2*low,2*high,mid,2*high+2);
+		addLimbsInto(mid,2*high+2,dest+low,2*len1-low);
+		scratch->used=mark;
+	}
+    //Division
+    int base10Division(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length)
+    {
+        if(length<=0) return 0;
+        struct numberScratch* scratch=numberScratchThread();
+        if(!numberScratchReserve(scratch,NUMBER_SCRATCH_SIZE(length))) return 0;
+        return base10DivisionScratch(src1,src2,dest,length,scratch);
+    }
+    int base10DivisionScratch(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length, struct numberScratch* scratch)
+    {
+        if(length<=0) return 0;
 
-		free(temp1);
-		free(temp2);
+		//Exit if divide by zero
+		uint16_t len2=standardUsedLength(src2,length);
+		if(len2==0)
+		{
+			memset(dest,0,sizeof(uint32_t)*length);
+			return 0;
+		}
 
-		memcpy(dest,targ,sizeof(uint32_t)*length);
-		free(targ);
+		//Quotient is zero if src1 is shorter than src2
+		uint16_t len1=standardUsedLength(src1,length);
+		if(len1<len2)
+		{
+			memset(dest,0,sizeof(uint32_t)*length);
+			return 1;
+		}
+
+		base10DivideLimbs(src1,len1,src2,len2,dest,NULL,scratch);
+		memset(dest+len1-len2+1,0,sizeof(uint32_t)*(length-(len1-len2+1)));
         return 1;
     }
 	//Modulo
 	int base10Modulo(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length)
+	{
+		if(length<=0) return 0;
+		struct numberScratch* scratch=numberScratchThread();
+		if(!numberScratchReserve(scratch,NUMBER_SCRATCH_SIZE(length))) return 0;
+		return base10ModuloScratch(src1,src2,dest,length,scratch);
+	}
+	int base10ModuloScratch(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length, struct numberScratch* scratch)
 	{
 		if(length<=0) return 0;
 
 		//Exit if divide by zero
-		int found = 0;
-		for(int cnt=0;cnt<length && !found;cnt++)
+		uint16_t len2=standardUsedLength(src2,length);
+		if(len2==0)
 		{
-			if(src2[cnt]!=0)
-				found = 1;
+			//Zero the target
+			memset((void*) dest,0,sizeof(uint32_t)*length);
+			return 0;
 		}
 
-		if(!found)
+		//Remainder is src1 if src1 is shorter than src2
+		uint16_t len1=standardUsedLength(src1,length);
+		if(len1<len2)
+		{
+			if(dest!=src1)
+				memcpy(dest,src1,sizeof(uint32_t)*length);
+			return 1;
+		}
+
+		base10DivideLimbs(src1,len1,src2,len2,NULL,dest,scratch);
+		memset(dest+len2,0,sizeof(uint32_t)*(length-len2));
+        return 1;
+	}
+	//Full width multiplication
+	int base10MultiplicationFull(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length)
+	{
+		if(length<=0) return 0;
+		struct numberScratch* scratch=numberScratchThread();
+		if(!numberScratchReserve(scratch,NUMBER_SCRATCH_SIZE(length))) return 0;
+		return base10MultiplicationFullScratch(src1,src2,dest,length,scratch);
+	}
+	int base10MultiplicationFullScratch(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length, struct numberScratch* scratch)
+	{
+		if(length<=0) return 0;
+
+		uint16_t len1=standardUsedLength(src1,length);
+		uint16_t len2=standardUsedLength(src2,length);
+		uint32_t mark=scratch->used;
+		uint32_t* targ=numberScratchPush(scratch,len1+len2);
+		if(len1==0 || len2==0)
+			len1=len2=0;
+		else if(src1==src2)
+			base10SquareFull(src1,len1,targ,scratch);
+		else
+			base10MultiplyFull(src1,len1,src2,len2,targ,scratch);
+
+		memcpy(dest,targ,sizeof(uint32_t)*(len1+len2));
+		memset(dest+len1+len2,0,sizeof(uint32_t)*(2*length-len1-len2));
+		scratch->used=mark;
+		return 1;
+	}
+	//Full width modulo
+	int base10ModuloFull(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length)
+	{
+		if(length<=0) return 0;
+		struct numberScratch* scratch=numberScratchThread();
+		if(!numberScratchReserve(scratch,NUMBER_SCRATCH_SIZE(length))) return 0;
+		return base10ModuloFullScratch(src1,src2,dest,length,scratch);
+	}
+	int base10ModuloFullScratch(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length, struct numberScratch* scratch)
+	{
+		if(length<=0) return 0;
+
+		//Exit if divide by zero
+		uint16_t len2=standardUsedLength(src2,length);
+		if(len2==0)
 		{
-			//Zero the target
 			memset((void*) dest,0,sizeof(uint32_t)*length);
 			return 0;
 		}
 
-		uint32_t* temp1 = (uint32_t*) malloc(length*sizeof(uint32_t));
-		uint32_t* temp2 = (uint32_t*) malloc(length*sizeof(uint32_t));
-		
-		//Set temp1 to current src1
-		memcpy(temp1,src1,sizeof(uint32_t)*length);
+		//Remainder is src1 if src1 is shorter than src2
+		uint16_t len1=standardUsedLength(src1,2*length);
+		if(len1<len2)
+		{
+			memmove(dest,src1,sizeof(uint32_t)*len1);
+			memset(dest+len1,0,sizeof(uint32_t)*(length-len1));
+			return 1;
+		}
 
-		//Find starting position of src1
-		int src1_pos=length*32-1;
-		found = 0;
-		while(src1_pos>=0 && !found)
+		base10DivideLimbs(src1,len1,src2,len2,NULL,dest,scratch);
+		memset(dest+len2,0,sizeof(uint32_t)*(length-len2));
+		return 1;
+	}
+	//Modular product, src3 is modLen uint32_t with a non-zero top element
+	static void base10ModularMultiply(const uint32_t* src1, const uint32_t* src2, const uint32_t* src3, uint16_t modLen, uint32_t* dest, uint16_t length, struct numberScratch* scratch)
+	{
+		uint16_t len1=standardUsedLength(src1,length);
+		uint16_t len2=standardUsedLength(src2,length);
+		if(len1==0 || len2==0)
 		{
-			if(src1[src1_pos/32] & (1<<(src1_pos%32)))
-				found = 1;
-			src1_pos--;
+			memset((void*) dest,0,sizeof(uint32_t)*length);
+			return;
 		}
 
-		//Find starting position of src2
-		int src2_pos=length*32-1;
-		found = 0;
-		while(src2_pos>=0 && !found)
+		uint32_t mark=scratch->used;
+		uint32_t* prod=numberScratchPush(scratch,len1+len2);
+		if(src1==src2)
+			base10SquareFull(src1,len1,prod,scratch);
+		else
+			base10MultiplyFull(src1,len1,src2,len2,prod,scratch);
+
+		memset((void*) dest,0,sizeof(uint32_t)*length);
+		if(len1+len2<modLen)
+			memcpy((void*) dest,prod,sizeof(uint32_t)*(len1+len2));
+		else
+			base10DivideLimbs(prod,len1+len2,src3,modLen,NULL,dest,scratch);
+		scratch->used=mark;
+	}
+	//Long division
+	void base10DivideLimbs(const uint32_t* src1, uint16_t len1, const uint32_t* src2, uint16_t len2, uint32_t* quot, uint32_t* rem, struct numberScratch* scratch)
+	{
+		//Single limb divisor
+		if(len2==1)
 		{
-			if(src2[src2_pos/32] & (1<<(src2_pos%32)))
-				found = 1;
-			src2_pos--;
+			uint64_t d=src2[0];
+			uint64_t r=0;
+			for(int cnt=len1-1;cnt>=0;cnt--)
+			{
+				uint64_t num=(r<<32)|src1[cnt];
+				r=num%d;
+				if(quot) quot[cnt]=(uint32_t)(num/d);
+			}
+			if(rem) rem[0]=(uint32_t)r;
+			return;
 		}
 
-		//Found the two starting positions, calculate division
-		for(int cnt=src1_pos-src2_pos;cnt>=0;cnt--)
+		//Normalize so the top bit of the divisor is set
+		uint32_t mark=scratch->used;
+		uint32_t* un=numberScratchPush(scratch,len1+1+len2);
+		uint32_t* vn=un+len1+1;
+		int shift=0;
+		for(uint32_t top=src2[len2-1];!(top&0x80000000);top<<=1)
+			shift++;
+		for(int cnt=len2-1;cnt>0;cnt--)
+			vn[cnt]=(src2[cnt]<<shift)|(shift?src2[cnt-1]>>(32-shift):0);
+		vn[0]=src2[0]<<shift;
+		un[len1]=shift?src1[len1-1]>>(32-shift):0;
+		for(int cnt=len1-1;cnt>0;cnt--)
+			un[cnt]=(src1[cnt]<<shift)|(shift?src1[cnt-1]>>(32-shift):0);
+		un[0]=src1[0]<<shift;
+
+		for(int j=len1-len2;j>=0;j--)
 		{
-			//Preform shift
-			if(!standardLeftShift(src2,cnt,temp2,length))
+			//Estimate quotient limb from the top two limbs
+			uint64_t num=((uint64_t)un[j+len2]<<32)|un[j+len2-1];
+			uint64_t qhat=num/vn[len2-1];
+			uint64_t rhat=num%vn[len2-1];
+			while(qhat>>32 || qhat*vn[len2-2]>((rhat<<32)|un[j+len2-2]))
 			{
-				//Shouldn't ever get here
-                memset(dest,0,sizeof(uint32_t)*length);
-				free(temp1);
-				free(temp2);
-				return 0;
+				qhat--;
+				rhat+=vn[len2-1];
+				if(rhat>>32) break;
+			}
+
+			//Multiply and subtract
+			int64_t borrow=0;
+			int64_t t;
+			for(int cnt=0;cnt<len2;cnt++)
+			{
+				uint64_t p=qhat*vn[cnt];
+				t=(int64_t)un[cnt+j]-borrow-(int64_t)(p&0xFFFFFFFF);
+				un[cnt+j]=(uint32_t)t;
+				borrow=(int64_t)(p>>32)-(t>>32);
 			}
+			t=(int64_t)un[j+len2]-borrow;
+			un[j+len2]=(uint32_t)t;
 
-			//If temp1>=temp2, subtract and bind to output
-			if(standardCompare(temp1,temp2,length)>=0)
-				base10Subtraction(temp1,temp2,temp1,length);
+			//Estimate was one too large, add back
+			if(t<0)
+			{
+				qhat--;
+				uint64_t carry=0;
+				for(int cnt=0;cnt<len2;cnt++)
+				{
+					carry+=(uint64_t)un[cnt+j]+vn[cnt];
+					un[cnt+j]=(uint32_t)carry;
+					carry>>=32;
+				}
+				un[j+len2]+=(uint32_t)carry;
+			}
+			if(quot) quot[j]=(uint32_t)qhat;
 		}
 
-		//Copy from temp into destination
-		memcpy(dest,temp1,sizeof(uint32_t)*length);
+		//Denormalize the remainder
+		if(rem)
+		{
+			for(int cnt=0;cnt<len2-1;cnt++)
+				rem[cnt]=(un[cnt]>>shift)|(shift?un[cnt+1]<<(32-shift):0);
+			rem[len2-1]=un[len2-1]>>shift;
+		}
+		scratch->used=mark;
+	}
+	//Bit length
+	uint32_t base10BitLength(const uint32_t* src1, uint16_t length)
+	{
+		uint16_t len=standardUsedLength(src1,length);
+		if(len==0) return 0;
+		uint32_t bits=32*(uint32_t)len;
+		for(uint32_t top=src1[len-1];!(top&0x80000000);top<<=1)
+			bits--;
+		return bits;
+	}
+	//Window size by exponent length
+	uint16_t base10WindowSize(uint32_t bits, uint16_t max)
+	{
+		uint16_t window=1;
+		if(bits>671) window=6;
+		else if(bits>239) window=5;
+		else if(bits>79) window=4;
+		else if(bits>23) window=3;
+		if(window>max) window=max;
+		if(window<1) window=1;
+		return window;
+	}
+	//Sliding window scan
+	uint16_t base10ExponentWindow(const uint32_t* src1, uint32_t top, uint16_t window, uint32_t* val)
+	{
+		//Lowest bit of the window must be set
+		uint32_t low=top+1<window?0:top+1-window;
+		while(!(src1[low/32]&((uint32_t)1<<(low%32))))
+			low++;
+
+		*val=0;
+		for(uint32_t bit=top+1;bit>low;bit--)
+			*val=(*val<<1)|((src1[(bit-1)/32]>>((bit-1)%32))&1);
+		return (uint16_t)(top+1-low);
+	}
+	//Sliding window product, reduced by src3 if it is not NULL
+	static int base10SlidingProduct(const uint32_t* src1, const uint32_t* src2, const uint32_t* src3, uint16_t modLen, uint32_t* dest, uint16_t length, struct numberScratch* scratch)
+	{
+		if(src3)
+		{
+			base10ModularMultiply(src1,src2,src3,modLen,dest,length,scratch);
+			return 1;
+		}
+		if(src1==src2)
+			return base10SquareScratch(src1,dest,length,scratch);
+		return base10MultiplicationScratch(src1,src2,dest,length,scratch);
+	}
+	//Left-to-right sliding window, src3 is NULL for plain exponentiation
+	static int base10SlidingExponentiation(const uint32_t* src1, const uint32_t* src2, const uint32_t* src3, uint32_t* dest, uint16_t length, struct numberScratch* scratch)
+	{
+		uint32_t bits=base10BitLength(src2,length);
+		uint16_t window=base10WindowSize(bits,4);
+		uint32_t count=(uint32_t)1<<(window-1);
+		uint16_t modLen=src3?standardUsedLength(src3,length):0;
+		uint32_t mark=scratch->used;
+		uint32_t* acc=numberScratchPush(scratch,length);
+		uint32_t* square=numberScratchPush(scratch,length);
+		uint32_t* table=numberScratchPush(scratch,count*length);
+
+		//Odd powers src1, src1^3, ..., entries which overflowed are not valid
+		uint32_t valid=1;
+		if(src3) base10ModuloScratch(src1,src3,table,length,scratch);
+		else memcpy((void*) table,src1,sizeof(uint32_t)*length);
+		if(count>1)
+		{
+			int cur_state=base10SlidingProduct(table,table,src3,modLen,square,length,scratch);
+			for(uint32_t cnt=1;cnt<count && cur_state;cnt++)
+			{
+				cur_state=base10SlidingProduct(table+(cnt-1)*length,square,src3,modLen,table+cnt*length,length,scratch);
+				if(cur_state) valid|=(uint32_t)1<<cnt;
+			}
+		}
 
-		free(temp1);
-		free(temp2);
-        return 1;
+		memset((void*) acc,0,sizeof(uint32_t)*length);
+		acc[0]=1;
+
+		int first=1;
+		int ret_state=1;
+		for(int32_t cnt=(int32_t)bits-1;cnt>=0 && ret_state;)
+		{
+			uint32_t val=0;
+			uint16_t width=1;
+			if(src2[cnt/32]&((uint32_t)1<<(cnt%32)))
+				width=base10ExponentWindow(src2,cnt,window,&val);
+			cnt-=width;
+
+			//The top window starts from its table entry
+			if(first)
+			{
+				if(!(valid&((uint32_t)1<<(val>>1)))) ret_state=0;
+				memcpy((void*) acc,table+(val>>1)*length,sizeof(uint32_t)*length);
+				first=0;
+				continue;
+			}
+			for(uint16_t cnt2=0;cnt2<width && ret_state;cnt2++)
+				ret_state=base10SlidingProduct(acc,acc,src3,modLen,acc,length,scratch);
+			if(val && ret_state)
+			{
+				if(!(valid&((uint32_t)1<<(val>>1))) || !base10SlidingProduct(acc,table+(val>>1)*length,src3,modLen,acc,length,scratch))
+					ret_state=0;
+			}
+		}
+
+		memcpy((void*) dest,acc,sizeof(uint32_t)*length);
+		scratch->used=mark;
+		return ret_state;
 	}
 	//Exponentiation
 	int base10Exponentiation(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length)
+	{
+		if(length<=0) return 0;
+		struct numberScratch* scratch=numberScratchThread();
+		if(!numberScratchReserve(scratch,NUMBER_SCRATCH_SIZE(length))) return 0;
+		return base10ExponentiationScratch(src1,src2,dest,length,scratch);
+	}
+	int base10ExponentiationScratch(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length, struct numberScratch* scratch)
 	{
 		//Zero return is error
         if(length<=0) return 0;
@@ -299,36 +804,177 @@ extern "C" {
 			return 1;
 		}
 
-		uint32_t* temp1 = (uint32_t*) malloc(length*sizeof(uint32_t));
-		uint32_t* temp2 = (uint32_t*) malloc(length*sizeof(uint32_t));
+		return base10SlidingExponentiation(src1,src2,NULL,dest,length,scratch);
+	}
+	//Montgomery context
+	int base10MontgomeryInit(struct montgomeryContext* ctx, const uint32_t* mod, uint16_t length, struct numberScratch* scratch)
+	{
+		memset((void*) ctx,0,sizeof(struct montgomeryContext));
+		if(length<=0) return 0;
+
+		//Montgomery form requires an odd modulus greater than one
+		uint16_t modLen=standardUsedLength(mod,length);
+		if(modLen==0 || !(mod[0]&1) || (modLen==1 && mod[0]==1)) return 0;
 
-		//Zero
-		memset((void*) temp1,0,sizeof(uint32_t)*length);
-		memcpy((void*) temp2,src1,sizeof(uint32_t)*length);
-		temp1[0]=1;
-		
-		int cur_state=1;
-		int ret_state=1;
-		for(cnt=0;cnt<32*length && ret_state;cnt++)
+		ctx->length=modLen;
+		if(scratch)
+			ctx->modulus=numberScratchPush(scratch,2*modLen);
+		else
+		{
+			ctx->buffer=(uint32_t*) malloc(2*modLen*sizeof(uint32_t));
+			ctx->modulus=ctx->buffer;
+		}
+		ctx->rSquared=ctx->modulus+modLen;
+		memcpy((void*) ctx->modulus,mod,sizeof(uint32_t)*modLen);
+
+		//n'=-n^-1 mod 2^32, Newton iteration doubles the correct bits
+		uint32_t inv=mod[0];
+		for(int cnt=0;cnt<4;cnt++)
+			inv*=2-mod[0]*inv;
+		ctx->nPrime=(uint32_t)0-inv;
+
+		//R^2 mod n, one division of 2^(64*modLen)
+		struct numberScratch* work=scratch;
+		if(!work)
 		{
-			int bigPos=cnt/32;
-			int smallPos=cnt%32;
-			if(src2[bigPos]&(1<<smallPos))
+			work=numberScratchThread();
+			if(!numberScratchReserve(work,NUMBER_SCRATCH_SIZE(modLen)))
 			{
-				if(!cur_state || !base10Multiplication(temp1,temp2,temp1,length))
-					ret_state=0;
+				base10MontgomeryFree(ctx);
+				return 0;
+			}
+		}
+		uint32_t mark=work->used;
+		uint32_t* rPower=numberScratchPush(work,2*modLen+1);
+		memset((void*) rPower,0,sizeof(uint32_t)*2*modLen);
+		rPower[2*modLen]=1;
+		base10DivideLimbs(rPower,2*modLen+1,ctx->modulus,modLen,NULL,ctx->rSquared,work);
+		work->used=mark;
+		return 1;
+	}
+	//Free Montgomery context
+	void base10MontgomeryFree(struct montgomeryContext* ctx)
+	{
+		if(ctx->buffer) free(ctx->buffer);
+		memset((void*) ctx,0,sizeof(struct montgomeryContext));
+	}
+	//Montgomery reduction
+	void base10MontgomeryReduce(const struct montgomeryContext* ctx, uint32_t* src1, uint32_t* dest)
+	{
+		uint16_t len=ctx->length;
+		const uint32_t* mod=ctx->modulus;
+		for(uint16_t cnt=0;cnt<len;cnt++)
+		{
+			uint32_t m=src1[cnt]*ctx->nPrime;
+			uint64_t carry=0;
+			for(uint16_t cnt2=0;cnt2<len;cnt2++)
+			{
+				carry+=(uint64_t)m*mod[cnt2]+src1[cnt+cnt2];
+				src1[cnt+cnt2]=(uint32_t)carry;
+				carry>>=32;
+			}
+			for(uint16_t cnt2=cnt+len;carry && cnt2<=2*len;cnt2++)
+			{
+				carry+=src1[cnt2];
+				src1[cnt2]=(uint32_t)carry;
+				carry>>=32;
+			}
+		}
+
+		//Result is below 2n, subtract once if needed
+		if(src1[2*len] || standardCompare(src1+len,mod,len)>=0)
+			base10Subtraction(src1+len,mod,src1+len,len);
+		memcpy((void*) dest,src1+len,sizeof(uint32_t)*len);
+	}
+	//Montgomery multiplication
+	void base10MontgomeryMultiply(const struct montgomeryContext* ctx, const uint32_t* src1, const uint32_t* src2, uint32_t* dest, struct numberScratch* scratch)
+	{
+		uint16_t len=ctx->length;
+		uint32_t mark=scratch->used;
+		uint32_t* work=numberScratchPush(scratch,2*len+1);
+		base10MultiplyFull(src1,len,src2,len,work,scratch);
+		work[2*len]=0;
+		base10MontgomeryReduce(ctx,work,dest);
+		scratch->used=mark;
+	}
+	//Montgomery squaring
+	void base10MontgomerySquare(const struct montgomeryContext* ctx, const uint32_t* src1, uint32_t* dest, struct numberScratch* scratch)
+	{
+		uint16_t len=ctx->length;
+		uint32_t mark=scratch->used;
+		uint32_t* work=numberScratchPush(scratch,2*len+1);
+		base10SquareFull(src1,len,work,scratch);
+		work[2*len]=0;
+		base10MontgomeryReduce(ctx,work,dest);
+		scratch->used=mark;
+	}
+	//Montgomery exponentiation
+	int base10MontgomeryExponentiation(const struct montgomeryContext* ctx, const uint32_t* src1, const uint32_t* src2, uint16_t expLength, uint32_t* dest, struct numberScratch* scratch)
+	{
+		uint16_t len=ctx->length;
+		uint32_t bits=base10BitLength(src2,expLength);
+		uint16_t window=base10WindowSize(bits,5);
+		uint32_t count=(uint32_t)1<<(window-1);
+		uint32_t mark=scratch->used;
+		uint32_t* acc=numberScratchPush(scratch,len);
+		uint32_t* work=numberScratchPush(scratch,2*len+1);
+		uint32_t* table=numberScratchPush(scratch,count*len);
+
+		//Convert to Montgomery form: base*R^2*R^-1
+		base10MontgomeryMultiply(ctx,src1,ctx->rSquared,table,scratch);
+
+		//Odd powers base^3, base^5, ... from base^2
+		if(count>1)
+		{
+			base10MontgomerySquare(ctx,table,acc,scratch);
+			for(uint32_t cnt=1;cnt<count;cnt++)
+				base10MontgomeryMultiply(ctx,table+(cnt-1)*len,acc,table+cnt*len,scratch);
+		}
+
+		//R mod n is 1 in Montgomery form
+		memset((void*) work,0,sizeof(uint32_t)*(2*len+1));
+		memcpy((void*) work,ctx->rSquared,sizeof(uint32_t)*len);
+		base10MontgomeryReduce(ctx,work,acc);
+
+		//Left-to-right sliding window from the top set bit
+		int first=1;
+		for(int32_t cnt=(int32_t)bits-1;cnt>=0;)
+		{
+			uint32_t val=0;
+			uint16_t width=1;
+			if(src2[cnt/32]&((uint32_t)1<<(cnt%32)))
+				width=base10ExponentWindow(src2,cnt,window,&val);
+			cnt-=width;
+
+			if(first)
+			{
+				memcpy((void*) acc,table+(val>>1)*len,sizeof(uint32_t)*len);
+				first=0;
+				continue;
 			}
-			cur_state=base10Multiplication(temp2,temp2,temp2,length);
+			for(uint16_t cnt2=0;cnt2<width;cnt2++)
+				base10MontgomerySquare(ctx,acc,acc,scratch);
+			if(val)
+				base10MontgomeryMultiply(ctx,acc,table+(val>>1)*len,acc,scratch);
 		}
 
-		memcpy((void*) dest,temp1,sizeof(uint32_t)*length);
-		free(temp1);
-		free(temp2);
+		//Convert out of Montgomery form
+		memset((void*) work,0,sizeof(uint32_t)*(2*len+1));
+		memcpy((void*) work,acc,sizeof(uint32_t)*len);
+		base10MontgomeryReduce(ctx,work,dest);
 
-		return ret_state;
+		scratch->used=mark;
+		return 1;
 	}
 	//Modulo exponentiation
 	int base10ModuloExponentiation(const uint32_t* src1, const uint32_t* src2,const uint32_t* src3, uint32_t* dest, uint16_t length)
+	{
+		if(length<=0) return 0;
+		struct numberScratch* scratch=numberScratchThread();
+		if(!numberScratchReserve(scratch,NUMBER_SCRATCH_SIZE(length))) return 0;
+		return base10ModuloExponentiationScratch(src1,src2,src3,dest,length,scratch);
+	}
+	int base10ModuloExponentiationScratch(const uint32_t* src1, const uint32_t* src2,const uint32_t* src3, uint32_t* dest, uint16_t length, struct numberScratch* scratch)
 	{
 		//Zero return is error
         if(length<=0) return 0;
@@ -357,168 +1003,394 @@ extern "C" {
 			return 1;
 		}
 
-		uint32_t* temp1 = (uint32_t*) malloc(length*sizeof(uint32_t));
-		uint32_t* temp2 = (uint32_t*) malloc(length*sizeof(uint32_t));
+		//Short exponents skip the Montgomery set-up
+		if(base10BitLength(src2,length)<=32)
+			return base10ModuloExponentiationWordScratch(src1,src2[0],src3,dest,length,scratch);
 
-		//Zero
-		memset((void*) temp1,0,sizeof(uint32_t)*length);
-		memcpy((void*) temp2,src1,sizeof(uint32_t)*length);
-		temp1[0]=1;
-		
-		int cur_state=1;
-		int ret_state=1;
-		for(cnt=0;cnt<32*length && ret_state;cnt++)
+		//Montgomery form for odd moduli, full width products otherwise
+		uint16_t modLen=standardUsedLength(src3,length);
+		uint32_t mark=scratch->used;
+		struct montgomeryContext ctx;
+		if(base10MontgomeryInit(&ctx,src3,length,scratch))
 		{
-			int bigPos=cnt/32;
-			int smallPos=cnt%32;
-			if(src2[bigPos]&(1<<smallPos))
-			{
-				if(!cur_state || !base10Multiplication(temp1,temp2,temp1,length))
-					ret_state=0;
-				base10Modulo(temp1,src3,temp1,length);
-			}
-			cur_state=base10Multiplication(temp2,temp2,temp2,length);
-			base10Modulo(temp2,src3,temp2,length);
+			uint32_t* temp1 = numberScratchPush(scratch,length);
+			if(standardUsedLength(src1,length)>modLen)
+				base10ModuloScratch(src1,src3,temp1,length,scratch);
+			else
+				memcpy((void*) temp1,src1,sizeof(uint32_t)*length);
+
+			base10MontgomeryExponentiation(&ctx,temp1,src2,length,temp1,scratch);
+			memset((void*) dest,0,sizeof(uint32_t)*length);
+			memcpy((void*) dest,temp1,sizeof(uint32_t)*modLen);
+
+			base10MontgomeryFree(&ctx);
+			scratch->used=mark;
+			return 1;
 		}
 
-		memcpy((void*) dest,temp1,sizeof(uint32_t)*length);
-		free(temp1);
-		free(temp2);
+		return base10SlidingExponentiation(src1,src2,src3,dest,length,scratch);
+	}
+	//Word exponent modulo exponentiation
+	int base10ModuloExponentiationWord(const uint32_t* src1, uint32_t src2, const uint32_t* src3, uint32_t* dest, uint16_t length)
+	{
+		if(length<=0) return 0;
+		struct numberScratch* scratch=numberScratchThread();
+		if(!numberScratchReserve(scratch,NUMBER_SCRATCH_SIZE(length))) return 0;
+		return base10ModuloExponentiationWordScratch(src1,src2,src3,dest,length,scratch);
+	}
+	int base10ModuloExponentiationWordScratch(const uint32_t* src1, uint32_t src2, const uint32_t* src3, uint32_t* dest, uint16_t length, struct numberScratch* scratch)
+	{
+		if(length<=0) return 0;
 
-		return ret_state;
+		//Exit if divide by zero
+		if(standardUsedLength(src3,length)==0)
+		{
+			memset((void*) dest,0,sizeof(uint32_t)*length);
+			return 0;
+		}
+
+		uint16_t modLen=standardUsedLength(src3,length);
+		uint32_t mark=scratch->used;
+		uint32_t* base=numberScratchPush(scratch,length);
+		uint32_t* acc=numberScratchPush(scratch,length);
+		base10ModuloScratch(src1,src3,base,length,scratch);
+		memset((void*) acc,0,sizeof(uint32_t)*length);
+		acc[0]=1;
+
+		//Square and multiply from the top set bit
+		int top=31;
+		while(top>=0 && !(src2&((uint32_t)1<<top)))
+			top--;
+		if(top>=0)
+			memcpy((void*) acc,base,sizeof(uint32_t)*length);
+		for(int cnt=top-1;cnt>=0;cnt--)
+		{
+			base10ModularMultiply(acc,acc,src3,modLen,acc,length,scratch);
+			if(src2&((uint32_t)1<<cnt))
+				base10ModularMultiply(acc,base,src3,modLen,acc,length,scratch);
+		}
+
+		memcpy((void*) dest,acc,sizeof(uint32_t)*length);
+		scratch->used=mark;
+		return 1;
+	}
+	//Lehmer step, dest=x*src1+y*src2 for cofactors of opposite sign
+	static int lehmerCombine(int64_t x, const uint32_t* src1, int64_t y, const uint32_t* src2, uint32_t* dest, uint32_t* temp, uint16_t len)
+	{
+		//Non-negative cofactor first
+		if(x<0 || (x==0 && y>0))
+		{
+			int64_t tx=x;
+			x=y;
+			y=tx;
+			const uint32_t* tsrc=src1;
+			src1=src2;
+			src2=tsrc;
+		}
+		base10MultiplicationWord(src1,(uint32_t)x,dest,len);
+		base10MultiplicationWord(src2,(uint32_t)(-y),temp,len);
+		return base10Subtraction(dest,temp,dest,len);
 	}
 	//GCD
 	int base10GCD(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length)
 	{
 		if(length<=0) return 0;
-		uint32_t* atrace=(uint32_t*) malloc(length*sizeof(uint32_t));
-		uint32_t* btrace=(uint32_t*) malloc(length*sizeof(uint32_t));
-		uint32_t* ttrace=(uint32_t*) malloc(length*sizeof(uint32_t));
-		uint32_t* zero=(uint32_t*) malloc(length*sizeof(uint32_t));
-
-		memcpy(atrace,src1,length*sizeof(uint32_t));
-		memcpy(btrace,src2,length*sizeof(uint32_t));
-		memset((void*) zero,0,sizeof(uint32_t)*length);
-
-		while(standardCompare(btrace,zero,length)!=0)
-		{
-			memcpy(ttrace,btrace,length*sizeof(uint32_t));
-			if(!base10Modulo(atrace,btrace,btrace,length))
-			{
-				free(atrace);
-				free(btrace);
-				free(ttrace);
-				free(zero);
-				memset((void*) dest,0,sizeof(uint32_t)*length);
-				dest[0]=1;
-				return 0;
+		struct numberScratch* scratch=numberScratchThread();
+		if(!numberScratchReserve(scratch,NUMBER_SCRATCH_SIZE(length))) return 0;
+		return base10GCDScratch(src1,src2,dest,length,scratch);
+	}
+	int base10GCDScratch(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length, struct numberScratch* scratch)
+	{
+		if(length<=0) return 0;
+		uint16_t len=standardUsedLength(src1,length);
+		if(standardUsedLength(src2,length)>len) len=standardUsedLength(src2,length);
+
+		//One spare element for the cofactor products
+		uint32_t mark=scratch->used;
+		uint32_t* atrace=numberScratchPush(scratch,len+1);
+		uint32_t* btrace=numberScratchPush(scratch,len+1);
+		uint32_t* ttrace=numberScratchPush(scratch,len+1);
+		uint32_t* wtrace=numberScratchPush(scratch,len+1);
+		uint32_t* temp=numberScratchPush(scratch,len+1);
+		memcpy(atrace,src1,len*sizeof(uint32_t));
+		memcpy(btrace,src2,len*sizeof(uint32_t));
+		atrace[len]=0;
+		btrace[len]=0;
+		if(standardCompare(atrace,btrace,len)<0)
+		{
+			uint32_t* hld=atrace;
+			atrace=btrace;
+			btrace=hld;
+		}
+
+		int algoStatus=1;
+		while(algoStatus && standardUsedLength(btrace,len)>1)
+		{
+			//Leading 32 bits of a, and b at the same offset
+			uint32_t shift=base10BitLength(atrace,len)-32;
+			uint32_t word=shift/32;
+			uint32_t bits=shift%32;
+			int64_t ah=atrace[word]>>bits;
+			int64_t bh=btrace[word]>>bits;
+			if(bits>0)
+			{
+				ah|=(int64_t)((atrace[word+1]<<(32-bits))&0xFFFFFFFF);
+				bh|=(int64_t)((btrace[word+1]<<(32-bits))&0xFFFFFFFF);
+			}
+
+			//Run Euclid on the leading words while the quotients agree (Knuth, Algorithm L)
+			int64_t A=1, B=0, C=0, D=1;
+			while(bh+C>0 && bh+D>0)
+			{
+				int64_t q=(ah+A)/(bh+C);
+				if(q!=(ah+B)/(bh+D)) break;
+				int64_t T1=A-q*C;
+				int64_t T2=B-q*D;
+				if(T1>0xFFFFFFFFLL || T1< -0xFFFFFFFFLL || T2>0xFFFFFFFFLL || T2< -0xFFFFFFFFLL) break;
+				A=C;  C=T1;
+				B=D;  D=T2;
+				int64_t T=ah-q*bh;
+				ah=bh;  bh=T;
+			}
+
+			//No progress on the leading words, full Euclid step
+			if(B==0)
+			{
+				algoStatus&=base10ModuloScratch(atrace,btrace,atrace,len+1,scratch);
+				uint32_t* hld=atrace;
+				atrace=btrace;
+				btrace=hld;
+			}
+			else
+			{
+				algoStatus&=lehmerCombine(A,atrace,B,btrace,ttrace,temp,len+1);
+				algoStatus&=lehmerCombine(C,atrace,D,btrace,wtrace,temp,len+1);
+				uint32_t* hld=atrace;
+				atrace=ttrace;
+				ttrace=hld;
+				hld=btrace;
+				btrace=wtrace;
+				wtrace=hld;
 			}
-			memcpy(atrace,ttrace,length*sizeof(uint32_t));
 		}
 
-		memcpy(dest,atrace,length*sizeof(uint32_t));
+		//Finish in single words
+		memset(dest,0,length*sizeof(uint32_t));
+		if(standardUsedLength(btrace,len)==0)
+			memcpy(dest,atrace,len*sizeof(uint32_t));
+		else
+		{
+			uint32_t x=btrace[0];
+			uint32_t y=0;
+			base10ModuloWord(atrace,x,&y,len);
+			while(y>0)
+			{
+				uint32_t t=x%y;
+				x=y;
+				y=t;
+			}
+			dest[0]=x;
+		}
+		scratch->used=mark;
+		return algoStatus;
+	}
+	//Divide by 2^shift modulo an odd src2 of len elements, x holds len+2 elements
+	static void base10HalveModulo(uint32_t* x, uint32_t shift, const uint32_t* src2, uint32_t modInv, uint16_t len)
+	{
+		while(shift>0)
+		{
+			//x+k*src2 is divisible by 2^step
+			uint32_t step=shift<32?shift:32;
+			uint32_t k=x[0]*modInv;
+			if(step<32) k&=((uint32_t)1<<step)-1;
+
+			uint64_t carry=0;
+			uint16_t cnt;
+			for(cnt=0;cnt<len;cnt++)
+			{
+				carry+=(uint64_t)k*src2[cnt]+x[cnt];
+				x[cnt]=(uint32_t)carry;
+				carry>>=32;
+			}
+			for(;cnt<len+2;cnt++)
+			{
+				carry+=x[cnt];
+				x[cnt]=(uint32_t)carry;
+				carry>>=32;
+			}
+			standardRightShift(x,(uint16_t)step,x,len+2);
+			shift-=step;
+		}
+	}
+	//Trailing zero bits of a non-zero number
+	static uint32_t base10TrailingZeros(const uint32_t* src1)
+	{
+		uint32_t ret=0;
+		for(;*src1==0;src1++)
+			ret+=32;
+		for(uint32_t val=*src1;!(val&1);val>>=1)
+			ret++;
+		return ret;
+	}
+	//Binary extended GCD inverse of src1<src2, src2 odd with len used elements
+	static int base10BinaryInverse(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t len, struct numberScratch* scratch)
+	{
+		uint32_t mark=scratch->used;
+		uint32_t* u=numberScratchPush(scratch,len);
+		uint32_t* v=numberScratchPush(scratch,len);
+		uint32_t* x1=numberScratchPush(scratch,len+2);
+		uint32_t* x2=numberScratchPush(scratch,len+2);
+		memcpy(u,src1,len*sizeof(uint32_t));
+		memcpy(v,src2,len*sizeof(uint32_t));
+		memset(x1,0,(len+2)*sizeof(uint32_t));
+		memset(x2,0,(len+2)*sizeof(uint32_t));
+		x1[0]=1;
+
+		//-src2^-1 mod 2^32 by Newton iteration
+		uint32_t modInv=src2[0];
+		for(int cnt=0;cnt<4;cnt++)
+			modInv*=2-src2[0]*modInv;
+		modInv=0-modInv;
+
+		//u=x1*src1 and v=x2*src1 mod src2 throughout
+		int ret=0;
+		while(1)
+		{
+			uint16_t ulen=standardUsedLength(u,len);
+			uint16_t vlen=standardUsedLength(v,len);
+			if(ulen==0 || vlen==0) break;
+			if(ulen==1 && u[0]==1)
+			{
+				memcpy(dest,x1,len*sizeof(uint32_t));
+				ret=1;
+				break;
+			}
+			if(vlen==1 && v[0]==1)
+			{
+				memcpy(dest,x2,len*sizeof(uint32_t));
+				ret=1;
+				break;
+			}
+
+			//Remove factors of two
+			uint32_t tz=base10TrailingZeros(u);
+			if(tz>0)
+			{
+				standardRightShift(u,(uint16_t)tz,u,ulen);
+				base10HalveModulo(x1,tz,src2,modInv,len);
+			}
+			tz=base10TrailingZeros(v);
+			if(tz>0)
+			{
+				standardRightShift(v,(uint16_t)tz,v,vlen);
+				base10HalveModulo(x2,tz,src2,modInv,len);
+			}
 
-		free(atrace);
-		free(btrace);
-		free(ttrace);
-		free(zero);
+			//Subtract the smaller from the larger
+			if(standardCompare(u,v,ulen>vlen?ulen:vlen)>=0)
+			{
+				subLimbsFrom(v,vlen,u,ulen);
+				if(standardCompare(x1,x2,len+2)<0) addLimbsInto(src2,len,x1,len+2);
+				subLimbsFrom(x2,len+2,x1,len+2);
+			}
+			else
+			{
+				subLimbsFrom(u,ulen,v,vlen);
+				if(standardCompare(x2,x1,len+2)<0) addLimbsInto(src2,len,x2,len+2);
+				subLimbsFrom(x1,len+2,x2,len+2);
+			}
+		}
 
-		return 1;
+		scratch->used=mark;
+		return ret;
 	}
 	//Modular inverse
 	int base10ModInverse(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length)
+	{
+		if(length<=0) return 0;
+		struct numberScratch* scratch=numberScratchThread();
+		if(!numberScratchReserve(scratch,NUMBER_SCRATCH_SIZE(length))) return 0;
+		return base10ModInverseScratch(src1,src2,dest,length,scratch);
+	}
+	int base10ModInverseScratch(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length, struct numberScratch* scratch)
 	{
 		if(length<=0) return 0;
 
-		//Check GCD first
-		uint32_t* one=(uint32_t*) malloc(length*sizeof(uint32_t));
-		uint32_t* newr=(uint32_t*) malloc(length*sizeof(uint32_t));
-        uint32_t* r=(uint32_t*) malloc(length*sizeof(uint32_t));
-        uint32_t* newt =(uint32_t*) malloc(length*sizeof(uint32_t));
-        
-		memset(one,0,length*sizeof(uint32_t));
-        memset(r,0,length*sizeof(uint32_t));
-        
-        memcpy(r,src2,length*sizeof(uint32_t));
-        
-        int algoStatus=base10Modulo(src1,src2,newr,length);
-		one[0]=1;
-		if(!base10GCD(newr,src2,newt,length) || standardCompare(newt,one,length)!=0)
-		{
-			memcpy(dest,one,length*sizeof(uint32_t));
-			free(one);
-			free(newr);
-            free(r);
-            free(newt);
+		uint16_t modLen=standardUsedLength(src2,length);
+		if(modLen==0)
+		{
+			memset(dest,0,length*sizeof(uint32_t));
+			dest[0]=1;
 			return 0;
 		}
 
-		uint32_t* zero=(uint32_t*) malloc(length*sizeof(uint32_t));
-		uint32_t* t=(uint32_t*) malloc(length*sizeof(uint32_t));
-
-		memset(zero,0,length*sizeof(uint32_t));
-		memset(t,0,length*sizeof(uint32_t));
-		
-		memcpy(newt,one,length*sizeof(uint32_t));
+		uint32_t mark=scratch->used;
+		uint32_t* a=numberScratchPush(scratch,length);
+		uint32_t* ret=numberScratchPush(scratch,length);
+		memset(ret,0,length*sizeof(uint32_t));
+		int algoStatus=base10ModuloScratch(src1,src2,a,length,scratch);
+		uint16_t aLen=standardUsedLength(a,length);
 
-		uint32_t* quotient=(uint32_t*) malloc(length*sizeof(uint32_t));
-		uint32_t* hld=(uint32_t*) malloc(length*sizeof(uint32_t));
-		uint32_t* temp=(uint32_t*) malloc(length*sizeof(uint32_t));
-        
-		while(standardCompare(newr,zero,length)!=0 && algoStatus)
+		//Everything is the inverse of zero mod 1
+		if(modLen==1 && src2[0]==1)
 		{
-			algoStatus&=base10Division(r,newr,quotient,length);
-
-			memcpy(temp,newt,length*sizeof(uint32_t));
-			algoStatus&=base10Multiplication(quotient,newt,hld,length);
-			algoStatus&=base10Modulo(hld,src2,hld,length);
-			if(standardCompare(t,hld,length)==-1)
-				algoStatus&=base10Addition(t,src2,t,length);
-			algoStatus&=base10Subtraction(t,hld,newt,length);
-			memcpy(t,temp,length*sizeof(uint32_t));
-
-			memcpy(temp,newr,length*sizeof(uint32_t));
-			algoStatus&=base10Multiplication(quotient,newr,hld,length);
-			algoStatus&=base10Modulo(hld,src2,hld,length);
-			if(standardCompare(r,hld,length)==-1)
-				algoStatus&=base10Addition(r,src2,r,length);
-			algoStatus&=base10Subtraction(r,hld,newr,length);
-			memcpy(r,temp,length*sizeof(uint32_t));
-
-			algoStatus&=base10Modulo(t,src2,t,length);
+		}
+		//Odd modulus, binary inverse
+		else if(src2[0]&1)
+			algoStatus&=base10BinaryInverse(a,src2,ret,modLen,scratch);
+		//Both even, no inverse
+		else if(!(a[0]&1))
+			algoStatus=0;
+		else if(aLen==1 && a[0]==1)
+			ret[0]=1;
+		//Even modulus, src1^-1=(1+src2*(a-y))/a with y=src2^-1 mod a
+		else
+		{
+			uint32_t* y=numberScratchPush(scratch,length);
+			uint32_t* prod=numberScratchPush(scratch,modLen+aLen+1);
+			algoStatus&=base10ModuloScratch(src2,a,y,length,scratch);
+			algoStatus&=base10BinaryInverse(y,a,y,aLen,scratch);
+			if(algoStatus)
+			{
+				base10Subtraction(a,y,y,aLen);
+				base10MultiplyFull(src2,modLen,y,aLen,prod,scratch);
+				prod[modLen+aLen]=0;
+				base10AdditionWord(prod,1,prod,modLen+aLen+1);
+				//Only the quotient limbs are written, the product remains above them
+				uint16_t prodLen=standardUsedLength(prod,modLen+aLen+1);
+				uint16_t quotLen=prodLen-aLen+1;
+				if(quotLen>modLen) quotLen=modLen;
+				base10DivideLimbs(prod,prodLen,a,aLen,prod,NULL,scratch);
+				memcpy(ret,prod,quotLen*sizeof(uint32_t));
+			}
 		}
 
 		if(!algoStatus)
-			memcpy(dest,one,length*sizeof(uint32_t));
+		{
+			memset(dest,0,length*sizeof(uint32_t));
+			dest[0]=1;
+		}
 		else
-			memcpy(dest,t,length*sizeof(uint32_t));
-
-		//Free all the temps
-		free(one);
-		free(newr);
-
-		free(zero);
-		free(t);
-		free(r);
-		free(newt);
+			memcpy(dest,ret,length*sizeof(uint32_t));
 
-		free(quotient);
-		free(hld);
-		free(temp);
-		
+		scratch->used=mark;
 		return algoStatus;
 	}
 
-	//Tests if a number is prime
-	int primeTest(const uint32_t* src1, uint16_t test_iteration, uint16_t length)
+	//Random witness below src1 with len used elements, at least 2
+	static void base10RandomWitness(const uint32_t* src1, uint32_t* dest, uint16_t len)
+	{
+		cryptoRandomFill(dest,len*sizeof(uint32_t));
+		dest[len-1]%=src1[len-1];
+		if(standardUsedLength(dest,len)<=1 && dest[0]<2)
+			dest[0]=2;
+	}
+	//Decides zero, one, even numbers and small factors, -1 if undecided
+	static int base10PrimeScreen(const uint32_t* src1, uint16_t length)
 	{
-		if(length<=0) return 0;
-		if(test_iteration<=2) return 0;
-
 		int trace = 1;
 		int flag = 0;
-		int algoStatus = 1;
-    
+
 		//Check for zero set
 		while(!flag && trace<length)
 		{
@@ -539,91 +1411,400 @@ extern "C" {
 		//Check for even case
 		if(!(src1[0]&1)) return 0;
 
-		//Miller-Rabin Test
-		uint32_t* one=(uint32_t*) malloc(length*sizeof(uint32_t));
-		uint32_t* minusOne=(uint32_t*) malloc(length*sizeof(uint32_t));
+		//Trial division by small primes
+		static const uint32_t smallPrimes[]={3,5,7,11,13,17,19,23,29,31,37,41,43,47,53,59,61,67,71,73,79,83,89,97};
+		for(uint16_t cnt=0;cnt<sizeof(smallPrimes)/sizeof(uint32_t);cnt++)
+		{
+			uint32_t rem=1;
+			base10ModuloWord(src1,smallPrimes[cnt],&rem,length);
+			if(rem==0) return !flag && src1[0]==smallPrimes[cnt];
+		}
 
-		memset(one,0,length*sizeof(uint32_t));
-		one[0]=1;
-		algoStatus&=base10Subtraction(src1,one,minusOne,length);
+		//No composite below 101^2 survives the trial division
+		if(!flag && src1[0]<101*101) return 1;
+		return -1;
+	}
+	//Montgomery context and n-1=d*2^s shared by strong probable prime rounds
+	struct strongPrimeState
+	{
+		struct montgomeryContext ctx;
+		uint32_t* d;
+		uint32_t s;
+		uint32_t* one;
+		uint32_t* minusOne;
+		uint32_t* x;
+	};
+	//Prepares state for src1, odd with len used elements
+	static int base10StrongPrimeInit(struct strongPrimeState* state, const uint32_t* src1, uint16_t len, struct numberScratch* scratch)
+	{
+		if(!base10MontgomeryInit(&state->ctx,src1,len,scratch)) return 0;
+		state->d=numberScratchPush(scratch,len);
+		state->one=numberScratchPush(scratch,len);
+		state->minusOne=numberScratchPush(scratch,len);
+		state->x=numberScratchPush(scratch,len);
+		if(!state->x) return 0;
+
+		//src1 is odd, so n-1 only clears bit 0
+		memcpy(state->d,src1,len*sizeof(uint32_t));
+		state->d[0]--;
+		state->s=base10TrailingZeros(state->d);
+		standardRightShift(state->d,state->s,state->d,len);
+
+		//1 and -1 in Montgomery form
+		memset(state->x,0,len*sizeof(uint32_t));
+		state->x[0]=1;
+		base10MontgomeryMultiply(&state->ctx,state->x,state->ctx.rSquared,state->one,scratch);
+		memcpy(state->minusOne,src1,len*sizeof(uint32_t));
+		subLimbsFrom(state->one,len,state->minusOne,len);
+		return 1;
+	}
+	//One strong probable prime round to the base witness
+	static int base10StrongProbablePrime(struct strongPrimeState* state, const uint32_t* witness, struct numberScratch* scratch)
+	{
+		const struct montgomeryContext* ctx=&state->ctx;
+		uint16_t len=ctx->length;
+		uint32_t* x=state->x;
 
-		//Find "d"
-		trace = 0;
-		flag = 0;
-		while(!flag && algoStatus)
+		base10MontgomeryExponentiation(ctx,witness,state->d,len,x,scratch);
+		base10MontgomeryMultiply(ctx,x,ctx->rSquared,x,scratch);
+		if(standardCompare(x,state->one,len)==0 || standardCompare(x,state->minusOne,len)==0)
+			return 1;
+		for(uint32_t cnt=1;cnt<state->s;cnt++)
 		{
-			trace++;
-			if(minusOne[trace/32]&(1<<(trace%32))) flag = 1;
-			if(trace+1>length*32)
-				algoStatus=0;
+			base10MontgomerySquare(ctx,x,x,scratch);
+			if(standardCompare(x,state->minusOne,len)==0) return 1;
+			if(standardCompare(x,state->one,len)==0) return 0;
+		}
+		return 0;
+	}
+	//dest=src1+src2 mod src3, arguments below src3
+	static void base10AddModulo(const uint32_t* src1, const uint32_t* src2, const uint32_t* src3, uint32_t* dest, uint16_t len)
+	{
+		uint64_t carry=0;
+		for(uint16_t cnt=0;cnt<len;cnt++)
+		{
+			carry+=(uint64_t)src1[cnt]+src2[cnt];
+			dest[cnt]=(uint32_t)carry;
+			carry>>=32;
 		}
+		if(carry || standardCompare(dest,src3,len)>=0)
+			subLimbsFrom(src3,len,dest,len);
+	}
+	//dest=src1-src2 mod src3, arguments below src3
+	static void base10SubModulo(const uint32_t* src1, const uint32_t* src2, const uint32_t* src3, uint32_t* dest, uint16_t len)
+	{
+		uint64_t borrow=0;
+		for(uint16_t cnt=0;cnt<len;cnt++)
+		{
+			uint64_t sub=(uint64_t)src2[cnt]+borrow;
+			borrow=src1[cnt]<sub;
+			dest[cnt]=(uint32_t)(src1[cnt]-sub);
+		}
+		if(borrow)
+			addLimbsInto(src3,len,dest,len);
+	}
+	//src1=src1/2 mod src2 for odd src2
+	static void base10HalfModulo(uint32_t* src1, const uint32_t* src2, uint16_t len)
+	{
+		uint64_t carry=0;
+		if(src1[0]&1)
+		{
+			for(uint16_t cnt=0;cnt<len;cnt++)
+			{
+				carry+=(uint64_t)src1[cnt]+src2[cnt];
+				src1[cnt]=(uint32_t)carry;
+				carry>>=32;
+			}
+		}
+		for(uint16_t cnt=0;cnt+1<len;cnt++)
+			src1[cnt]=(src1[cnt]>>1)|(src1[cnt+1]<<31);
+		src1[len-1]=(src1[len-1]>>1)|((uint32_t)carry<<31);
+	}
+	//Jacobi symbol (a/src1) for a small odd a, src1 odd
+	static int base10JacobiWord(int32_t a, const uint32_t* src1, uint16_t len)
+	{
+		int ret=1;
+		uint32_t y=(uint32_t)(a<0?-a:a);
+		uint32_t x=0;
 
-		uint32_t* x=(uint32_t*) malloc(length*sizeof(uint32_t));
-		uint32_t* d=(uint32_t*) malloc(length*sizeof(uint32_t));
-		algoStatus&=standardLeftShift(minusOne,trace,d,length);
-		uint32_t* test=(uint32_t*) malloc(length*sizeof(uint32_t));
-		int s=trace;
-		int cnt=0;
+		//(-1/n) is -1 for n=3 mod 4, then reciprocity swaps to (n mod |a|/|a|)
+		if(a<0 && (src1[0]&3)==3) ret=-ret;
+		if((y&3)==3 && (src1[0]&3)==3) ret=-ret;
+		base10ModuloWord(src1,y,&x,len);
 
-		//Preform the test
-		srand((unsigned)time(NULL));
-		while(cnt<test_iteration && algoStatus)
+		while(x)
 		{
-			if(cnt==0) test[0]=2;
-			else if(cnt == 1) test[0]=3;
-			else
+			while(!(x&1))
 			{
-				//Randomly select a test number
-				trace=length;
-				flag=0;
+				x>>=1;
+				if((y&7)==3 || (y&7)==5) ret=-ret;
+			}
+			uint32_t temp=x;
+			x=y;
+			y=temp;
+			if((x&3)==3 && (y&3)==3) ret=-ret;
+			x%=y;
+		}
+		return y==1?ret:0;
+	}
+	//Newton's integer square root, 1 if src1 is a perfect square
+	static int base10PerfectSquare(const uint32_t* src1, uint16_t len, struct numberScratch* scratch)
+	{
+		uint32_t mark=scratch->used;
+		uint32_t* x=numberScratchPush(scratch,len);
+		uint32_t* y=numberScratchPush(scratch,len);
+		uint32_t* quot=numberScratchPush(scratch,len);
+
+		//Start from 2^ceil(bits/2), which is above the root
+		uint32_t half=(base10BitLength(src1,len)+1)/2;
+		memset(x,0,len*sizeof(uint32_t));
+		x[half/32]=(uint32_t)1<<(half%32);
+		while(1)
+		{
+			base10DivisionScratch(src1,x,quot,len,scratch);
+			memcpy(y,x,len*sizeof(uint32_t));
+			addLimbsInto(quot,len,y,len);
+			standardRightShift(y,1,y,len);
+			if(standardCompare(y,x,len)>=0) break;
+			memcpy(x,y,len*sizeof(uint32_t));
+		}
 
-				while(trace>0 && algoStatus)
-				{
-					trace--;
-					if(flag)
-						test[trace]=rand()^(rand()<<1);
-					else
-						test[trace]=0;
-					if(src1[trace]!=0&&!flag)
-					{
-						flag=1;
-						test[trace] = (rand()^(rand()<<1))%src1[trace];
-					}
-				}
-				if(test[0]<3)
-					test[0]=3;
+		//x is the root, src1 is square if src1/x==x exactly
+		int ret=standardCompare(quot,x,len)==0;
+		if(ret)
+		{
+			base10ModuloScratch(src1,x,y,len,scratch);
+			ret=standardUsedLength(y,len)==0;
+		}
+		scratch->used=mark;
+		return ret;
+	}
+	//Small value in Montgomery form, |val| below the modulus
+	static void base10MontgomerySmall(const struct montgomeryContext* ctx, int32_t val, uint32_t* dest, struct numberScratch* scratch)
+	{
+		uint16_t len=ctx->length;
+		memset(dest,0,len*sizeof(uint32_t));
+		dest[0]=(uint32_t)(val<0?-val:val);
+		base10MontgomeryMultiply(ctx,dest,ctx->rSquared,dest,scratch);
+		if(val<0 && standardUsedLength(dest,len))
+		{
+			uint64_t borrow=0;
+			for(uint16_t cnt=0;cnt<len;cnt++)
+			{
+				uint64_t sub=(uint64_t)dest[cnt]+borrow;
+				borrow=ctx->modulus[cnt]<sub;
+				dest[cnt]=(uint32_t)(ctx->modulus[cnt]-sub);
 			}
-			algoStatus&=base10ModuloExponentiation(test,d,src1,x,length);
-			if(standardCompare(x,one,length)!=0 && standardCompare(x,minusOne,length))
+		}
+	}
+	//Strong Lucas probable prime test with Selfridge's parameters, src1 odd above 101^2
+	static int base10StrongLucas(const struct strongPrimeState* state, const uint32_t* src1, struct numberScratch* scratch)
+	{
+		const struct montgomeryContext* ctx=&state->ctx;
+		uint16_t len=ctx->length;
+
+		//First D in 5,-7,9,-11,... with (D/n)=-1, a square never finds one
+		int32_t dVal=5;
+		for(int tries=1;;tries++)
+		{
+			int jacobi=base10JacobiWord(dVal,src1,len);
+			if(jacobi==-1) break;
+			if(jacobi==0) return 0;
+			if(tries==8 && base10PerfectSquare(src1,len,scratch)) return 0;
+			dVal=dVal>0?-(dVal+2):-dVal+2;
+		}
+
+		uint32_t mark=scratch->used;
+		uint32_t* u=numberScratchPush(scratch,len);
+		uint32_t* v=numberScratchPush(scratch,len);
+		uint32_t* qk=numberScratchPush(scratch,len);
+		uint32_t* q=numberScratchPush(scratch,len);
+		uint32_t* dm=numberScratchPush(scratch,len);
+		uint32_t* temp=numberScratchPush(scratch,len);
+		uint32_t* k=numberScratchPush(scratch,len+1);
+
+		//P=1, Q=(1-D)/4 in Montgomery form
+		base10MontgomerySmall(ctx,(1-dVal)/4,q,scratch);
+		base10MontgomerySmall(ctx,dVal,dm,scratch);
+		memcpy(u,state->one,len*sizeof(uint32_t));
+		memcpy(v,state->one,len*sizeof(uint32_t));
+		memcpy(qk,q,len*sizeof(uint32_t));
+
+		//n+1=k*2^s, the extra element holds the carry
+		uint32_t val=1;
+		memcpy(k,src1,len*sizeof(uint32_t));
+		k[len]=0;
+		addLimbsInto(&val,1,k,len+1);
+		uint32_t s=base10TrailingZeros(k);
+		standardRightShift(k,s,k,len+1);
+
+		//U_k and V_k from U_1=1, V_1=P by doubling and incrementing
+		for(int32_t cnt=(int32_t)base10BitLength(k,len+1)-2;cnt>=0;cnt--)
+		{
+			base10MontgomeryMultiply(ctx,u,v,u,scratch);
+			base10MontgomerySquare(ctx,v,v,scratch);
+			base10SubModulo(v,qk,src1,v,len);
+			base10SubModulo(v,qk,src1,v,len);
+			base10MontgomerySquare(ctx,qk,qk,scratch);
+			if(k[cnt/32]&((uint32_t)1<<(cnt%32)))
 			{
-				flag=0;
-				trace=1;
-				while(trace<s&&!flag&&algoStatus)
-				{
-					algoStatus&=base10Multiplication(x,x,x,length);
-					algoStatus&=base10Modulo(x,src1,x,length);
+				//U_k+1=(P*U_k+V_k)/2, V_k+1=(D*U_k+P*V_k)/2
+				base10MontgomeryMultiply(ctx,u,dm,temp,scratch);
+				base10AddModulo(u,v,src1,u,len);
+				base10HalfModulo(u,src1,len);
+				base10AddModulo(temp,v,src1,v,len);
+				base10HalfModulo(v,src1,len);
+				base10MontgomeryMultiply(ctx,qk,q,qk,scratch);
+			}
+		}
 
-					if(algoStatus&&standardCompare(x,one,length)==0)
-						algoStatus=0;
-					if(algoStatus&&standardCompare(x,minusOne,length)==0)
-						flag=1;
+		//Probable prime if U_k=0 or V_(k*2^r)=0 for some r<s
+		int ret=standardUsedLength(u,len)==0 || standardUsedLength(v,len)==0;
+		for(uint32_t cnt=1;cnt<s && !ret;cnt++)
+		{
+			base10MontgomerySquare(ctx,v,v,scratch);
+			base10SubModulo(v,qk,src1,v,len);
+			base10SubModulo(v,qk,src1,v,len);
+			base10MontgomerySquare(ctx,qk,qk,scratch);
+			ret=standardUsedLength(v,len)==0;
+		}
 
-					trace++;
-				}
-				if(!flag) algoStatus=0;
+		scratch->used=mark;
+		return ret;
+	}
+
+	//Miller-Rabin prime test
+	int primeTest(const uint32_t* src1, uint16_t test_iteration, uint16_t length)
+	{
+		if(length<=0) return 0;
+		struct numberScratch* scratch=numberScratchThread();
+		if(!numberScratchReserve(scratch,NUMBER_SCRATCH_SIZE(length)+8*length)) return 0;
+		return primeTestScratch(src1,test_iteration,length,scratch);
+	}
+	int primeTestScratch(const uint32_t* src1, uint16_t test_iteration, uint16_t length, struct numberScratch* scratch)
+	{
+		if(length<=0) return 0;
+		if(test_iteration==0) return 0;
+		int screen=base10PrimeScreen(src1,length);
+		if(screen>=0) return screen;
+
+		uint16_t len=standardUsedLength(src1,length);
+		uint32_t mark=scratch->used;
+		struct strongPrimeState state;
+		int algoStatus=base10StrongPrimeInit(&state,src1,len,scratch);
+		uint32_t* witness=numberScratchPush(scratch,len);
+		if(!witness) algoStatus=0;
+
+		//Bases 2 and 3, then random witnesses
+		for(uint16_t cnt=0;cnt<test_iteration && algoStatus;cnt++)
+		{
+			if(cnt<2)
+			{
+				memset(witness,0,len*sizeof(uint32_t));
+				witness[0]=cnt+2;
 			}
-			cnt++;
+			else
+				base10RandomWitness(src1,witness,len);
+			algoStatus=base10StrongProbablePrime(&state,witness,scratch);
 		}
 
-		free(x);
-		free(one);
-		free(minusOne);
-		free(d);
-		free(test);
+		scratch->used=mark;
+		return algoStatus;
+	}
+	//Baillie-PSW prime test
+	int primeTestBPSW(const uint32_t* src1, uint16_t test_iteration, uint16_t length)
+	{
+		if(length<=0) return 0;
+		struct numberScratch* scratch=numberScratchThread();
+		if(!numberScratchReserve(scratch,NUMBER_SCRATCH_SIZE(length)+8*length)) return 0;
+		return primeTestBPSWScratch(src1,test_iteration,length,scratch);
+	}
+	int primeTestBPSWScratch(const uint32_t* src1, uint16_t test_iteration, uint16_t length, struct numberScratch* scratch)
+	{
+		if(length<=0) return 0;
+		int screen=base10PrimeScreen(src1,length);
+		if(screen>=0) return screen;
+
+		uint16_t len=standardUsedLength(src1,length);
+		uint32_t mark=scratch->used;
+		struct strongPrimeState state;
+		int algoStatus=base10StrongPrimeInit(&state,src1,len,scratch);
+		uint32_t* witness=numberScratchPush(scratch,len);
+		if(!witness) algoStatus=0;
+
+		//Strong base 2, then strong Lucas
+		if(algoStatus)
+		{
+			memset(witness,0,len*sizeof(uint32_t));
+			witness[0]=2;
+			algoStatus=base10StrongProbablePrime(&state,witness,scratch);
+		}
+		if(algoStatus)
+			algoStatus=base10StrongLucas(&state,src1,scratch);
+
+		//Optional random Miller-Rabin rounds
+		for(uint16_t cnt=0;cnt<test_iteration && algoStatus;cnt++)
+		{
+			base10RandomWitness(src1,witness,len);
+			algoStatus=base10StrongProbablePrime(&state,witness,scratch);
+		}
 
+		scratch->used=mark;
 		return algoStatus;
 	}
 
+	//Odd primes below bound
+	uint16_t base10SmallPrimes(uint16_t* primes, uint16_t max, uint32_t bound)
+	{
+		if(bound>65536) bound=65536;
+		uint16_t count=0;
+		for(uint32_t cand=3;cand<bound && count<max;cand+=2)
+		{
+			int isPrime=1;
+			for(uint16_t cnt=0;cnt<count && (uint32_t)primes[cnt]*primes[cnt]<=cand;cnt++)
+			{
+				if(cand%primes[cnt]==0)
+				{
+					isPrime=0;
+					break;
+				}
+			}
+			if(isPrime)
+			{
+				primes[count]=(uint16_t)cand;
+				count++;
+			}
+		}
+		return count;
+	}
+	//Residues of src1 for each small prime
+	void base10SieveResidues(const uint32_t* src1, uint16_t length, const uint16_t* primes, uint16_t count, uint16_t* residues)
+	{
+		for(uint16_t cnt=0;cnt<count;cnt++)
+		{
+			uint32_t rem=0;
+			base10ModuloWord(src1,primes[cnt],&rem,length);
+			residues[cnt]=(uint16_t)rem;
+		}
+	}
+	//Mark composites among base+2*i, then advance residues
+	void base10SieveInterval(uint16_t* residues, const uint16_t* primes, uint16_t count, uint8_t* sieve, uint32_t width)
+	{
+		memset((void*) sieve,0,width);
+		for(uint16_t cnt=0;cnt<count;cnt++)
+		{
+			uint32_t prime=primes[cnt];
+			uint32_t res=residues[cnt];
+
+			//First i with res+2*i = 0 mod prime, 2^-1 = (prime+1)/2
+			uint32_t first=(uint32_t)(((uint64_t)(prime-res)%prime*((prime+1)/2))%prime);
+			for(uint32_t trc=first;trc<width;trc+=prime)
+				sieve[trc]=1;
+
+			residues[cnt]=(uint16_t)((res+(uint64_t)2*width)%prime);
+		}
+	}
+
 #ifdef __cplusplus
 }
 #endif
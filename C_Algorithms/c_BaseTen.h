@@ -64,6 +64,58 @@ extern "C" {
      * @return 1 if success, 0 if failed
      */
     int base10Subtraction(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length);
+    /** @brief Base-10 word addition
+     *
+     * Preforms src1+src2 for a single word src2,
+     * outputting the result to dest.  The carry
+     * loop stops at the first element which
+     * does not overflow.  dest may overlap src1.
+     *
+     * @param [in] src1 Argument 1
+     * @param [in] src2 Word argument
+     * @param [out] dest Output
+     * @param [in] length Number of uint32_t in the arrays
+     * @return 1 if success, 0 if failed
+     */
+    int base10AdditionWord(const uint32_t* src1, uint32_t src2, uint32_t* dest, uint16_t length);
+    /** @brief Base-10 word multiplication
+     *
+     * Preforms src1*src2 for a single word src2,
+     * outputting the result to dest.  dest may
+     * overlap src1.
+     *
+     * @param [in] src1 Argument 1
+     * @param [in] src2 Word argument
+     * @param [out] dest Output
+     * @param [in] length Number of uint32_t in the arrays
+     * @return 1 if success, 0 if failed
+     */
+    int base10MultiplicationWord(const uint32_t* src1, uint32_t src2, uint32_t* dest, uint16_t length);
+    /** @brief Base-10 word division
+     *
+     * Preforms src1/src2 for a single word src2,
+     * outputting the quotient to dest and the
+     * remainder to rem.  dest may overlap src1.
+     *
+     * @param [in] src1 Argument 1
+     * @param [in] src2 Word argument
+     * @param [out] dest Quotient
+     * @param [out] rem Remainder, may be NULL
+     * @param [in] length Number of uint32_t in the arrays
+     * @return 1 if success, 0 if failed
+     */
+    int base10DivisionWord(const uint32_t* src1, uint32_t src2, uint32_t* dest, uint32_t* rem, uint16_t length);
+    /** @brief Base-10 word modulo
+     *
+     * Preforms src1%src2 for a single word src2.
+     *
+     * @param [in] src1 Argument 1
+     * @param [in] src2 Word argument
+     * @param [out] rem Remainder
+     * @param [in] length Number of uint32_t in src1
+     * @return 1 if success, 0 if failed
+     */
+    int base10ModuloWord(const uint32_t* src1, uint32_t src2, uint32_t* rem, uint16_t length);
 
     /** @brief Base-10 multiplication
      *
@@ -80,6 +132,128 @@ extern "C" {
      * @return 1 if success, 0 if failed
      */
     int base10Multiplication(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length);
+    /** @brief Base-10 multiplication with scratch workspace
+     *
+     * Identical to base10Multiplication(...), but takes
+     * temporaries from the provided workspace.
+     *
+     * @param [in/out] scratch Workspace, at least NUMBER_SCRATCH_SIZE(length) free
+     * @return 1 if success, 0 if failed
+     */
+    int base10MultiplicationScratch(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length, struct numberScratch* scratch);
+    /** @brief Base-10 squaring
+     *
+     * This function takes in an array which
+     * represents a base-10 number, preforms src1*src1
+     * and then outputs the result to dest.  Cross
+     * products are only calculated once, making this
+     * faster than base10Multiplication(src1,src1,...).
+     * Note that both arrays must be the same size.
+     *
+     * @param [in] src1 Argument 1
+     * @param [out] dest Output
+     * @param [in] length Number of uint32_t in the arrays
+     * @return 1 if success, 0 if failed
+     */
+    int base10Square(const uint32_t* src1, uint32_t* dest, uint16_t length);
+    /** @brief Base-10 squaring with scratch workspace
+     *
+     * Identical to base10Square(...), but takes
+     * temporaries from the provided workspace.
+     *
+     * @param [in/out] scratch Workspace, at least NUMBER_SCRATCH_SIZE(length) free
+     * @return 1 if success, 0 if failed
+     */
+    int base10SquareScratch(const uint32_t* src1, uint32_t* dest, uint16_t length, struct numberScratch* scratch);
+    /** @brief Base-10 limb multiplication
+     *
+     * Schoolbook multiplication of a len1 element
+     * array by a len2 element array, one uint32_t
+     * at a time.  The product is written to the
+     * first length elements of dest.  Note that dest
+     * cannot overlap either source array.
+     *
+     * @param [in] src1 Argument 1
+     * @param [in] len1 Number of uint32_t in src1
+     * @param [in] src2 Argument 2
+     * @param [in] len2 Number of uint32_t in src2
+     * @param [out] dest Output
+     * @param [in] length Number of uint32_t in dest
+     * @return 1 if success, 0 if the product did not fit in dest
+     */
+    int base10MultiplyLimbs(const uint32_t* src1, uint16_t len1, const uint32_t* src2, uint16_t len2, uint32_t* dest, uint16_t length);
+    /** @brief Base-10 limb squaring
+     *
+     * Squares a len1 element array, writing all
+     * 2*len1 elements of the product into dest.
+     * Note that dest cannot overlap src1.
+     *
+     * @param [in] src1 Argument 1
+     * @param [in] len1 Number of uint32_t in src1
+     * @param [out] dest Output, 2*len1 uint32_t
+     * @return void
+     */
+    void base10SquareLimbs(const uint32_t* src1, uint16_t len1, uint32_t* dest);
+    /** @brief Base-10 full width multiplication
+     *
+     * Multiplies a len1 element array by a len2
+     * element array, writing all len1+len2 elements
+     * of the product into dest.  Operands at or above
+     * the Karatsuba threshold are split recursively,
+     * smaller ones use base10MultiplyLimbs(...).
+     * Note that dest cannot overlap either source array.
+     *
+     * @param [in] src1 Argument 1
+     * @param [in] len1 Number of uint32_t in src1
+     * @param [in] src2 Argument 2
+     * @param [in] len2 Number of uint32_t in src2
+     * @param [out] dest Output, len1+len2 uint32_t
+     * @param [in/out] scratch Workspace
+     * @return void
+     */
+    void base10MultiplyFull(const uint32_t* src1, uint16_t len1, const uint32_t* src2, uint16_t len2, uint32_t* dest, struct numberScratch* scratch);
+    /** @brief Base-10 full width squaring
+     *
+     * Squares a len1 element array, writing all
+     * 2*len1 elements of the product into dest.
+     * Karatsuba is used at or above the squaring threshold.
+     * Note that dest cannot overlap src1.
+     *
+     * @param [in] src1 Argument 1
+     * @param [in] len1 Number of uint32_t in src1
+     * @param [out] dest Output, 2*len1 uint32_t
+     * @param [in/out] scratch Workspace
+     * @return void
+     */
+    void base10SquareFull(const uint32_t* src1, uint16_t len1, uint32_t* dest, struct numberScratch* scratch);
+    /** @brief Karatsuba multiplication threshold
+     *
+     * Operands with fewer uint32_t than this
+     * are multiplied with the schoolbook loop.
+     *
+     * @return Current threshold in uint32_t
+     */
+    uint16_t base10GetKaratsubaThreshold();
+    /** @brief Karatsuba squaring threshold
+     *
+     * Operands with fewer uint32_t than this
+     * are squared with the schoolbook loop.
+     *
+     * @return Current threshold in uint32_t
+     */
+    uint16_t base10GetKaratsubaSquareThreshold();
+    /** @brief Set Karatsuba thresholds
+     *
+     * Sets the operand lengths, in uint32_t, at
+     * which multiplication and squaring switch to
+     * Karatsuba.  Values below 4 are raised to 4.
+     * Not thread safe, set before starting threads.
+     *
+     * @param [in] multiply Multiplication threshold in uint32_t
+     * @param [in] square Squaring threshold in uint32_t
+     * @return void
+     */
+    void base10SetKaratsubaThreshold(uint16_t multiply, uint16_t square);
     /** @brief Base-10 division
      *
      * This function takes in two arrays which
@@ -95,6 +269,15 @@ extern "C" {
      * @return 1 if success, 0 if failed
      */
     int base10Division(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length);
+    /** @brief Base-10 division with scratch workspace
+     *
+     * Identical to base10Division(...), but takes
+     * temporaries from the provided workspace.
+     *
+     * @param [in/out] scratch Workspace, at least NUMBER_SCRATCH_SIZE(length) free
+     * @return 1 if success, 0 if failed
+     */
+    int base10DivisionScratch(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length, struct numberScratch* scratch);
     /** @brief Base-10 modulo
      *
      * This function takes in two arrays which
@@ -110,6 +293,81 @@ extern "C" {
      * @return 1 if success, 0 if failed
      */
     int base10Modulo(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length);
+    /** @brief Base-10 modulo with scratch workspace
+     *
+     * Identical to base10Modulo(...), but takes
+     * temporaries from the provided workspace.
+     *
+     * @param [in/out] scratch Workspace, at least NUMBER_SCRATCH_SIZE(length) free
+     * @return 1 if success, 0 if failed
+     */
+    int base10ModuloScratch(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length, struct numberScratch* scratch);
+    /** @brief Base-10 full width multiplication
+     *
+     * Preforms src1*src2 on two arrays of length
+     * elements, writing all 2*length elements of the
+     * product to dest.  Unlike base10Multiplication(...),
+     * the product cannot overflow.  dest may overlap
+     * either source array.
+     *
+     * @param [in] src1 Argument 1
+     * @param [in] src2 Argument 2
+     * @param [out] dest Output, 2*length uint32_t
+     * @param [in] length Number of uint32_t in the arguments
+     * @return 1 if success, 0 if failed
+     */
+    int base10MultiplicationFull(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length);
+    /** @brief Base-10 full width multiplication with scratch workspace
+     *
+     * Identical to base10MultiplicationFull(...), but takes
+     * temporaries from the provided workspace.
+     *
+     * @param [in/out] scratch Workspace, at least NUMBER_SCRATCH_SIZE(length) free
+     * @return 1 if success, 0 if failed
+     */
+    int base10MultiplicationFullScratch(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length, struct numberScratch* scratch);
+    /** @brief Base-10 full width modulo
+     *
+     * Preforms src1%src2, where src1 has 2*length
+     * elements and src2 has length elements, such
+     * as the output of base10MultiplicationFull(...).
+     * The remainder is written to the length
+     * elements of dest.
+     *
+     * @param [in] src1 Argument 1, 2*length uint32_t
+     * @param [in] src2 Argument 2
+     * @param [out] dest Output
+     * @param [in] length Number of uint32_t in src2 and dest
+     * @return 1 if success, 0 if failed
+     */
+    int base10ModuloFull(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length);
+    /** @brief Base-10 full width modulo with scratch workspace
+     *
+     * Identical to base10ModuloFull(...), but takes
+     * temporaries from the provided workspace.
+     *
+     * @param [in/out] scratch Workspace, at least NUMBER_SCRATCH_SIZE(length) free
+     * @return 1 if success, 0 if failed
+     */
+    int base10ModuloFullScratch(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length, struct numberScratch* scratch);
+    /** @brief Base-10 limb division
+     *
+     * Multi-limb long division (Knuth, Algorithm D)
+     * of a len1 element array by a len2 element array.
+     * The divisor's top element must be non-zero and
+     * len1 must be at least len2.  Either output may
+     * be NULL, and either may overlap the sources.
+     *
+     * @param [in] src1 Dividend
+     * @param [in] len1 Number of uint32_t in src1
+     * @param [in] src2 Divisor
+     * @param [in] len2 Number of uint32_t in src2
+     * @param [out] quot Quotient, len1-len2+1 uint32_t
+     * @param [out] rem Remainder, len2 uint32_t
+     * @param [in/out] scratch Workspace, at least len1+len2+1 free
+     * @return void
+     */
+    void base10DivideLimbs(const uint32_t* src1, uint16_t len1, const uint32_t* src2, uint16_t len2, uint32_t* quot, uint32_t* rem, struct numberScratch* scratch);
 
     /** @brief Base-10 exponentiation
      *
@@ -126,12 +384,335 @@ extern "C" {
      * @return 1 if success, 0 if failed
      */
 	int base10Exponentiation(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length);
+	/** @brief Base-10 exponentiation with scratch workspace
+     *
+     * Identical to base10Exponentiation(...), but takes
+     * temporaries from the provided workspace.
+     *
+     * @param [in/out] scratch Workspace, at least NUMBER_SCRATCH_SIZE(length) free
+     * @return 1 if success, 0 if failed
+     */
+    int base10ExponentiationScratch(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length, struct numberScratch* scratch);
+    /** @brief Bit length
+     *
+     * @param [in] src1 Argument 1
+     * @param [in] length Number of uint32_t in src1
+     * @return Position of the top set bit plus one, 0 if src1 is zero
+     */
+    uint32_t base10BitLength(const uint32_t* src1, uint16_t length);
+    /** @brief Sliding window size
+     *
+     * Chooses the exponent window, in bits, which
+     * minimizes multiplications for an exponent of
+     * the given length.  A window of w bits needs a
+     * table of 2^(w-1) odd powers.
+     *
+     * @param [in] bits Bit length of the exponent
+     * @param [in] max Largest window allowed
+     * @return Window size in bits, at least 1
+     */
+    uint16_t base10WindowSize(uint32_t bits, uint16_t max);
+    /** @brief Sliding window scan
+     *
+     * Starting from the set bit top of the exponent,
+     * finds the longest run of at most window bits
+     * whose lowest bit is also set.
+     *
+     * @param [in] src1 Exponent
+     * @param [in] top Position of a set bit in src1
+     * @param [in] window Largest window in bits
+     * @param [out] val Odd value of the window
+     * @return Number of bits in the window
+     */
+    uint16_t base10ExponentWindow(const uint32_t* src1, uint32_t top, uint16_t window, uint32_t* val);
+	/** @brief Montgomery reduction context
+	 *
+	 * Holds the values which are computed once
+	 * per odd modulus n so that a modular exponentiation
+	 * can be run entirely in Montgomery form, where
+	 * R=2^(32*length).
+	 */
+	struct montgomeryContext
+	{
+		/** @brief Number of uint32_t in the modulus */
+		uint16_t length;
+		/** @brief -n^-1 mod 2^32 */
+		uint32_t nPrime;
+		/** @brief Modulus, length uint32_t */
+		uint32_t* modulus;
+		/** @brief R^2 mod n, length uint32_t */
+		uint32_t* rSquared;
+		/** @brief Heap memory owned by the context, NULL if taken from a workspace */
+		uint32_t* buffer;
+	};
+
+	/** @brief Build a Montgomery context
+	 *
+	 * Calculates n' and R^2 mod n for the
+	 * provided modulus.  The context must be
+	 * released with base10MontgomeryFree(...).
+	 * If a workspace is provided, the context
+	 * lives until the workspace is released,
+	 * otherwise it is allocated on the heap.
+	 *
+	 * @param [out] ctx Context to be filled
+	 * @param [in] mod Modulus, must be odd and greater than one
+	 * @param [in] length Number of uint32_t in mod
+	 * @param [in/out] scratch Workspace, may be NULL
+	 * @return 1 if success, 0 if the modulus is not supported
+	 */
+	int base10MontgomeryInit(struct montgomeryContext* ctx, const uint32_t* mod, uint16_t length, struct numberScratch* scratch);
+	/** @brief Release a Montgomery context
+	 *
+	 * @param [in/out] ctx Context to be released
+	 * @return void
+	 */
+	void base10MontgomeryFree(struct montgomeryContext* ctx);
+	/** @brief Montgomery reduction
+	 *
+	 * Calculates src1*R^-1 mod n.  src1 must
+	 * be less than n*R.
+	 *
+	 * @param [in] ctx Montgomery context
+	 * @param [in/out] src1 Argument, 2*ctx->length+1 uint32_t, destroyed
+	 * @param [out] dest Output, ctx->length uint32_t
+	 * @return void
+	 */
+	void base10MontgomeryReduce(const struct montgomeryContext* ctx, uint32_t* src1, uint32_t* dest);
+	/** @brief Montgomery multiplication
+	 *
+	 * Calculates src1*src2*R^-1 mod n.  Arguments
+	 * are ctx->length uint32_t, dest may overlap
+	 * either source.
+	 *
+	 * @param [in] ctx Montgomery context
+	 * @param [in] src1 Argument 1
+	 * @param [in] src2 Argument 2
+	 * @param [out] dest Output
+	 * @param [in/out] scratch Workspace
+	 * @return void
+	 */
+	void base10MontgomeryMultiply(const struct montgomeryContext* ctx, const uint32_t* src1, const uint32_t* src2, uint32_t* dest, struct numberScratch* scratch);
+	/** @brief Montgomery squaring
+	 *
+	 * Calculates src1*src1*R^-1 mod n.
+	 *
+	 * @param [in] ctx Montgomery context
+	 * @param [in] src1 Argument 1
+	 * @param [out] dest Output
+	 * @param [in/out] scratch Workspace
+	 * @return void
+	 */
+	void base10MontgomerySquare(const struct montgomeryContext* ctx, const uint32_t* src1, uint32_t* dest, struct numberScratch* scratch);
+	/** @brief Montgomery exponentiation
+	 *
+	 * Calculates src1^src2 mod n, converting
+	 * src1 into Montgomery form, running a left-to-right
+	 * sliding window of up to 5 bits and converting
+	 * the result back out.
+	 *
+	 * @param [in] ctx Montgomery context
+	 * @param [in] src1 Base, ctx->length uint32_t, less than R
+	 * @param [in] src2 Exponent
+	 * @param [in] expLength Number of uint32_t in src2
+	 * @param [out] dest Output, ctx->length uint32_t
+	 * @param [in/out] scratch Workspace, at least 25*ctx->length+64 free
+	 * @return 1 if success, 0 if failed
+	 */
+	int base10MontgomeryExponentiation(const struct montgomeryContext* ctx, const uint32_t* src1, const uint32_t* src2, uint16_t expLength, uint32_t* dest, struct numberScratch* scratch);
+	/** @brief Base-10 modulo exponentiation
+	 *
+	 * Calculates src1^src2 mod src3.  Odd
+	 * moduli use Montgomery multiplication.  The
+	 * exponent is scanned from its top set bit
+	 * with a sliding window of odd powers.  Exponents
+	 * of one word are passed to base10ModuloExponentiationWord(...).
+	 * Products are taken at full width, so the modulus
+	 * may fill all length elements.
+	 *
+	 * @param [in] src1 Base
+	 * @param [in] src2 Exponent
+	 * @param [in] src3 Modulus
+	 * @param [out] dest Output
+	 * @param [in] length Number of uint32_t in the arrays
+	 * @return 1 if success, 0 if failed
+	 */
 	int base10ModuloExponentiation(const uint32_t* src1, const uint32_t* src2, const uint32_t* src3, uint32_t* dest, uint16_t length);
+	/** @brief Base-10 modulo exponentiation with scratch workspace
+     *
+     * Identical to base10ModuloExponentiation(...), but takes
+     * temporaries from the provided workspace.
+     *
+     * @param [in/out] scratch Workspace, at least NUMBER_SCRATCH_SIZE(length) free
+     * @return 1 if success, 0 if failed
+     */
+    int base10ModuloExponentiationScratch(const uint32_t* src1, const uint32_t* src2, const uint32_t* src3, uint32_t* dest, uint16_t length, struct numberScratch* scratch);
+	/** @brief Base-10 word exponent modulo exponentiation
+	 *
+	 * Calculates src1^src2 mod src3 for a single word
+	 * exponent, such as the RSA public exponent.  Runs
+	 * one squaring per exponent bit and one multiplication
+	 * per set bit, each reduced with long division, without
+	 * building a window table or Montgomery context.
+	 *
+	 * @param [in] src1 Base
+	 * @param [in] src2 Exponent
+	 * @param [in] src3 Modulus
+	 * @param [out] dest Output
+	 * @param [in] length Number of uint32_t in the arrays
+	 * @return 1 if success, 0 if failed
+	 */
+	int base10ModuloExponentiationWord(const uint32_t* src1, uint32_t src2, const uint32_t* src3, uint32_t* dest, uint16_t length);
+	/** @brief Base-10 word exponent modulo exponentiation with scratch workspace
+     *
+     * Identical to base10ModuloExponentiationWord(...), but takes
+     * temporaries from the provided workspace.
+     *
+     * @param [in/out] scratch Workspace, at least NUMBER_SCRATCH_SIZE(length) free
+     * @return 1 if success, 0 if failed
+     */
+    int base10ModuloExponentiationWordScratch(const uint32_t* src1, uint32_t src2, const uint32_t* src3, uint32_t* dest, uint16_t length, struct numberScratch* scratch);
 
+	/** @brief Base-10 greatest common denominator
+     *
+     * Lehmer's GCD: Euclid runs on the leading
+     * 32 bits of the pair, and the resulting cofactors
+     * are applied to the full numbers once per word
+     * of progress.  The last word is finished with
+     * single word Euclid.
+     *
+     * @param [in] src1 Argument 1
+     * @param [in] src2 Argument 2
+     * @param [out] dest Output
+     * @param [in] length Number of uint32_t in the arrays
+     * @return 1 if success, 0 if failed
+     */
 	int base10GCD(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length);
+	/** @brief Base-10 GCD with scratch workspace
+     *
+     * Identical to base10GCD(...), but takes
+     * temporaries from the provided workspace.
+     *
+     * @param [in/out] scratch Workspace, at least NUMBER_SCRATCH_SIZE(length) free
+     * @return 1 if success, 0 if failed
+     */
+    int base10GCDScratch(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length, struct numberScratch* scratch);
+	/** @brief Base-10 modular inverse
+     *
+     * Calculates src1^-1 mod src2 with the binary
+     * extended GCD, which only shifts, adds and
+     * subtracts.  An even src2 is handled by inverting
+     * src2 modulo src1 instead.  If no inverse exists,
+     * dest is set to 1.
+     *
+     * @param [in] src1 Argument 1
+     * @param [in] src2 Modulus
+     * @param [out] dest Output
+     * @param [in] length Number of uint32_t in the arrays
+     * @return 1 if success, 0 if failed
+     */
 	int base10ModInverse(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length);
+	/** @brief Base-10 modular inverse with scratch workspace
+     *
+     * Identical to base10ModInverse(...), but takes
+     * temporaries from the provided workspace.
+     *
+     * @param [in/out] scratch Workspace, at least NUMBER_SCRATCH_SIZE(length) free
+     * @return 1 if success, 0 if failed
+     */
+    int base10ModInverseScratch(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length, struct numberScratch* scratch);
 
+	/** @brief Miller-Rabin prime test
+     *
+     * Screens src1 by trial division, then runs
+     * test_iteration strong probable prime rounds,
+     * to the bases 2 and 3 followed by random
+     * witnesses.  Witnesses are drawn from
+     * cryptoRandomFill(...).
+     *
+     * @param [in] src1 Number to be tested
+     * @param [in] test_iteration Number of rounds, at least 1
+     * @param [in] length Number of uint32_t in src1
+     * @return 1 if probably prime, 0 if composite or failed
+     */
 	int primeTest(const uint32_t* src1, uint16_t test_iteration, uint16_t length);
+	/** @brief Prime test with scratch workspace
+     *
+     * Identical to primeTest(...), but takes
+     * temporaries from the provided workspace.
+     *
+     * @param [in/out] scratch Workspace, at least NUMBER_SCRATCH_SIZE(length)+8*length free
+     * @return 1 if success, 0 if failed
+     */
+    int primeTestScratch(const uint32_t* src1, uint16_t test_iteration, uint16_t length, struct numberScratch* scratch);
+	/** @brief Baillie-PSW prime test
+     *
+     * Screens src1 by trial division, then runs
+     * a strong probable prime test to base 2 and
+     * a strong Lucas test with Selfridge's parameters.
+     * No composite is known to pass both.  The cost
+     * is about two modular exponentiations.
+     * test_iteration random Miller-Rabin rounds
+     * may be added on top.
+     *
+     * @param [in] src1 Number to be tested
+     * @param [in] test_iteration Number of extra Miller-Rabin rounds
+     * @param [in] length Number of uint32_t in src1
+     * @return 1 if probably prime, 0 if composite or failed
+     */
+	int primeTestBPSW(const uint32_t* src1, uint16_t test_iteration, uint16_t length);
+	/** @brief Baillie-PSW prime test with scratch workspace
+     *
+     * Identical to primeTestBPSW(...), but takes
+     * temporaries from the provided workspace.
+     *
+     * @param [in/out] scratch Workspace, at least NUMBER_SCRATCH_SIZE(length)+8*length free
+     * @return 1 if success, 0 if failed
+     */
+    int primeTestBPSWScratch(const uint32_t* src1, uint16_t test_iteration, uint16_t length, struct numberScratch* scratch);
+    /** @brief Small prime table
+     *
+     * Fills primes with the odd primes below
+     * bound, in increasing order, for use in
+     * base10SieveResidues(...) and base10SieveInterval(...).
+     *
+     * @param [out] primes Output, room for max uint16_t
+     * @param [in] max Maximum number of primes to write
+     * @param [in] bound Exclusive upper bound, no more than 65536
+     * @return Number of primes written
+     */
+    uint16_t base10SmallPrimes(uint16_t* primes, uint16_t max, uint32_t bound);
+    /** @brief Small prime residues
+     *
+     * Reduces src1 modulo each entry of the small
+     * prime table.  These residues are the starting
+     * state for base10SieveInterval(...).
+     *
+     * @param [in] src1 Argument 1
+     * @param [in] length Number of uint32_t in src1
+     * @param [in] primes Small prime table
+     * @param [in] count Number of entries in primes
+     * @param [out] residues Output, count uint16_t
+     * @return void
+     */
+    void base10SieveResidues(const uint32_t* src1, uint16_t length, const uint16_t* primes, uint16_t count, uint16_t* residues);
+    /** @brief Sieve an interval of odd candidates
+     *
+     * Given the residues of a base b, sets sieve[i]
+     * to 1 if b+2*i is divisible by a prime in the
+     * table and to 0 otherwise, for i below width.
+     * The residues are then advanced to those of
+     * b+2*width, ready for the next interval.  Note that
+     * candidates equal to a table prime are marked too.
+     *
+     * @param [in/out] residues Residues of the base, count uint16_t
+     * @param [in] primes Small prime table
+     * @param [in] count Number of entries in primes
+     * @param [out] sieve Output, width bytes
+     * @param [in] width Number of candidates in the interval
+     * @return void
+     */
+    void base10SieveInterval(uint16_t* residues, const uint16_t* primes, uint16_t count, uint8_t* sieve, uint32_t width);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,780 @@
+/**
+ * @file   C_Algorithms/c_BaseTen64.c
+ * @author Jonathan Bedard
+ * @date   10/18/2026
+ * @brief  Implementation of 64-bit limb base-10 algorithms
+ * @bug No known bugs.
+ *
+ * This file implements multiplication, division
+ * and modular exponentiation of base-10 integers
+ * on 64-bit limbs.  Arguments are loaded from
+ * their uint32_t storage into 64-bit limbs in
+ * the workspace and stored back when done.
+ *
+ */
+
+///@cond INTERNAL
+
+#ifndef C_BASE_TEN_64_C
+#define C_BASE_TEN_64_C
+
+#include "c_BaseTen64.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    static bool baseTen64Init = false;
+    static struct numberType _baseTen64;
+
+    //Returns the definition of a 64-bit limb base Ten number
+    struct numberType* buildBaseTen64Type()
+    {
+        if(baseTen64Init) return &_baseTen64;
+
+        _baseTen64.typeID = crypto_numbertype_base10x64;
+        _baseTen64.name = crypto_numbername_base10x64;
+
+        _baseTen64.compare = &standardCompare;
+
+        _baseTen64.addition = &base10Addition;
+        _baseTen64.subtraction = &base10Subtraction;
+
+        _baseTen64.rightShift = &standardRightShift;
+        _baseTen64.leftShift = &standardLeftShift;
+
+        _baseTen64.multiplication = &base10x64Multiplication;
+        _baseTen64.square = &base10x64Square;
+        _baseTen64.division = &base10x64Division;
+		_baseTen64.modulo = &base10x64Modulo;
+		_baseTen64.multiplicationFull = &base10x64MultiplicationFull;
+		_baseTen64.moduloFull = &base10x64ModuloFull;
+		_baseTen64.addWord = &base10AdditionWord;
+		_baseTen64.mulWord = &base10MultiplicationWord;
+		_baseTen64.divmodWord = &base10DivisionWord;
+		_baseTen64.modWord = &base10ModuloWord;
+
+		_baseTen64.exponentiation = &base10Exponentiation;
+		_baseTen64.moduloExponentiation = &base10x64ModuloExponentiation;
+		_baseTen64.moduloExponentiationWord = &base10x64ModuloExponentiationWord;
+
+		_baseTen64.gcd = &base10GCD;
+		_baseTen64.modInverse = &base10ModInverse;
+
+        baseTen64Init = true;
+        return &_baseTen64;
+    }
+
+	//Wrappers reserving the thread workspace
+	int base10x64Multiplication(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length)
+	{
+		if(length<=0) return 0;
+		struct numberScratch* scratch=numberScratchThread();
+		if(!numberScratchReserve(scratch,NUMBER_SCRATCH_SIZE(length))) return 0;
+		return base10x64MultiplicationScratch(src1,src2,dest,length,scratch);
+	}
+	int base10x64Square(const uint32_t* src1, uint32_t* dest, uint16_t length)
+	{
+		if(length<=0) return 0;
+		struct numberScratch* scratch=numberScratchThread();
+		if(!numberScratchReserve(scratch,NUMBER_SCRATCH_SIZE(length))) return 0;
+		return base10x64SquareScratch(src1,dest,length,scratch);
+	}
+	int base10x64Division(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length)
+	{
+		if(length<=0) return 0;
+		struct numberScratch* scratch=numberScratchThread();
+		if(!numberScratchReserve(scratch,NUMBER_SCRATCH_SIZE(length))) return 0;
+		return base10x64DivisionScratch(src1,src2,dest,length,scratch);
+	}
+	int base10x64Modulo(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length)
+	{
+		if(length<=0) return 0;
+		struct numberScratch* scratch=numberScratchThread();
+		if(!numberScratchReserve(scratch,NUMBER_SCRATCH_SIZE(length))) return 0;
+		return base10x64ModuloScratch(src1,src2,dest,length,scratch);
+	}
+	int base10x64MultiplicationFull(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length)
+	{
+		if(length<=0) return 0;
+		struct numberScratch* scratch=numberScratchThread();
+		if(!numberScratchReserve(scratch,NUMBER_SCRATCH_SIZE(length))) return 0;
+		return base10x64MultiplicationFullScratch(src1,src2,dest,length,scratch);
+	}
+	int base10x64ModuloFull(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length)
+	{
+		if(length<=0) return 0;
+		struct numberScratch* scratch=numberScratchThread();
+		if(!numberScratchReserve(scratch,NUMBER_SCRATCH_SIZE(length))) return 0;
+		return base10x64ModuloFullScratch(src1,src2,dest,length,scratch);
+	}
+	int base10x64ModuloExponentiation(const uint32_t* src1, const uint32_t* src2, const uint32_t* src3, uint32_t* dest, uint16_t length)
+	{
+		if(length<=0) return 0;
+		struct numberScratch* scratch=numberScratchThread();
+		if(!numberScratchReserve(scratch,NUMBER_SCRATCH_SIZE(length))) return 0;
+		return base10x64ModuloExponentiationScratch(src1,src2,src3,dest,length,scratch);
+	}
+	int base10x64ModuloExponentiationWord(const uint32_t* src1, uint32_t src2, const uint32_t* src3, uint32_t* dest, uint16_t length)
+	{
+		if(length<=0) return 0;
+		struct numberScratch* scratch=numberScratchThread();
+		if(!numberScratchReserve(scratch,NUMBER_SCRATCH_SIZE(length))) return 0;
+		return base10x64ModuloExponentiationWordScratch(src1,src2,src3,dest,length,scratch);
+	}
+
+#ifdef __SIZEOF_INT128__
+
+	typedef unsigned __int128 x64Wide;
+
+	//Montgomery context on 64-bit limbs
+	struct x64Montgomery
+	{
+		uint16_t length;
+		uint64_t nPrime;
+		uint64_t* modulus;
+		uint64_t* rSquared;
+	};
+
+	int base10x64Supported() {return 1;}
+
+	//Take 64-bit aligned limbs from the workspace
+	static uint64_t* x64Push(struct numberScratch* scratch, uint32_t len)
+	{
+		uint32_t* ret=numberScratchPush(scratch,2*len+1);
+		if(((uintptr_t)ret)&7) ret++;
+		return (uint64_t*) ret;
+	}
+	//Load uint32_t storage into len 64-bit limbs
+	static void x64Load(const uint32_t* src1, uint16_t length, uint64_t* dest, uint16_t len)
+	{
+		for(uint16_t cnt=0;cnt<len;cnt++)
+		{
+			uint64_t lo=2*cnt<length?src1[2*cnt]:0;
+			uint64_t hi=2*cnt+1<length?src1[2*cnt+1]:0;
+			dest[cnt]=(hi<<32)|lo;
+		}
+	}
+	//Store len 64-bit limbs into uint32_t storage, 1 if nothing was cut off
+	static int x64Store(const uint64_t* src1, uint16_t len, uint32_t* dest, uint16_t length)
+	{
+		for(uint16_t cnt=0;cnt<length;cnt++)
+		{
+			uint64_t limb=cnt/2<len?src1[cnt/2]:0;
+			dest[cnt]=(uint32_t)(cnt&1?limb>>32:limb);
+		}
+		for(uint32_t cnt=length;cnt<2*(uint32_t)len;cnt++)
+		{
+			if((uint32_t)(src1[cnt/2]>>(cnt&1?32:0))) return 0;
+		}
+		return 1;
+	}
+	static int x64Compare(const uint64_t* src1, const uint64_t* src2, uint16_t len)
+	{
+		for(int cnt=len-1;cnt>=0;cnt--)
+		{
+			if(src1[cnt]>src2[cnt]) return 1;
+			if(src1[cnt]<src2[cnt]) return -1;
+		}
+		return 0;
+	}
+	static void x64Subtract(uint64_t* src1, const uint64_t* src2, uint16_t len)
+	{
+		uint64_t borrow=0;
+		for(uint16_t cnt=0;cnt<len;cnt++)
+		{
+			uint64_t t=src1[cnt]-src2[cnt]-borrow;
+			borrow=src1[cnt]<src2[cnt] || (src1[cnt]==src2[cnt] && borrow);
+			src1[cnt]=t;
+		}
+	}
+	//Schoolbook multiplication, dest is len1+len2 limbs
+	static void x64MultiplyFull(const uint64_t* src1, uint16_t len1, const uint64_t* src2, uint16_t len2, uint64_t* dest)
+	{
+		memset(dest,0,sizeof(uint64_t)*(len1+len2));
+		for(uint16_t cnt=0;cnt<len1;cnt++)
+		{
+			uint64_t carry=0;
+			for(uint16_t cnt2=0;cnt2<len2;cnt2++)
+			{
+				x64Wide t=(x64Wide)src1[cnt]*src2[cnt2]+dest[cnt+cnt2]+carry;
+				dest[cnt+cnt2]=(uint64_t)t;
+				carry=(uint64_t)(t>>64);
+			}
+			dest[cnt+len2]=carry;
+		}
+	}
+	//Schoolbook squaring, dest is 2*len1 limbs
+	static void x64SquareFull(const uint64_t* src1, uint16_t len1, uint64_t* dest)
+	{
+		memset(dest,0,sizeof(uint64_t)*2*len1);
+
+		//Cross products once
+		for(uint16_t cnt=0;cnt<len1;cnt++)
+		{
+			uint64_t carry=0;
+			for(uint16_t cnt2=cnt+1;cnt2<len1;cnt2++)
+			{
+				x64Wide t=(x64Wide)src1[cnt]*src1[cnt2]+dest[cnt+cnt2]+carry;
+				dest[cnt+cnt2]=(uint64_t)t;
+				carry=(uint64_t)(t>>64);
+			}
+			dest[cnt+len1]=carry;
+		}
+
+		//Double the cross products, then add the diagonal
+		uint64_t top=0;
+		for(uint32_t cnt=0;cnt<2*(uint32_t)len1;cnt++)
+		{
+			uint64_t next=dest[cnt]>>63;
+			dest[cnt]=(dest[cnt]<<1)|top;
+			top=next;
+		}
+		uint64_t carry=0;
+		for(uint16_t cnt=0;cnt<len1;cnt++)
+		{
+			x64Wide t=(x64Wide)src1[cnt]*src1[cnt]+dest[2*cnt]+carry;
+			dest[2*cnt]=(uint64_t)t;
+			t=(t>>64)+dest[2*cnt+1];
+			dest[2*cnt+1]=(uint64_t)t;
+			carry=(uint64_t)(t>>64);
+		}
+	}
+	//Long division (Knuth, Algorithm D) on 64-bit limbs
+	static void x64DivideLimbs(const uint64_t* src1, uint16_t len1, const uint64_t* src2, uint16_t len2, uint64_t* quot, uint64_t* rem, struct numberScratch* scratch)
+	{
+		//Single limb divisor
+		if(len2==1)
+		{
+			x64Wide r=0;
+			for(int cnt=len1-1;cnt>=0;cnt--)
+			{
+				r=(r<<64)|src1[cnt];
+				if(quot) quot[cnt]=(uint64_t)(r/src2[0]);
+				r%=src2[0];
+			}
+			if(rem) rem[0]=(uint64_t)r;
+			return;
+		}
+
+		//Normalize so the top bit of the divisor is set
+		uint32_t mark=scratch->used;
+		uint64_t* un=x64Push(scratch,len1+1);
+		uint64_t* vn=x64Push(scratch,len2);
+		int shift=0;
+		for(uint64_t top=src2[len2-1];!(top>>63);top<<=1)
+			shift++;
+		for(int cnt=len2-1;cnt>0;cnt--)
+			vn[cnt]=(src2[cnt]<<shift)|(shift?src2[cnt-1]>>(64-shift):0);
+		vn[0]=src2[0]<<shift;
+		un[len1]=shift?src1[len1-1]>>(64-shift):0;
+		for(int cnt=len1-1;cnt>0;cnt--)
+			un[cnt]=(src1[cnt]<<shift)|(shift?src1[cnt-1]>>(64-shift):0);
+		un[0]=src1[0]<<shift;
+
+		for(int j=len1-len2;j>=0;j--)
+		{
+			//Estimate quotient limb from the top two limbs
+			x64Wide num=((x64Wide)un[j+len2]<<64)|un[j+len2-1];
+			x64Wide qhat=num/vn[len2-1];
+			x64Wide rhat=num%vn[len2-1];
+			while((qhat>>64) || qhat*vn[len2-2]>((rhat<<64)|un[j+len2-2]))
+			{
+				qhat--;
+				rhat+=vn[len2-1];
+				if(rhat>>64) break;
+			}
+
+			//Multiply and subtract
+			uint64_t q=(uint64_t)qhat;
+			uint64_t borrow=0;
+			for(int cnt=0;cnt<len2;cnt++)
+			{
+				x64Wide p=(x64Wide)q*vn[cnt]+borrow;
+				uint64_t low=(uint64_t)p;
+				borrow=(uint64_t)(p>>64)+(un[cnt+j]<low);
+				un[cnt+j]-=low;
+			}
+			int negative=un[j+len2]<borrow;
+			un[j+len2]-=borrow;
+
+			//Estimate was one too large, add back
+			if(negative)
+			{
+				q--;
+				x64Wide carry=0;
+				for(int cnt=0;cnt<len2;cnt++)
+				{
+					carry+=(x64Wide)un[cnt+j]+vn[cnt];
+					un[cnt+j]=(uint64_t)carry;
+					carry>>=64;
+				}
+				un[j+len2]+=(uint64_t)carry;
+			}
+			if(quot) quot[j]=q;
+		}
+
+		//Denormalize the remainder
+		if(rem)
+		{
+			for(int cnt=0;cnt<len2-1;cnt++)
+				rem[cnt]=(un[cnt]>>shift)|(shift?un[cnt+1]<<(64-shift):0);
+			rem[len2-1]=un[len2-1]>>shift;
+		}
+		scratch->used=mark;
+	}
+
+	//Multiplication
+	int base10x64MultiplicationScratch(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length, struct numberScratch* scratch)
+	{
+		if(length<=0) return 0;
+
+		uint16_t len1=standardUsedLength(src1,length);
+		uint16_t len2=standardUsedLength(src2,length);
+		if(len1==0 || len2==0)
+		{
+			memset(dest,0,sizeof(uint32_t)*length);
+			return 1;
+		}
+
+		uint16_t w1=(len1+1)/2;
+		uint16_t w2=(len2+1)/2;
+		uint32_t mark=scratch->used;
+		uint64_t* a=x64Push(scratch,w1);
+		uint64_t* b=x64Push(scratch,w2);
+		uint64_t* prod=x64Push(scratch,w1+w2);
+		x64Load(src1,len1,a,w1);
+		x64Load(src2,len2,b,w2);
+		x64MultiplyFull(a,w1,b,w2,prod);
+
+		//Overflow if any part of the product is cut off
+		int ret=x64Store(prod,w1+w2,dest,length);
+		scratch->used=mark;
+		return ret;
+	}
+	//Squaring
+	int base10x64SquareScratch(const uint32_t* src1, uint32_t* dest, uint16_t length, struct numberScratch* scratch)
+	{
+		if(length<=0) return 0;
+
+		uint16_t len1=standardUsedLength(src1,length);
+		if(len1==0)
+		{
+			memset(dest,0,sizeof(uint32_t)*length);
+			return 1;
+		}
+
+		uint16_t w1=(len1+1)/2;
+		uint32_t mark=scratch->used;
+		uint64_t* a=x64Push(scratch,w1);
+		uint64_t* prod=x64Push(scratch,2*w1);
+		x64Load(src1,len1,a,w1);
+		x64SquareFull(a,w1,prod);
+
+		int ret=x64Store(prod,2*w1,dest,length);
+		scratch->used=mark;
+		return ret;
+	}
+	//Division
+	int base10x64DivisionScratch(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length, struct numberScratch* scratch)
+	{
+		if(length<=0) return 0;
+
+		//Exit if divide by zero
+		uint16_t len2=standardUsedLength(src2,length);
+		if(len2==0)
+		{
+			memset(dest,0,sizeof(uint32_t)*length);
+			return 0;
+		}
+
+		//Quotient is zero if src1 is shorter than src2
+		uint16_t len1=standardUsedLength(src1,length);
+		if(len1<len2)
+		{
+			memset(dest,0,sizeof(uint32_t)*length);
+			return 1;
+		}
+
+		uint16_t w1=(len1+1)/2;
+		uint16_t w2=(len2+1)/2;
+		uint32_t mark=scratch->used;
+		uint64_t* a=x64Push(scratch,w1);
+		uint64_t* b=x64Push(scratch,w2);
+		uint64_t* quot=x64Push(scratch,w1-w2+1);
+		x64Load(src1,len1,a,w1);
+		x64Load(src2,len2,b,w2);
+		x64DivideLimbs(a,w1,b,w2,quot,NULL,scratch);
+		x64Store(quot,w1-w2+1,dest,length);
+		scratch->used=mark;
+		return 1;
+	}
+	//Modulo
+	int base10x64ModuloScratch(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length, struct numberScratch* scratch)
+	{
+		if(length<=0) return 0;
+
+		//Exit if divide by zero
+		uint16_t len2=standardUsedLength(src2,length);
+		if(len2==0)
+		{
+			memset(dest,0,sizeof(uint32_t)*length);
+			return 0;
+		}
+
+		//Remainder is src1 if src1 is shorter than src2
+		uint16_t len1=standardUsedLength(src1,length);
+		if(len1<len2)
+		{
+			if(dest!=src1)
+				memcpy(dest,src1,sizeof(uint32_t)*length);
+			return 1;
+		}
+
+		uint16_t w1=(len1+1)/2;
+		uint16_t w2=(len2+1)/2;
+		uint32_t mark=scratch->used;
+		uint64_t* a=x64Push(scratch,w1);
+		uint64_t* b=x64Push(scratch,w2);
+		uint64_t* rem=x64Push(scratch,w2);
+		x64Load(src1,len1,a,w1);
+		x64Load(src2,len2,b,w2);
+		x64DivideLimbs(a,w1,b,w2,NULL,rem,scratch);
+		x64Store(rem,w2,dest,length);
+		scratch->used=mark;
+		return 1;
+	}
+
+	//Full width multiplication
+	int base10x64MultiplicationFullScratch(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length, struct numberScratch* scratch)
+	{
+		if(length<=0) return 0;
+
+		uint16_t len1=standardUsedLength(src1,length);
+		uint16_t len2=standardUsedLength(src2,length);
+		if(len1==0 || len2==0)
+		{
+			memset(dest,0,sizeof(uint32_t)*2*length);
+			return 1;
+		}
+
+		uint16_t w1=(len1+1)/2;
+		uint16_t w2=(len2+1)/2;
+		uint32_t mark=scratch->used;
+		uint64_t* a=x64Push(scratch,w1);
+		uint64_t* b=x64Push(scratch,w2);
+		uint64_t* prod=x64Push(scratch,w1+w2);
+		x64Load(src1,len1,a,w1);
+		x64Load(src2,len2,b,w2);
+		if(src1==src2)
+			x64SquareFull(a,w1,prod);
+		else
+			x64MultiplyFull(a,w1,b,w2,prod);
+		x64Store(prod,w1+w2,dest,2*length);
+		scratch->used=mark;
+		return 1;
+	}
+	//Full width modulo
+	int base10x64ModuloFullScratch(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length, struct numberScratch* scratch)
+	{
+		if(length<=0) return 0;
+
+		//Exit if divide by zero
+		uint16_t len2=standardUsedLength(src2,length);
+		if(len2==0)
+		{
+			memset(dest,0,sizeof(uint32_t)*length);
+			return 0;
+		}
+
+		//Remainder is src1 if src1 is shorter than src2
+		uint16_t len1=standardUsedLength(src1,2*length);
+		if(len1<len2)
+		{
+			memmove(dest,src1,sizeof(uint32_t)*len1);
+			memset(dest+len1,0,sizeof(uint32_t)*(length-len1));
+			return 1;
+		}
+
+		uint16_t w1=(len1+1)/2;
+		uint16_t w2=(len2+1)/2;
+		uint32_t mark=scratch->used;
+		uint64_t* a=x64Push(scratch,w1);
+		uint64_t* b=x64Push(scratch,w2);
+		uint64_t* rem=x64Push(scratch,w2);
+		x64Load(src1,len1,a,w1);
+		x64Load(src2,len2,b,w2);
+		x64DivideLimbs(a,w1,b,w2,NULL,rem,scratch);
+		x64Store(rem,w2,dest,length);
+		scratch->used=mark;
+		return 1;
+	}
+
+	//Montgomery context for an odd modulus of modLen uint32_t
+	static void x64MontgomeryInit(struct x64Montgomery* ctx, const uint32_t* mod, uint16_t modLen, struct numberScratch* scratch)
+	{
+		uint16_t len=(modLen+1)/2;
+		ctx->length=len;
+		ctx->modulus=x64Push(scratch,len);
+		ctx->rSquared=x64Push(scratch,len);
+		x64Load(mod,modLen,ctx->modulus,len);
+
+		//n'=-n^-1 mod 2^64, Newton iteration doubles the correct bits
+		uint64_t inv=ctx->modulus[0];
+		for(int cnt=0;cnt<5;cnt++)
+			inv*=2-ctx->modulus[0]*inv;
+		ctx->nPrime=(uint64_t)0-inv;
+
+		//R^2 mod n, R=2^(64*len)
+		uint32_t mark=scratch->used;
+		uint64_t* r=x64Push(scratch,2*len+1);
+		memset(r,0,sizeof(uint64_t)*2*len);
+		r[2*len]=1;
+		x64DivideLimbs(r,2*len+1,ctx->modulus,len,NULL,ctx->rSquared,scratch);
+		scratch->used=mark;
+	}
+	//Final subtraction, src1 is below 2n and len+1 limbs
+	static void x64MontgomeryFinish(const struct x64Montgomery* ctx, uint64_t* src1, uint64_t* dest)
+	{
+		uint16_t len=ctx->length;
+		if(src1[len] || x64Compare(src1,ctx->modulus,len)>=0)
+			x64Subtract(src1,ctx->modulus,len);
+		memcpy(dest,src1,sizeof(uint64_t)*len);
+	}
+	//Interleaved Montgomery multiplication, work is len+2 limbs
+	static void x64MontgomeryMultiply(const struct x64Montgomery* ctx, const uint64_t* src1, const uint64_t* src2, uint64_t* dest, uint64_t* work)
+	{
+		uint16_t len=ctx->length;
+		const uint64_t* mod=ctx->modulus;
+		memset(work,0,sizeof(uint64_t)*(len+2));
+		for(uint16_t cnt=0;cnt<len;cnt++)
+		{
+			//work+=src1*src2[cnt]
+			uint64_t carry=0;
+			for(uint16_t cnt2=0;cnt2<len;cnt2++)
+			{
+				x64Wide t=(x64Wide)src1[cnt2]*src2[cnt]+work[cnt2]+carry;
+				work[cnt2]=(uint64_t)t;
+				carry=(uint64_t)(t>>64);
+			}
+			x64Wide t=(x64Wide)work[len]+carry;
+			work[len]=(uint64_t)t;
+			work[len+1]=(uint64_t)(t>>64);
+
+			//work=(work+m*n)/2^64
+			uint64_t m=work[0]*ctx->nPrime;
+			t=(x64Wide)m*mod[0]+work[0];
+			carry=(uint64_t)(t>>64);
+			for(uint16_t cnt2=1;cnt2<len;cnt2++)
+			{
+				t=(x64Wide)m*mod[cnt2]+work[cnt2]+carry;
+				work[cnt2-1]=(uint64_t)t;
+				carry=(uint64_t)(t>>64);
+			}
+			t=(x64Wide)work[len]+carry;
+			work[len-1]=(uint64_t)t;
+			work[len]=work[len+1]+(uint64_t)(t>>64);
+		}
+		x64MontgomeryFinish(ctx,work,dest);
+	}
+	//Montgomery squaring, work is 2*len+1 limbs
+	static void x64MontgomerySquare(const struct x64Montgomery* ctx, const uint64_t* src1, uint64_t* dest, uint64_t* work)
+	{
+		uint16_t len=ctx->length;
+		const uint64_t* mod=ctx->modulus;
+		x64SquareFull(src1,len,work);
+		work[2*len]=0;
+		for(uint16_t cnt=0;cnt<len;cnt++)
+		{
+			uint64_t m=work[cnt]*ctx->nPrime;
+			uint64_t carry=0;
+			for(uint16_t cnt2=0;cnt2<len;cnt2++)
+			{
+				x64Wide t=(x64Wide)m*mod[cnt2]+work[cnt+cnt2]+carry;
+				work[cnt+cnt2]=(uint64_t)t;
+				carry=(uint64_t)(t>>64);
+			}
+			for(uint32_t cnt2=cnt+len;carry && cnt2<=2*(uint32_t)len;cnt2++)
+			{
+				x64Wide t=(x64Wide)work[cnt2]+carry;
+				work[cnt2]=(uint64_t)t;
+				carry=(uint64_t)(t>>64);
+			}
+		}
+		x64MontgomeryFinish(ctx,work+len,dest);
+	}
+	//Modulo exponentiation
+	int base10x64ModuloExponentiationScratch(const uint32_t* src1, const uint32_t* src2, const uint32_t* src3, uint32_t* dest, uint16_t length, struct numberScratch* scratch)
+	{
+		if(length<=0) return 0;
+
+		//Montgomery form requires an odd modulus greater than one
+		uint16_t modLen=standardUsedLength(src3,length);
+		if(modLen==0 || !(src3[0]&1) || (modLen==1 && src3[0]==1))
+			return base10ModuloExponentiationScratch(src1,src2,src3,dest,length,scratch);
+
+		//Check if src1 is zero
+		uint16_t baseLen=standardUsedLength(src1,length);
+		if(baseLen==0)
+		{
+			memset((void*) dest,0,sizeof(uint32_t)*length);
+			return 1;
+		}
+
+		//Short exponents skip the Montgomery set-up
+		if(base10BitLength(src2,length)<=32)
+			return base10x64ModuloExponentiationWordScratch(src1,src2[0],src3,dest,length,scratch);
+
+		uint32_t mark=scratch->used;
+		struct x64Montgomery ctx;
+		x64MontgomeryInit(&ctx,src3,modLen,scratch);
+		uint16_t len=ctx.length;
+		uint32_t bits=base10BitLength(src2,length);
+		uint16_t window=base10WindowSize(bits,5);
+		uint32_t count=(uint32_t)1<<(window-1);
+		uint64_t* acc=x64Push(scratch,len);
+		uint64_t* work=x64Push(scratch,2*len+2);
+		uint64_t* table=x64Push(scratch,count*len);
+
+		//Reduce the base if it is longer than the modulus
+		if(baseLen>modLen)
+		{
+			uint16_t w1=(baseLen+1)/2;
+			uint32_t mark2=scratch->used;
+			uint64_t* a=x64Push(scratch,w1);
+			x64Load(src1,baseLen,a,w1);
+			x64DivideLimbs(a,w1,ctx.modulus,len,NULL,table,scratch);
+			scratch->used=mark2;
+		}
+		else
+			x64Load(src1,baseLen,table,len);
+
+		//Convert to Montgomery form: base*R^2*R^-1
+		x64MontgomeryMultiply(&ctx,table,ctx.rSquared,table,work);
+
+		//Odd powers base^3, base^5, ... from base^2
+		if(count>1)
+		{
+			x64MontgomerySquare(&ctx,table,acc,work);
+			for(uint32_t cnt=1;cnt<count;cnt++)
+				x64MontgomeryMultiply(&ctx,table+(cnt-1)*len,acc,table+cnt*len,work);
+		}
+		memset(acc,0,sizeof(uint64_t)*len);
+		acc[0]=1;
+		x64MontgomeryMultiply(&ctx,acc,ctx.rSquared,acc,work);
+
+		//Left-to-right sliding window from the top set bit
+		int first=1;
+		for(int32_t cnt=(int32_t)bits-1;cnt>=0;)
+		{
+			uint32_t val=0;
+			uint16_t width=1;
+			if(src2[cnt/32]&((uint32_t)1<<(cnt%32)))
+				width=base10ExponentWindow(src2,cnt,window,&val);
+			cnt-=width;
+
+			if(first)
+			{
+				memcpy(acc,table+(val>>1)*len,sizeof(uint64_t)*len);
+				first=0;
+				continue;
+			}
+			for(uint16_t cnt2=0;cnt2<width;cnt2++)
+				x64MontgomerySquare(&ctx,acc,acc,work);
+			if(val)
+				x64MontgomeryMultiply(&ctx,acc,table+(val>>1)*len,acc,work);
+		}
+
+		//Convert out of Montgomery form
+		memset(table,0,sizeof(uint64_t)*len);
+		table[0]=1;
+		x64MontgomeryMultiply(&ctx,acc,table,acc,work);
+		x64Store(acc,len,dest,length);
+
+		scratch->used=mark;
+		return 1;
+	}
+
+	//Word exponent modulo exponentiation
+	int base10x64ModuloExponentiationWordScratch(const uint32_t* src1, uint32_t src2, const uint32_t* src3, uint32_t* dest, uint16_t length, struct numberScratch* scratch)
+	{
+		if(length<=0) return 0;
+
+		//Exit if divide by zero
+		uint16_t modLen=standardUsedLength(src3,length);
+		if(modLen==0)
+			return base10ModuloExponentiationWordScratch(src1,src2,src3,dest,length,scratch);
+
+		uint16_t len=(modLen+1)/2;
+		uint16_t baseLen=standardUsedLength(src1,length);
+		uint16_t w1=(baseLen+1)/2;
+		uint32_t mark=scratch->used;
+		uint64_t* mod=x64Push(scratch,len);
+		uint64_t* base=x64Push(scratch,len);
+		uint64_t* acc=x64Push(scratch,len);
+		uint64_t* prod=x64Push(scratch,w1>2*len?w1:2*len);
+		x64Load(src3,modLen,mod,len);
+
+		//Reduce the base
+		if(w1>=len)
+		{
+			x64Load(src1,baseLen,prod,w1);
+			x64DivideLimbs(prod,w1,mod,len,NULL,base,scratch);
+		}
+		else
+			x64Load(src1,baseLen,base,len);
+		memset(acc,0,sizeof(uint64_t)*len);
+		acc[0]=1;
+
+		//Square and multiply from the top set bit
+		int top=31;
+		while(top>=0 && !(src2&((uint32_t)1<<top)))
+			top--;
+		if(top>=0)
+			memcpy(acc,base,sizeof(uint64_t)*len);
+		for(int cnt=top-1;cnt>=0;cnt--)
+		{
+			x64SquareFull(acc,len,prod);
+			x64DivideLimbs(prod,2*len,mod,len,NULL,acc,scratch);
+			if(src2&((uint32_t)1<<cnt))
+			{
+				x64MultiplyFull(acc,len,base,len,prod);
+				x64DivideLimbs(prod,2*len,mod,len,NULL,acc,scratch);
+			}
+		}
+
+		x64Store(acc,len,dest,length);
+		scratch->used=mark;
+		return 1;
+	}
+
+#else
+
+	//Without a 128-bit product, use the base-10 kernels
+	int base10x64Supported() {return 0;}
+	int base10x64ModuloExponentiationWordScratch(const uint32_t* src1, uint32_t src2, const uint32_t* src3, uint32_t* dest, uint16_t length, struct numberScratch* scratch)
+	{return base10ModuloExponentiationWordScratch(src1,src2,src3,dest,length,scratch);}
+	int base10x64MultiplicationScratch(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length, struct numberScratch* scratch)
+	{return base10MultiplicationScratch(src1,src2,dest,length,scratch);}
+	int base10x64SquareScratch(const uint32_t* src1, uint32_t* dest, uint16_t length, struct numberScratch* scratch)
+	{return base10SquareScratch(src1,dest,length,scratch);}
+	int base10x64DivisionScratch(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length, struct numberScratch* scratch)
+	{return base10DivisionScratch(src1,src2,dest,length,scratch);}
+	int base10x64ModuloScratch(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length, struct numberScratch* scratch)
+	{return base10ModuloScratch(src1,src2,dest,length,scratch);}
+	int base10x64MultiplicationFullScratch(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length, struct numberScratch* scratch)
+	{return base10MultiplicationFullScratch(src1,src2,dest,length,scratch);}
+	int base10x64ModuloFullScratch(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length, struct numberScratch* scratch)
+	{return base10ModuloFullScratch(src1,src2,dest,length,scratch);}
+	int base10x64ModuloExponentiationScratch(const uint32_t* src1, const uint32_t* src2, const uint32_t* src3, uint32_t* dest, uint16_t length, struct numberScratch* scratch)
+	{return base10ModuloExponentiationScratch(src1,src2,src3,dest,length,scratch);}
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+///@endcond
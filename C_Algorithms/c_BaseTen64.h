@@ -0,0 +1,238 @@
+/**
+ * @file   C_Algorithms/c_BaseTen64.h
+ * @author Jonathan Bedard
+ * @date   10/18/2026
+ * @brief  Base-10 number functions on 64-bit limbs
+ * @bug No known bugs.
+ *
+ * Contains functions which define a
+ * base-10 integer whose multiplication,
+ * division and modular exponentiation run
+ * on 64-bit limbs.  Numbers are stored
+ * exactly like base-10 numbers, as arrays
+ * of uint32_t, so the two types can be
+ * freely converted.
+ *
+ */
+
+#ifndef C_BASE_TEN_64_H
+#define C_BASE_TEN_64_H
+
+#include "c_BaseTen.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+	/** @brief Construct a 64-bit limb base-10 number
+     *
+     * This function will return a numberType
+     * pointer defining the function pointers
+     * for a base-10 number computed on 64-bit limbs.
+     * Operations without a 64-bit kernel share the
+     * base-10 functions.  Note that the resulting
+     * pointer points to a structure which is static
+     * to the c_BaseTen64.c file.
+     *
+     * @return Pointer to numberType of type base-10 x64
+     */
+    struct numberType* buildBaseTen64Type();
+    /** @brief 64-bit limb support
+     *
+     * The 64-bit kernels require a 128-bit
+     * product type.  Without one, every function
+     * in this file falls back to its base-10
+     * equivalent.
+     *
+     * @return 1 if the 64-bit kernels are compiled in, else 0
+     */
+    int base10x64Supported();
+
+    /** @brief Base-10 x64 multiplication
+     *
+     * This function takes in two arrays which
+     * represent base-10 numbers, preforms src1*src2
+     * on the pair and then output the result to
+     * dest.  Note that all three arrays must
+     * be the same size.
+     *
+     * @param [in] src1 Argument 1
+     * @param [in] src2 Argument 2
+     * @param [out] dest Output
+     * @param [in] length Number of uint32_t in the arrays
+     * @return 1 if success, 0 if failed
+     */
+    int base10x64Multiplication(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length);
+    /** @brief Base-10 x64 multiplication with scratch workspace
+     *
+     * Identical to base10x64Multiplication(...), but takes
+     * temporaries from the provided workspace.
+     *
+     * @param [in/out] scratch Workspace, at least NUMBER_SCRATCH_SIZE(length) free
+     * @return 1 if success, 0 if failed
+     */
+    int base10x64MultiplicationScratch(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length, struct numberScratch* scratch);
+    /** @brief Base-10 x64 squaring
+     *
+     * This function takes in an array which
+     * represents a base-10 number, preforms src1*src1
+     * and then outputs the result to dest.
+     * Note that both arrays must be the same size.
+     *
+     * @param [in] src1 Argument 1
+     * @param [out] dest Output
+     * @param [in] length Number of uint32_t in the arrays
+     * @return 1 if success, 0 if failed
+     */
+    int base10x64Square(const uint32_t* src1, uint32_t* dest, uint16_t length);
+    /** @brief Base-10 x64 squaring with scratch workspace
+     *
+     * Identical to base10x64Square(...), but takes
+     * temporaries from the provided workspace.
+     *
+     * @param [in/out] scratch Workspace, at least NUMBER_SCRATCH_SIZE(length) free
+     * @return 1 if success, 0 if failed
+     */
+    int base10x64SquareScratch(const uint32_t* src1, uint32_t* dest, uint16_t length, struct numberScratch* scratch);
+    /** @brief Base-10 x64 division
+     *
+     * This function takes in two arrays which
+     * represent base-10 numbers, preforms src1/src2
+     * on the pair and then output the result to
+     * dest.  Note that all three arrays must
+     * be the same size.
+     *
+     * @param [in] src1 Argument 1
+     * @param [in] src2 Argument 2
+     * @param [out] dest Output
+     * @param [in] length Number of uint32_t in the arrays
+     * @return 1 if success, 0 if failed
+     */
+    int base10x64Division(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length);
+    /** @brief Base-10 x64 division with scratch workspace
+     *
+     * Identical to base10x64Division(...), but takes
+     * temporaries from the provided workspace.
+     *
+     * @param [in/out] scratch Workspace, at least NUMBER_SCRATCH_SIZE(length) free
+     * @return 1 if success, 0 if failed
+     */
+    int base10x64DivisionScratch(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length, struct numberScratch* scratch);
+    /** @brief Base-10 x64 modulo
+     *
+     * This function takes in two arrays which
+     * represent base-10 numbers, preforms src1%src2
+     * on the pair and then output the result to
+     * dest.  Note that all three arrays must
+     * be the same size.
+     *
+     * @param [in] src1 Argument 1
+     * @param [in] src2 Argument 2
+     * @param [out] dest Output
+     * @param [in] length Number of uint32_t in the arrays
+     * @return 1 if success, 0 if failed
+     */
+    int base10x64Modulo(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length);
+    /** @brief Base-10 x64 modulo with scratch workspace
+     *
+     * Identical to base10x64Modulo(...), but takes
+     * temporaries from the provided workspace.
+     *
+     * @param [in/out] scratch Workspace, at least NUMBER_SCRATCH_SIZE(length) free
+     * @return 1 if success, 0 if failed
+     */
+    int base10x64ModuloScratch(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length, struct numberScratch* scratch);
+    /** @brief Base-10 x64 full width multiplication
+     *
+     * Identical to base10MultiplicationFull(...),
+     * computed on 64-bit limbs.
+     *
+     * @param [in] src1 Argument 1
+     * @param [in] src2 Argument 2
+     * @param [out] dest Output, 2*length uint32_t
+     * @param [in] length Number of uint32_t in the arguments
+     * @return 1 if success, 0 if failed
+     */
+    int base10x64MultiplicationFull(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length);
+    /** @brief Base-10 x64 full width multiplication with scratch workspace
+     *
+     * Identical to base10x64MultiplicationFull(...), but takes
+     * temporaries from the provided workspace.
+     *
+     * @param [in/out] scratch Workspace, at least NUMBER_SCRATCH_SIZE(length) free
+     * @return 1 if success, 0 if failed
+     */
+    int base10x64MultiplicationFullScratch(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length, struct numberScratch* scratch);
+    /** @brief Base-10 x64 full width modulo
+     *
+     * Identical to base10ModuloFull(...),
+     * computed on 64-bit limbs.
+     *
+     * @param [in] src1 Argument 1, 2*length uint32_t
+     * @param [in] src2 Argument 2
+     * @param [out] dest Output
+     * @param [in] length Number of uint32_t in src2 and dest
+     * @return 1 if success, 0 if failed
+     */
+    int base10x64ModuloFull(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length);
+    /** @brief Base-10 x64 full width modulo with scratch workspace
+     *
+     * Identical to base10x64ModuloFull(...), but takes
+     * temporaries from the provided workspace.
+     *
+     * @param [in/out] scratch Workspace, at least NUMBER_SCRATCH_SIZE(length) free
+     * @return 1 if success, 0 if failed
+     */
+    int base10x64ModuloFullScratch(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length, struct numberScratch* scratch);
+    /** @brief Base-10 x64 modulo exponentiation
+     *
+     * Calculates src1^src2 mod src3.  Odd moduli
+     * use 64-bit Montgomery multiplication, all
+     * others are passed to base10ModuloExponentiation(...).
+     *
+     * @param [in] src1 Base
+     * @param [in] src2 Exponent
+     * @param [in] src3 Modulus
+     * @param [out] dest Output
+     * @param [in] length Number of uint32_t in the arrays
+     * @return 1 if success, 0 if failed
+     */
+    int base10x64ModuloExponentiation(const uint32_t* src1, const uint32_t* src2, const uint32_t* src3, uint32_t* dest, uint16_t length);
+    /** @brief Base-10 x64 modulo exponentiation with scratch workspace
+     *
+     * Identical to base10x64ModuloExponentiation(...), but takes
+     * temporaries from the provided workspace.
+     *
+     * @param [in/out] scratch Workspace, at least NUMBER_SCRATCH_SIZE(length) free
+     * @return 1 if success, 0 if failed
+     */
+    int base10x64ModuloExponentiationScratch(const uint32_t* src1, const uint32_t* src2, const uint32_t* src3, uint32_t* dest, uint16_t length, struct numberScratch* scratch);
+    /** @brief Base-10 x64 word exponent modulo exponentiation
+     *
+     * Calculates src1^src2 mod src3 for a single word
+     * exponent with 64-bit square, multiply and long
+     * division.
+     *
+     * @param [in] src1 Base
+     * @param [in] src2 Exponent
+     * @param [in] src3 Modulus
+     * @param [out] dest Output
+     * @param [in] length Number of uint32_t in the arrays
+     * @return 1 if success, 0 if failed
+     */
+    int base10x64ModuloExponentiationWord(const uint32_t* src1, uint32_t src2, const uint32_t* src3, uint32_t* dest, uint16_t length);
+    /** @brief Base-10 x64 word exponent modulo exponentiation with scratch workspace
+     *
+     * Identical to base10x64ModuloExponentiationWord(...), but takes
+     * temporaries from the provided workspace.
+     *
+     * @param [in/out] scratch Workspace, at least NUMBER_SCRATCH_SIZE(length) free
+     * @return 1 if success, 0 if failed
+     */
+    int base10x64ModuloExponentiationWordScratch(const uint32_t* src1, uint32_t src2, const uint32_t* src3, uint32_t* dest, uint16_t length, struct numberScratch* scratch);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
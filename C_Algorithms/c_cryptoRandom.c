@@ -0,0 +1,221 @@
+/**
+ * @file   C_Algorithms/c_cryptoRandom.c
+ * @author Jonathan Bedard
+ * @date   10/18/2026
+ * @brief  Implementation of the ChaCha20 random number generator
+ * @bug No known bugs.
+ *
+ * Implements the ChaCha20 block function
+ * and a buffered, per-thread generator
+ * which erases its key after every refill.
+ * A generator copied by fork(2) discards
+ * its state and reseeds in the child.
+ *
+ */
+
+///@cond INTERNAL
+
+#ifndef C_CRYPTO_RANDOM_C
+#define C_CRYPTO_RANDOM_C
+
+#include "c_cryptoRandom.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <errno.h>
+#if defined(__linux__)
+	#include <sys/random.h>
+#endif
+#if !defined(_WIN32)
+	#include <unistd.h>
+#endif
+
+//Bytes of key stream per refill, the first 32 become the next key
+#define CRYPTO_RANDOM_BUFFER 1024
+//Refills between operating system reseeds
+#define CRYPTO_RANDOM_RESEED 1024
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+	//Generator of a single thread
+	struct cryptoRandomState
+	{
+		uint32_t key[8];
+		uint8_t buffer[CRYPTO_RANDOM_BUFFER];
+		uint16_t available;
+		uint16_t refills;
+		int seeded;
+		long pid;
+	};
+
+	#define CHACHA_ROTATE(x,n) (((x)<<(n))|((x)>>(32-(n))))
+	#define CHACHA_QUARTER(a,b,c,d) \
+		a+=b; d^=a; d=CHACHA_ROTATE(d,16); \
+		c+=d; b^=c; b=CHACHA_ROTATE(b,12); \
+		a+=b; d^=a; d=CHACHA_ROTATE(d,8); \
+		c+=d; b^=c; b=CHACHA_ROTATE(b,7);
+
+	//ChaCha20 block function
+	void chacha20Block(const uint32_t* key, uint32_t counter, const uint32_t* nonce, uint32_t* dest)
+	{
+		uint32_t state[16];
+		state[0]=0x61707865;
+		state[1]=0x3320646e;
+		state[2]=0x79622d32;
+		state[3]=0x6b206574;
+		for(int cnt=0;cnt<8;cnt++)
+			state[4+cnt]=key[cnt];
+		state[12]=counter;
+		state[13]=nonce[0];
+		state[14]=nonce[1];
+		state[15]=nonce[2];
+
+		memcpy(dest,state,sizeof(state));
+		for(int cnt=0;cnt<10;cnt++)
+		{
+			//Column round
+			CHACHA_QUARTER(dest[0],dest[4],dest[8],dest[12])
+			CHACHA_QUARTER(dest[1],dest[5],dest[9],dest[13])
+			CHACHA_QUARTER(dest[2],dest[6],dest[10],dest[14])
+			CHACHA_QUARTER(dest[3],dest[7],dest[11],dest[15])
+			//Diagonal round
+			CHACHA_QUARTER(dest[0],dest[5],dest[10],dest[15])
+			CHACHA_QUARTER(dest[1],dest[6],dest[11],dest[12])
+			CHACHA_QUARTER(dest[2],dest[7],dest[8],dest[13])
+			CHACHA_QUARTER(dest[3],dest[4],dest[9],dest[14])
+		}
+		for(int cnt=0;cnt<16;cnt++)
+			dest[cnt]+=state[cnt];
+	}
+	//Operating system entropy
+	int cryptoRandomSeed(void* dest, size_t length)
+	{
+		uint8_t* out=(uint8_t*) dest;
+#if defined(__linux__)
+		while(length>0)
+		{
+			ssize_t got=getrandom(out,length,0);
+			if(got<0)
+			{
+				if(errno==EINTR) continue;
+				break;
+			}
+			out+=got;
+			length-=(size_t)got;
+		}
+		if(length==0) return 1;
+#endif
+		FILE* urandom=fopen("/dev/urandom","rb");
+		if(urandom)
+		{
+			size_t got=fread(out,1,length,urandom);
+			fclose(urandom);
+			length-=got;
+		}
+		return length==0;
+	}
+	//Process owning the generators
+	static long cryptoRandomPid()
+	{
+#if defined(_WIN32)
+		return 0;
+#else
+		return (long)getpid();
+#endif
+	}
+	//Seed a generator, mixing in the clock if the system has no entropy
+	static void cryptoRandomInit(struct cryptoRandomState* state)
+	{
+		uint32_t seed[8];
+		state->seeded=cryptoRandomSeed(seed,sizeof(seed))?1:-1;
+		if(state->seeded<0)
+		{
+			seed[0]^=(uint32_t)time(NULL);
+			seed[1]^=(uint32_t)clock();
+			seed[2]^=(uint32_t)(uintptr_t)state;
+		}
+		for(int cnt=0;cnt<8;cnt++)
+			state->key[cnt]^=seed[cnt];
+		memset(seed,0,sizeof(seed));
+		state->refills=0;
+		state->pid=cryptoRandomPid();
+	}
+	//Refill the buffer and replace the key
+	static void cryptoRandomRefill(struct cryptoRandomState* state)
+	{
+		static const uint32_t nonce[3]={0,0,0};
+		uint32_t block[16];
+		//A weak seed retries the system on every refill
+		if(state->seeded<=0 || state->refills>=CRYPTO_RANDOM_RESEED)
+			cryptoRandomInit(state);
+
+		for(uint32_t cnt=0;cnt<CRYPTO_RANDOM_BUFFER/64;cnt++)
+		{
+			chacha20Block(state->key,cnt,nonce,block);
+			for(int cnt2=0;cnt2<16;cnt2++)
+			{
+				uint8_t* out=state->buffer+64*cnt+4*cnt2;
+				out[0]=(uint8_t)block[cnt2];
+				out[1]=(uint8_t)(block[cnt2]>>8);
+				out[2]=(uint8_t)(block[cnt2]>>16);
+				out[3]=(uint8_t)(block[cnt2]>>24);
+			}
+		}
+		memset(block,0,sizeof(block));
+
+		//Fast key erasure, the old key cannot be recovered from the new one
+		memcpy(state->key,state->buffer,sizeof(state->key));
+		memset(state->buffer,0,sizeof(state->key));
+		state->available=CRYPTO_RANDOM_BUFFER-sizeof(state->key);
+		state->refills++;
+	}
+	//Take bytes from a generator, erasing them from the buffer
+	static int cryptoRandomTake(struct cryptoRandomState* state, uint8_t* dest, size_t length)
+	{
+		//The parent holds the same key and buffer after a fork
+		if(state->seeded && state->pid!=cryptoRandomPid())
+			state->seeded=0;
+		//Bytes of a weak or stale seed are discarded
+		if(state->seeded<=0)
+		{
+			memset(state->buffer,0,sizeof(state->buffer));
+			state->available=0;
+		}
+		int strong=1;
+		while(length>0)
+		{
+			if(state->available==0)
+				cryptoRandomRefill(state);
+			strong&=state->seeded>0;
+			size_t take=length<state->available?length:state->available;
+			uint8_t* src=state->buffer+CRYPTO_RANDOM_BUFFER-state->available;
+			memcpy(dest,src,take);
+			memset(src,0,take);
+			state->available-=(uint16_t)take;
+			dest+=take;
+			length-=take;
+		}
+		return strong && state->seeded>0;
+	}
+
+#ifdef __cplusplus
+}
+
+	//Owns the generator of a single thread, wiped on exit
+	struct threadRandom
+	{
+		struct cryptoRandomState state;
+		~threadRandom(){memset(&state,0,sizeof(state));}
+	};
+	static thread_local struct threadRandom _threadRandom;
+	extern "C" int cryptoRandomFill(void* dest, size_t length) {return cryptoRandomTake(&_threadRandom.state,(uint8_t*) dest,length);}
+#else
+	static _Thread_local struct cryptoRandomState _threadRandom;
+	int cryptoRandomFill(void* dest, size_t length) {return cryptoRandomTake(&_threadRandom,(uint8_t*) dest,length);}
+#endif
+
+#endif
+
+///@endcond
@@ -0,0 +1,72 @@
+/**
+ * @file   C_Algorithms/c_cryptoRandom.h
+ * @author Jonathan Bedard
+ * @date   10/18/2026
+ * @brief  ChaCha20 random number generator
+ * @bug No known bugs.
+ *
+ * Contains a cryptographically secure
+ * random number generator used for keys,
+ * session streams and prime testing.
+ * Each thread owns a ChaCha20 state
+ * seeded from the operating system.
+ *
+ */
+
+#ifndef C_CRYPTO_RANDOM_H
+#define C_CRYPTO_RANDOM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    #include <stdint.h>
+    #include <stddef.h>
+
+    /** @brief ChaCha20 block function
+     *
+     * Computes one 64 byte block of
+     * the ChaCha20 key stream, as
+     * defined in RFC 8439.
+     *
+     * @param [in] key Key, 8 uint32_t
+     * @param [in] counter Block counter
+     * @param [in] nonce Nonce, 3 uint32_t
+     * @param [out] dest Output, 16 uint32_t
+     * @return void
+     */
+    void chacha20Block(const uint32_t* key, uint32_t counter, const uint32_t* nonce, uint32_t* dest);
+    /** @brief Operating system entropy
+     *
+     * Reads length bytes from getrandom(2),
+     * falling back to /dev/urandom.
+     *
+     * @param [out] dest Output
+     * @param [in] length Number of bytes
+     * @return 1 if success, 0 if failed
+     */
+    int cryptoRandomSeed(void* dest, size_t length);
+    /** @brief Fill with random bytes
+     *
+     * Copies length bytes from the key stream
+     * of the calling thread's generator.  The
+     * generator is seeded on first use and in
+     * a child after fork(2), re-keys itself after
+     * every buffer and reseeds from the operating
+     * system periodically.  The buffer is always
+     * filled, if no operating system entropy was
+     * available the seed is weak and 0 is returned
+     * until a later reseed succeeds.  Key material
+     * must not be taken from a fill returning 0.
+     *
+     * @param [out] dest Output
+     * @param [in] length Number of bytes
+     * @return 1 if success, 0 if seeded without entropy
+     */
+    int cryptoRandomFill(void* dest, size_t length);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -25,9 +25,11 @@ extern "C" {
 #endif
     const int crypto_numbertype_default=0;
 	const int crypto_numbertype_base10=1;
+	const int crypto_numbertype_base10x64=2;
 
 	const char* crypto_numbername_default="NULL Type";
 	const char* crypto_numbername_base10="Base 10 Type";
+	const char* crypto_numbername_base10x64="Base 10 x64 Type";
 
     static bool nullInit = false;
     static struct numberType _nullType;
@@ -49,11 +51,19 @@ extern "C" {
         _nullType.leftShift = NULL;
         
         _nullType.multiplication = NULL;
+        _nullType.square = NULL;
         _nullType.division = NULL;
 		_nullType.modulo = NULL;
+		_nullType.multiplicationFull = NULL;
+		_nullType.moduloFull = NULL;
+		_nullType.addWord = NULL;
+		_nullType.mulWord = NULL;
+		_nullType.divmodWord = NULL;
+		_nullType.modWord = NULL;
         
 		_nullType.exponentiation = NULL;
 		_nullType.moduloExponentiation = NULL;
+		_nullType.moduloExponentiationWord = NULL;
 
 		_nullType.gcd = NULL;
 		_nullType.modInverse = NULL;
@@ -64,6 +74,10 @@ extern "C" {
     //Standard compare function
     int standardCompare(const uint32_t* src1, const uint32_t* src2, uint16_t length)
     {
+#ifdef NUMBER_VECTOR_X86
+        if(length>=8 && numberVectorLevel()==NUMBER_VECTOR_AVX2)
+            return avx2Compare(src1,src2,length);
+#endif
         for(int cnt=length-1;cnt>=0;cnt--)
         {
             if(src1[cnt]>src2[cnt])
@@ -73,83 +87,185 @@ extern "C" {
         }
         return 0;
     }
+    //Number of used elements
+    uint16_t standardUsedLength(const uint32_t* src1, uint16_t length)
+    {
+#ifdef NUMBER_VECTOR_X86
+        if(length>=8 && numberVectorLevel()==NUMBER_VECTOR_AVX2)
+            return avx2UsedLength(src1,length);
+#endif
+        while(length>0 && src1[length-1]==0)
+            length--;
+        return length;
+    }
     //Standard right shift function
     int standardRightShift(const uint32_t* src1, uint16_t src2, uint32_t* dest, uint16_t length)
     {
 		if(length<=0) return 0;
-        
-		uint32_t* targ = (uint32_t*) malloc(length*sizeof(uint32_t));
+
         uint16_t bigShift=src2/32;
         uint16_t smallShift=src2%32;
-        
-        //Set to zero
-        int cnt=0;
-        for(cnt=0;cnt<length;cnt++)
-            targ[cnt]=0;
         if(bigShift>=length)
 		{
-			for(int cnt=0;cnt<length;cnt++)
-			dest[cnt]=targ[cnt];
-			free(targ);
+			memset(dest,0,sizeof(uint32_t)*length);
             return 1;
 		}
-        
-        uint32_t carry=src1[bigShift]>>smallShift;
-        for(cnt=bigShift+1;cnt<length;cnt++)
+
+        //Ascending, so dest may overlap src1
+        int cnt=0;
+#ifdef NUMBER_VECTOR_X86
+        if(numberVectorLevel()==NUMBER_VECTOR_AVX2)
+            cnt=avx2RightShift(src1,bigShift,smallShift,dest,length);
+#endif
+        for(;cnt+bigShift+1<length;cnt++)
         {
             if(smallShift>0)
-                targ[cnt-bigShift-1]=carry|src1[cnt]<<(32-smallShift);
+                dest[cnt]=(src1[cnt+bigShift]>>smallShift)|(src1[cnt+bigShift+1]<<(32-smallShift));
             else
-                targ[cnt-bigShift-1]=carry;
-            carry=src1[cnt]>>smallShift;
+                dest[cnt]=src1[cnt+bigShift];
         }
-		for(int cnt=0;cnt<length;cnt++)
-			dest[cnt]=targ[cnt];
-		free(targ);
+        dest[cnt]=src1[cnt+bigShift]>>smallShift;
+        for(cnt++;cnt<length;cnt++)
+            dest[cnt]=0;
         return 1;
     }
     //Standard left shift function
     int standardLeftShift(const uint32_t* src1, uint16_t src2, uint32_t* dest, uint16_t length)
     {
         if(length<=0) return 0;
-        
-        //Set to zero
-		uint32_t* targ = (uint32_t*) malloc(length*sizeof(uint32_t));
-        int cnt=0;
-        for(cnt=0;cnt<length;cnt++)
-            targ[cnt]=0;
-        
-		
+
         uint16_t bigShift=src2/32;
         uint16_t smallShift=src2%32;
-        uint32_t oldVal = 0;
-        
-        for(cnt=0;cnt+bigShift<length;cnt++)
+
+        //Check for lost bits before dest is written
+        int ret=1;
+        int cnt=0;
+        if(standardUsedLength(src1,length)>((bigShift<length)?length-bigShift:0))
+            ret=0;
+        if(ret && smallShift>0 && bigShift<length && (src1[length-bigShift-1]>>(32-smallShift))>0)
+            ret=0;
+        if(bigShift>=length)
+        {
+            memset(dest,0,sizeof(uint32_t)*length);
+            return ret;
+        }
+
+        //Descending, so dest may overlap src1
+        cnt=length-1;
+#ifdef NUMBER_VECTOR_X86
+        if(numberVectorLevel()==NUMBER_VECTOR_AVX2)
+            cnt-=avx2LeftShift(src1,bigShift,smallShift,dest,length);
+#endif
+        for(;cnt>bigShift;cnt--)
         {
             if(smallShift>0)
-            {
-                targ[cnt+bigShift]=oldVal | (src1[cnt]<<smallShift);
-                oldVal = src1[cnt]>>(32-smallShift);
-            }
+                dest[cnt]=(src1[cnt-bigShift]<<smallShift)|(src1[cnt-bigShift-1]>>(32-smallShift));
             else
-                targ[cnt+bigShift]=src1[cnt];
+                dest[cnt]=src1[cnt-bigShift];
         }
+        dest[bigShift]=src1[0]<<smallShift;
+        for(cnt=0;cnt<bigShift;cnt++)
+            dest[cnt]=0;
+        return ret;
+    }
+    //Bitwise OR
+    void standardOr(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length)
+    {
+#ifdef NUMBER_VECTOR_X86
+        if(length>=8 && numberVectorLevel()==NUMBER_VECTOR_AVX2)
+        {
+            avx2Or(src1,src2,dest,length);
+            return;
+        }
+#endif
+        for(uint16_t cnt=0;cnt<length;cnt++)
+            dest[cnt]=src1[cnt]|src2[cnt];
+    }
+    //Bitwise AND
+    void standardAnd(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length)
+    {
+#ifdef NUMBER_VECTOR_X86
+        if(length>=8 && numberVectorLevel()==NUMBER_VECTOR_AVX2)
+        {
+            avx2And(src1,src2,dest,length);
+            return;
+        }
+#endif
+        for(uint16_t cnt=0;cnt<length;cnt++)
+            dest[cnt]=src1[cnt]&src2[cnt];
+    }
+    //Bitwise XOR
+    void standardXor(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length)
+    {
+#ifdef NUMBER_VECTOR_X86
+        if(length>=8 && numberVectorLevel()==NUMBER_VECTOR_AVX2)
+        {
+            avx2Xor(src1,src2,dest,length);
+            return;
+        }
+#endif
+        for(uint16_t cnt=0;cnt<length;cnt++)
+            dest[cnt]=src1[cnt]^src2[cnt];
+    }
+    //Bitwise NOT
+    void standardNot(const uint32_t* src1, uint32_t* dest, uint16_t length)
+    {
+#ifdef NUMBER_VECTOR_X86
+        if(length>=8 && numberVectorLevel()==NUMBER_VECTOR_AVX2)
+        {
+            avx2Not(src1,dest,length);
+            return;
+        }
+#endif
+        for(uint16_t cnt=0;cnt<length;cnt++)
+            dest[cnt]=~src1[cnt];
+    }
+    //Reserve scratch workspace
+    int numberScratchReserve(struct numberScratch* scratch, uint32_t size)
+    {
+        if(scratch->size-scratch->used>=size) return 1;
+        if(scratch->used>0) return 0;
 
-		for(int cnt=0;cnt<length;cnt++)
-			dest[cnt]=targ[cnt];
-		free(targ);
-        if(oldVal>0) return 0;
-        
-        for(;cnt<length;cnt++)
+        if(scratch->data) free(scratch->data);
+        scratch->data=(uint32_t*) malloc(size*sizeof(uint32_t));
+        if(!scratch->data)
         {
-            if(src1[cnt]>0)
-                return 0;
+            scratch->size=0;
+            return 0;
         }
+        scratch->size=size;
         return 1;
     }
-    
+    //Take from scratch workspace
+    uint32_t* numberScratchPush(struct numberScratch* scratch, uint32_t size)
+    {
+        if(scratch->size-scratch->used<size) return NULL;
+        uint32_t* ret=scratch->data+scratch->used;
+        scratch->used+=size;
+        return ret;
+    }
+    //Release scratch workspace
+    void numberScratchFree(struct numberScratch* scratch)
+    {
+        if(scratch->data) free(scratch->data);
+        scratch->data=NULL;
+        scratch->size=0;
+        scratch->used=0;
+    }
 #ifdef __cplusplus
 }
+
+    //Owns the workspace of a single thread
+    struct threadScratch
+    {
+        struct numberScratch scratch;
+        ~threadScratch(){numberScratchFree(&scratch);}
+    };
+    static thread_local struct threadScratch _threadScratch;
+    extern "C" struct numberScratch* numberScratchThread() {return &_threadScratch.scratch;}
+#else
+    static _Thread_local struct numberScratch _threadScratch;
+    struct numberScratch* numberScratchThread() {return &_threadScratch;}
 #endif
 
 #endif
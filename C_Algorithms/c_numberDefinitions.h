@@ -19,6 +19,7 @@
 extern "C" {
 #endif
 	#include "cryptoCConstants.h"
+	#include "c_numberVector.h"
 
     #include <stdio.h>
     #include <stdint.h>
@@ -56,6 +57,74 @@ extern "C" {
      * @return 1 if success, 0 if failed
      */
 	typedef int (*tripleCalculation)(const uint32_t*,const uint32_t*,const uint32_t*,uint32_t*,uint16_t);
+	/** @brief Word triple operator function typedef
+     *
+     * Identical to tripleCalculation, except
+     * that the second argument is a single word.
+     *
+     * @param [in] uint32_t* Argument 1
+     * @param [in] uint32_t Argument 2
+     * @param [in] uint32_t* Argument 3
+     * @param [out] uint32_t* Output
+     * @param [in] uint16_t size
+     * @return 1 if success, 0 if failed
+     */
+	typedef int (*wordTripleCalculation)(const uint32_t*,uint32_t,const uint32_t*,uint32_t*,uint16_t);
+    /** @brief Word operator function typedef
+     *
+     * Identical to operatorFunction, except
+     * that the second argument is a single word.
+     *
+     * @param [in] uint32_t* Argument 1
+     * @param [in] uint32_t Argument 2
+     * @param [out] uint32_t* Output
+     * @param [in] uint16_t size
+     * @return 1 if success, 0 if failed
+     */
+    typedef int (*wordOperatorFunction)(const uint32_t*,uint32_t,uint32_t*,uint16_t);
+    /** @brief Word division function typedef
+     *
+     * This function typedef defines a function
+     * which divides an array representing a
+     * number by a single word, outputting the
+     * quotient to a second array and the remainder
+     * to a single word.
+     *
+     * @param [in] uint32_t* Argument 1
+     * @param [in] uint32_t Argument 2
+     * @param [out] uint32_t* Quotient
+     * @param [out] uint32_t* Remainder
+     * @param [in] uint16_t size
+     * @return 1 if success, 0 if failed
+     */
+    typedef int (*wordDivisionFunction)(const uint32_t*,uint32_t,uint32_t*,uint32_t*,uint16_t);
+    /** @brief Word modulo function typedef
+     *
+     * This function typedef defines a function
+     * which reduces an array representing a number
+     * by a single word, outputting a single word.
+     *
+     * @param [in] uint32_t* Argument 1
+     * @param [in] uint32_t Argument 2
+     * @param [out] uint32_t* Remainder
+     * @param [in] uint16_t size
+     * @return 1 if success, 0 if failed
+     */
+    typedef int (*wordModuloFunction)(const uint32_t*,uint32_t,uint32_t*,uint16_t);
+    /** @brief Unary operator function typedef
+     *
+     * This function typedef defines a function
+     * which takes in a single array representing
+     * a number, preforms some operation on it
+     * and then outputs the result to a second
+     * array.
+     *
+     * @param [in] uint32_t* Argument 1
+     * @param [out] uint32_t* Output
+     * @param [in] uint16_t size
+     * @return 1 if success, 0 if failed
+     */
+    typedef int (*unaryFunction)(const uint32_t*,uint32_t*,uint16_t);
     /** @brief Shift operator function typedef
      *
      * This function typedef defines a function
@@ -121,12 +190,40 @@ extern "C" {
         /** @brief Pointer to multiplication function
          */
         operatorFunction multiplication;
+        /** @brief Pointer to squaring function
+         */
+        unaryFunction square;
         /** @brief Pointer to division function
          */
         operatorFunction division;
         /** @brief Pointer to modulo function
          */
 		operatorFunction modulo;
+        /** @brief Pointer to full width multiplication function
+         *
+         * The output holds twice the size of the
+         * arguments, so the product never overflows.
+         */
+		operatorFunction multiplicationFull;
+        /** @brief Pointer to full width modulo function
+         *
+         * Argument 1 holds twice the size of argument 2
+         * and the output, reducing a full width product.
+         */
+		operatorFunction moduloFull;
+
+        /** @brief Pointer to word addition function
+         */
+		wordOperatorFunction addWord;
+        /** @brief Pointer to word multiplication function
+         */
+		wordOperatorFunction mulWord;
+        /** @brief Pointer to word division function
+         */
+		wordDivisionFunction divmodWord;
+        /** @brief Pointer to word modulo function
+         */
+		wordModuloFunction modWord;
 
         /** @brief Pointer to exponentiation function
          */
@@ -134,6 +231,9 @@ extern "C" {
         /** @brief Pointer to modulo exponentiation function
          */
 		tripleCalculation moduloExponentiation;
+        /** @brief Pointer to word exponent modulo exponentiation function
+         */
+		wordTripleCalculation moduloExponentiationWord;
 
         /** @brief Pointer to greatest common denominator function
          */
@@ -143,6 +243,35 @@ extern "C" {
 		operatorFunction modInverse;
     };
 
+    /** @brief Size of a scratch workspace
+     *
+     * Number of uint32_t a scratch workspace
+     * must hold to run any numberType operation
+     * on arrays of the given length.
+     */
+    #define NUMBER_SCRATCH_SIZE(length) (32*(uint32_t)(length)+64)
+
+    /** @brief Scratch workspace
+     *
+     * Stack-like workspace which the number
+     * algorithms take their temporaries from, so
+     * that a full operation makes no heap allocations.
+     * A function records "used" on entry and restores
+     * it before it returns.
+     */
+    struct numberScratch
+    {
+        /** @brief Workspace memory
+         */
+        uint32_t* data;
+        /** @brief Number of uint32_t in data
+         */
+        uint32_t size;
+        /** @brief Number of uint32_t currently in use
+         */
+        uint32_t used;
+    };
+
     /** @brief Construct a NULL number
      *
      * This function will return a numberType
@@ -166,11 +295,24 @@ extern "C" {
      * @return -1 if 1<2, 0 if 1==2, 1 if 1>2
      */
     int standardCompare(const uint32_t* src1, const uint32_t* src2, uint16_t length);
+    /** @brief Used length
+     *
+     * Finds the number of uint32_t in src1
+     * which are actually in use, that is, the
+     * index of the highest non-zero element
+     * plus one.
+     *
+     * @param [in] src1 Argument 1
+     * @param [in] length Number of uint32_t in the array
+     * @return Number of used uint32_t, 0 if src1 is zero
+     */
+    uint16_t standardUsedLength(const uint32_t* src1, uint16_t length);
     /** @brief Right shift
      *
      * Shifts the bits in src1 in the right direction
      * src2 number of bits.  Output the result in dest.
      * Note that dest and src1 should be the same size.
+     * dest may overlap src1.
      *
      * @param [in] src1 Argument 1
      * @param [in] src2 Bits to shift
@@ -184,6 +326,7 @@ extern "C" {
      * Shifts the bits in src1 in the left direction
      * src2 number of bits.  Output the result in dest.
      * Note that dest and src1 should be the same size.
+     * dest may overlap src1.
      *
      * @param [in] src1 Argument 1
      * @param [in] src2 Bits to shift
@@ -192,6 +335,93 @@ extern "C" {
      * @return 1 if success, 0 if failed
      */
     int standardLeftShift(const uint32_t* src1, uint16_t src2, uint32_t* dest, uint16_t length);
+    /** @brief Bitwise OR
+     *
+     * dest=src1|src2, element by element.
+     * dest may overlap either source.
+     *
+     * @param [in] src1 Argument 1
+     * @param [in] src2 Argument 2
+     * @param [out] dest Output
+     * @param [in] length Number of uint32_t in the arrays
+     * @return void
+     */
+    void standardOr(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length);
+    /** @brief Bitwise AND
+     *
+     * dest=src1&src2, element by element.
+     * dest may overlap either source.
+     *
+     * @param [in] src1 Argument 1
+     * @param [in] src2 Argument 2
+     * @param [out] dest Output
+     * @param [in] length Number of uint32_t in the arrays
+     * @return void
+     */
+    void standardAnd(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length);
+    /** @brief Bitwise XOR
+     *
+     * dest=src1^src2, element by element.
+     * dest may overlap either source.
+     *
+     * @param [in] src1 Argument 1
+     * @param [in] src2 Argument 2
+     * @param [out] dest Output
+     * @param [in] length Number of uint32_t in the arrays
+     * @return void
+     */
+    void standardXor(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length);
+    /** @brief Bitwise NOT
+     *
+     * dest=~src1, element by element.
+     * dest may overlap src1.
+     *
+     * @param [in] src1 Argument 1
+     * @param [out] dest Output
+     * @param [in] length Number of uint32_t in the arrays
+     * @return void
+     */
+    void standardNot(const uint32_t* src1, uint32_t* dest, uint16_t length);
+
+    /** @brief Reserve scratch workspace
+     *
+     * Ensures that at least "size" uint32_t
+     * are free in the workspace.  The workspace
+     * can only grow while nothing is in use.
+     *
+     * @param [in/out] scratch Workspace
+     * @param [in] size Number of uint32_t required
+     * @return 1 if success, 0 if failed
+     */
+    int numberScratchReserve(struct numberScratch* scratch, uint32_t size);
+    /** @brief Take from scratch workspace
+     *
+     * Returns the next "size" uint32_t of
+     * the workspace.  Release by restoring
+     * scratch->used.
+     *
+     * @param [in/out] scratch Workspace
+     * @param [in] size Number of uint32_t required
+     * @return Pointer to workspace memory, NULL if the workspace is full
+     */
+    uint32_t* numberScratchPush(struct numberScratch* scratch, uint32_t size);
+    /** @brief Release scratch workspace
+     *
+     * Frees the memory owned by a workspace.
+     *
+     * @param [in/out] scratch Workspace
+     * @return void
+     */
+    void numberScratchFree(struct numberScratch* scratch);
+    /** @brief Thread scratch workspace
+     *
+     * Returns a workspace owned by the calling
+     * thread.  The workspace keeps its memory
+     * between calls and is freed when the thread exits.
+     *
+     * @return Pointer to the workspace of this thread
+     */
+    struct numberScratch* numberScratchThread();
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,192 @@
+/**
+ * @file   C_Algorithms/c_numberVector.c
+ * @author Jonathan Bedard
+ * @date   10/18/2026
+ * @brief  Implementation of vectorized number kernels
+ * @bug No known bugs.
+ *
+ * Implements the AVX2 kernels and the runtime
+ * selection between them and the scalar loops.
+ * The kernels are compiled with a target attribute,
+ * so the rest of the library does not require AVX2.
+ *
+ */
+
+///@cond INTERNAL
+
+#ifndef C_NUMBER_VECTOR_C
+#define C_NUMBER_VECTOR_C
+
+#include "c_numberVector.h"
+
+#ifdef NUMBER_VECTOR_X86
+	#include <immintrin.h>
+	#define AVX2_TARGET __attribute__((target("avx2")))
+#endif
+
+//Level is read by every worker thread
+#ifdef __cplusplus
+	#include <atomic>
+	static std::atomic<int> _numberVectorLevel(-1);
+	#define LEVEL_LOAD() _numberVectorLevel.load(std::memory_order_relaxed)
+	#define LEVEL_STORE(val) _numberVectorLevel.store(val,std::memory_order_relaxed)
+#else
+	#include <stdatomic.h>
+	static _Atomic int _numberVectorLevel=-1;
+	#define LEVEL_LOAD() atomic_load_explicit(&_numberVectorLevel,memory_order_relaxed)
+	#define LEVEL_STORE(val) atomic_store_explicit(&_numberVectorLevel,val,memory_order_relaxed)
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+	//Processor support
+	int numberVectorSupported()
+	{
+#ifdef NUMBER_VECTOR_X86
+		__builtin_cpu_init();
+		if(__builtin_cpu_supports("avx2")) return NUMBER_VECTOR_AVX2;
+#endif
+		return NUMBER_VECTOR_SCALAR;
+	}
+	//Active level
+	int numberVectorLevel()
+	{
+		//Racing first calls store the same value
+		int level=LEVEL_LOAD();
+		if(level<0)
+		{
+			level=numberVectorSupported();
+			LEVEL_STORE(level);
+		}
+		return level;
+	}
+	//Force a level
+	int numberVectorSetLevel(int level)
+	{
+		if(level!=NUMBER_VECTOR_SCALAR && level!=NUMBER_VECTOR_AVX2) return 0;
+		if(level>numberVectorSupported()) return 0;
+		LEVEL_STORE(level);
+		return 1;
+	}
+
+#ifdef NUMBER_VECTOR_X86
+
+	//Compare from the top, 8 elements at a time
+	AVX2_TARGET int avx2Compare(const uint32_t* src1, const uint32_t* src2, uint16_t length)
+	{
+		int cnt=length;
+		while(cnt>=8)
+		{
+			__m256i a=_mm256_loadu_si256((const __m256i*)(src1+cnt-8));
+			__m256i b=_mm256_loadu_si256((const __m256i*)(src2+cnt-8));
+			uint32_t diff=~(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi32(a,b));
+			if(diff)
+			{
+				//Highest differing element, 4 mask bits each
+				int pos=cnt-8+(31-__builtin_clz(diff))/4;
+				return src1[pos]>src2[pos]?1:-1;
+			}
+			cnt-=8;
+		}
+		for(cnt--;cnt>=0;cnt--)
+		{
+			if(src1[cnt]>src2[cnt])
+				return 1;
+			else if(src1[cnt]<src2[cnt])
+				return -1;
+		}
+		return 0;
+	}
+	//Skip zero blocks from the top
+	AVX2_TARGET uint16_t avx2UsedLength(const uint32_t* src1, uint16_t length)
+	{
+		__m256i zero=_mm256_setzero_si256();
+		while(length>=8)
+		{
+			__m256i a=_mm256_loadu_si256((const __m256i*)(src1+length-8));
+			uint32_t used=~(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi32(a,zero));
+			if(used)
+				return (uint16_t)(length-8+(31-__builtin_clz(used))/4+1);
+			length-=8;
+		}
+		while(length>0 && src1[length-1]==0)
+			length--;
+		return length;
+	}
+	//Ascending blocks, each reads ahead of what it writes
+	AVX2_TARGET uint16_t avx2RightShift(const uint32_t* src1, uint16_t bigShift, uint16_t smallShift, uint32_t* dest, uint16_t length)
+	{
+		//Shift counts of 32 produce zero, no special case for smallShift==0
+		__m128i right=_mm_cvtsi32_si128(smallShift);
+		__m128i left=_mm_cvtsi32_si128(32-smallShift);
+		uint32_t cnt=0;
+		for(;cnt+bigShift+9<=length;cnt+=8)
+		{
+			__m256i low=_mm256_loadu_si256((const __m256i*)(src1+cnt+bigShift));
+			__m256i high=_mm256_loadu_si256((const __m256i*)(src1+cnt+bigShift+1));
+			__m256i out=_mm256_or_si256(_mm256_srl_epi32(low,right),_mm256_sll_epi32(high,left));
+			_mm256_storeu_si256((__m256i*)(dest+cnt),out);
+		}
+		return (uint16_t)cnt;
+	}
+	//Descending blocks, each reads below what it writes
+	AVX2_TARGET uint16_t avx2LeftShift(const uint32_t* src1, uint16_t bigShift, uint16_t smallShift, uint32_t* dest, uint16_t length)
+	{
+		__m128i left=_mm_cvtsi32_si128(smallShift);
+		__m128i right=_mm_cvtsi32_si128(32-smallShift);
+		uint32_t done=0;
+		for(;(uint32_t)bigShift+done+9<=length;done+=8)
+		{
+			uint32_t cnt=length-done-8;
+			__m256i high=_mm256_loadu_si256((const __m256i*)(src1+cnt-bigShift));
+			__m256i low=_mm256_loadu_si256((const __m256i*)(src1+cnt-bigShift-1));
+			__m256i out=_mm256_or_si256(_mm256_sll_epi32(high,left),_mm256_srl_epi32(low,right));
+			_mm256_storeu_si256((__m256i*)(dest+cnt),out);
+		}
+		return (uint16_t)done;
+	}
+
+	//Bitwise operation on blocks, scalar tail
+	#define AVX2_BITWISE(name,vector,scalar) \
+	AVX2_TARGET void name(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length) \
+	{ \
+		uint32_t cnt=0; \
+		for(;cnt+8<=length;cnt+=8) \
+		{ \
+			__m256i a=_mm256_loadu_si256((const __m256i*)(src1+cnt)); \
+			__m256i b=_mm256_loadu_si256((const __m256i*)(src2+cnt)); \
+			_mm256_storeu_si256((__m256i*)(dest+cnt),vector(a,b)); \
+		} \
+		for(;cnt<length;cnt++) \
+			dest[cnt]=src1[cnt] scalar src2[cnt]; \
+	}
+	AVX2_BITWISE(avx2Or,_mm256_or_si256,|)
+	AVX2_BITWISE(avx2And,_mm256_and_si256,&)
+	AVX2_BITWISE(avx2Xor,_mm256_xor_si256,^)
+	#undef AVX2_BITWISE
+
+	//Bitwise NOT as XOR with all ones
+	AVX2_TARGET void avx2Not(const uint32_t* src1, uint32_t* dest, uint16_t length)
+	{
+		__m256i ones=_mm256_set1_epi32(-1);
+		uint32_t cnt=0;
+		for(;cnt+8<=length;cnt+=8)
+		{
+			__m256i a=_mm256_loadu_si256((const __m256i*)(src1+cnt));
+			_mm256_storeu_si256((__m256i*)(dest+cnt),_mm256_xor_si256(a,ones));
+		}
+		for(;cnt<length;cnt++)
+			dest[cnt]=~src1[cnt];
+	}
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+///@endcond
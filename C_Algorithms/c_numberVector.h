@@ -0,0 +1,154 @@
+/**
+ * @file   C_Algorithms/c_numberVector.h
+ * @author Jonathan Bedard
+ * @date   10/18/2026
+ * @brief  Vectorized number kernels
+ * @bug No known bugs.
+ *
+ * Declares AVX2 versions of the linear
+ * number kernels: compare, used length,
+ * shifts and bitwise operations.  The
+ * standard kernels in c_numberDefinitions.h
+ * select them at runtime when the processor
+ * supports AVX2, otherwise the scalar loops run.
+ *
+ */
+
+#ifndef C_NUMBER_VECTOR_H
+#define C_NUMBER_VECTOR_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    #include <stdint.h>
+
+    #if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+        /** @brief AVX2 kernels are compiled
+         */
+        #define NUMBER_VECTOR_X86
+    #endif
+
+    /** @brief Scalar kernels
+     */
+    #define NUMBER_VECTOR_SCALAR 0
+    /** @brief AVX2 kernels
+     */
+    #define NUMBER_VECTOR_AVX2 1
+
+    /** @brief Supported vector level
+     *
+     * Queries the processor through cpuid.
+     *
+     * @return NUMBER_VECTOR_AVX2 if AVX2 is available, else NUMBER_VECTOR_SCALAR
+     */
+    int numberVectorSupported();
+    /** @brief Active vector level
+     *
+     * Defaults to numberVectorSupported() on first use.
+     *
+     * @return Level used by the standard kernels
+     */
+    int numberVectorLevel();
+    /** @brief Select vector level
+     *
+     * Forces the standard kernels onto a level,
+     * used to compare the scalar and vector
+     * kernels against each other.  Not thread
+     * safe, set it before numbers are in use.
+     *
+     * @param [in] level NUMBER_VECTOR_SCALAR or NUMBER_VECTOR_AVX2
+     * @return 1 if set, 0 if the processor does not support level
+     */
+    int numberVectorSetLevel(int level);
+
+#ifdef NUMBER_VECTOR_X86
+    /** @brief AVX2 comparison
+     *
+     * Compares 8 uint32_t at a time from the
+     * most significant end.
+     *
+     * @param [in] src1 Argument 1
+     * @param [in] src2 Argument 2
+     * @param [in] length Number of uint32_t in the arrays
+     * @return -1 if 1<2, 0 if 1==2, 1 if 1>2
+     */
+    int avx2Compare(const uint32_t* src1, const uint32_t* src2, uint16_t length);
+    /** @brief AVX2 used length
+     *
+     * Skips zero blocks of 8 uint32_t
+     * from the most significant end.
+     *
+     * @param [in] src1 Argument 1
+     * @param [in] length Number of uint32_t in the array
+     * @return Number of used uint32_t, 0 if src1 is zero
+     */
+    uint16_t avx2UsedLength(const uint32_t* src1, uint16_t length);
+    /** @brief AVX2 right shift body
+     *
+     * Writes dest[cnt]=src1[cnt+bigShift]>>smallShift
+     * merged with the next element, ascending, for
+     * as many whole blocks as the input allows.
+     * dest may overlap src1.
+     *
+     * @param [in] src1 Argument 1
+     * @param [in] bigShift Shift in uint32_t
+     * @param [in] smallShift Shift in bits, below 32
+     * @param [out] dest Output
+     * @param [in] length Number of uint32_t in the arrays
+     * @return Number of elements written from the bottom of dest
+     */
+    uint16_t avx2RightShift(const uint32_t* src1, uint16_t bigShift, uint16_t smallShift, uint32_t* dest, uint16_t length);
+    /** @brief AVX2 left shift body
+     *
+     * Writes dest[cnt]=src1[cnt-bigShift]<<smallShift
+     * merged with the previous element, descending,
+     * for as many whole blocks as the input allows.
+     * dest may overlap src1.
+     *
+     * @param [in] src1 Argument 1
+     * @param [in] bigShift Shift in uint32_t
+     * @param [in] smallShift Shift in bits, below 32
+     * @param [out] dest Output
+     * @param [in] length Number of uint32_t in the arrays
+     * @return Number of elements written from the top of dest
+     */
+    uint16_t avx2LeftShift(const uint32_t* src1, uint16_t bigShift, uint16_t smallShift, uint32_t* dest, uint16_t length);
+    /** @brief AVX2 bitwise OR
+     * @param [in] src1 Argument 1
+     * @param [in] src2 Argument 2
+     * @param [out] dest Output, may overlap src1
+     * @param [in] length Number of uint32_t in the arrays
+     * @return void
+     */
+    void avx2Or(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length);
+    /** @brief AVX2 bitwise AND
+     * @param [in] src1 Argument 1
+     * @param [in] src2 Argument 2
+     * @param [out] dest Output, may overlap src1
+     * @param [in] length Number of uint32_t in the arrays
+     * @return void
+     */
+    void avx2And(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length);
+    /** @brief AVX2 bitwise XOR
+     * @param [in] src1 Argument 1
+     * @param [in] src2 Argument 2
+     * @param [out] dest Output, may overlap src1
+     * @param [in] length Number of uint32_t in the arrays
+     * @return void
+     */
+    void avx2Xor(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length);
+    /** @brief AVX2 bitwise NOT
+     * @param [in] src1 Argument 1
+     * @param [out] dest Output, may overlap src1
+     * @param [in] length Number of uint32_t in the arrays
+     * @return void
+     */
+    void avx2Not(const uint32_t* src1, uint32_t* dest, uint16_t length);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
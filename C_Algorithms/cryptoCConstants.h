@@ -35,6 +35,14 @@ extern const int crypto_numbertype_default;
  * integer.
  */
 extern const int crypto_numbertype_base10;
+/** @brief Base-10, 64-bit limb number ID
+ *
+ * This constant is 2.  It represents a
+ * base-10 integer whose arithmetic runs
+ * on 64-bit limbs.  Storage is identical
+ * to a base-10 number.
+ */
+extern const int crypto_numbertype_base10x64;
 
 /** @brief Default number marker
  *
@@ -49,6 +57,13 @@ extern const char* crypto_numbername_default;
  * base-10, or standard integer.
  */
 extern const char* crypto_numbername_base10;
+/** @brief Base-10, 64-bit limb number marker
+ *
+ * This constant is "Base 10 x64 Type".
+ * It represents a base-10 integer whose
+ * arithmetic runs on 64-bit limbs.
+ */
+extern const char* crypto_numbername_base10x64;
 
 ///@cond INTERAL
 
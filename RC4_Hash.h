@@ -92,6 +92,20 @@ namespace crypto {
          * @param [in] cpy Hash to be copied
          */
         rc4Hash(const rc4Hash& cpy):hash(cpy){}
+        /** @brief RC-4 hash move constructor
+         * @param [in/out] mv Hash to be moved from
+         */
+        rc4Hash(rc4Hash&& mv) noexcept:hash(std::move(mv)){}
+        /** @brief RC-4 hash copy assignment
+         * @param [in] cpy Hash to be copied
+         * @return Reference to this
+         */
+        rc4Hash& operator=(const rc4Hash& cpy){hash::operator=(cpy);return *this;}
+        /** @brief RC-4 hash move assignment
+         * @param [in/out] mv Hash to be moved from
+         * @return Reference to this
+         */
+        rc4Hash& operator=(rc4Hash&& mv) noexcept{hash::operator=(std::move(mv));return *this;}
         /** @brief Binds a data-set
          *
          * Preforms the hash algorithm on the
@@ -159,4 +173,4 @@ namespace crypto {
     };
 }
 
-#endif
\ No newline at end of file
+#endif
\ No newline at end of file
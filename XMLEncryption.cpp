@@ -332,20 +332,16 @@ namespace crypto {
 			encryHead->addChild(*trc1);
 
 			//Generate key, and hash
-			srand((unsigned)time(NULL));
 			unsigned int kySize=pbk->size()*4;
 			if(lockType==file::DOUBLE_LOCK)
 				kySize=2*kySize;
 			os::smart_ptr<unsigned char> randkey;
 			randkey=os::smart_ptr<unsigned char>(new unsigned char[kySize],os::shared_type_array);
 			memset(randkey.get(),0,kySize);
-			for(uint16_t i=0;i<(pbk->size()-1)*4;++i)
-				randkey[i]=rand();
-			if(lockType==file::DOUBLE_LOCK)
-			{
-				for(uint16_t i=0;i<(pbk->size()-1)*4;++i)
-					randkey[i+pbk->size()*4]=rand();
-			}
+			if(!cryptoRandomFill(randkey.get(),(pbk->size()-1)*4))
+				throw errorPointer(new randomSeedError(),os::shared_type);
+			if(lockType==file::DOUBLE_LOCK && !cryptoRandomFill(randkey.get()+pbk->size()*4,(pbk->size()-1)*4))
+				throw errorPointer(new randomSeedError(),os::shared_type);
 			os::smart_ptr<number> num1=pbk->copyConvert(randkey.get(),pbk->size()*4);
 			os::smart_ptr<number> num2;
 			num1->reduce();
@@ -502,11 +498,10 @@ namespace crypto {
 			encryHead->addChild(*trc1);
 
 			//Generate key, and hash
-			srand((unsigned)time(NULL));
 			os::smart_ptr<unsigned char> randkey=os::smart_ptr<unsigned char>(new unsigned char[pkframe->keySize()*4],os::shared_type_array);
 			memset(randkey.get(),0,pkframe->keySize()*4);
-			for(uint16_t i=0;i<(pkframe->keySize()-1)*4;++i)
-				randkey[i]=rand();
+			if(!cryptoRandomFill(randkey.get(),(pkframe->keySize()-1)*4))
+				throw errorPointer(new randomSeedError(),os::shared_type);
 			os::smart_ptr<number> num=pkframe->convert(randkey.get(),pkframe->keySize()*4);
 			num->reduce();
 			size_t keylen;
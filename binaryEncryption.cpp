@@ -201,19 +201,15 @@ namespace crypto {
 				output.write((char*)hsh.data(),hsh.size());
 
 			//Generate key, and hash
-			srand((unsigned)time(NULL));
 			unsigned int arrayLen=publicKeyLock->size()*4;
 			if(_publicLockType==file::DOUBLE_LOCK) arrayLen=publicKeyLock->size()*8;
 			randkey=os::smart_ptr<unsigned char>(new unsigned char[arrayLen],os::shared_type_array);
 			
 			memset(randkey.get(),0,arrayLen);
-			for(uint16_t i=0;i<(publicKeyLock->size()-1)*4;++i)
-				randkey[i]=rand();
-			if(_publicLockType==file::DOUBLE_LOCK)
-			{
-				for(uint16_t i=0;i<(publicKeyLock->size()-1)*4;++i)
-					randkey[i+publicKeyLock->size()*4]=rand();
-			}
+			if(!cryptoRandomFill(randkey.get(),(publicKeyLock->size()-1)*4))
+				throw errorPointer(new randomSeedError(),os::shared_type);
+			if(_publicLockType==file::DOUBLE_LOCK && !cryptoRandomFill(randkey.get()+publicKeyLock->size()*4,(publicKeyLock->size()-1)*4))
+				throw errorPointer(new randomSeedError(),os::shared_type);
 			hsh=_streamAlgorithm->hashData(randkey.get(),arrayLen);
 
 			//Generate stream cipher
@@ -292,11 +288,10 @@ namespace crypto {
 			output.write((char*)hsh.data(),hsh.size());
 
 			//Generate key, and hash
-			srand((unsigned)time(NULL));
 			randkey=os::smart_ptr<unsigned char>(new unsigned char[pkframe->keySize()*4],os::shared_type_array);
 			memset(randkey.get(),0,pkframe->keySize()*4);
-			for(uint16_t i=0;i<(pkframe->keySize()-1)*4;++i)
-				randkey[i]=rand();
+			if(!cryptoRandomFill(randkey.get(),(pkframe->keySize()-1)*4))
+				throw errorPointer(new randomSeedError(),os::shared_type);
 			hsh=_streamAlgorithm->hashData(randkey.get(),pkframe->keySize()*4);
 
 			//Generate stream cipher
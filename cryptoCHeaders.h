@@ -10,6 +10,9 @@
 #define CRYPTO_C_HEADERS_H
 
 #include "C_Algorithms/c_BaseTen.h"
+#include "C_Algorithms/c_BaseTen64.h"
 #include "C_Algorithms/c_numberDefinitions.h"
+#include "C_Algorithms/c_numberVector.h"
+#include "C_Algorithms/c_cryptoRandom.h"
 
 #endif
\ No newline at end of file
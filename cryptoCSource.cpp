@@ -16,6 +16,9 @@
 #define CRYPTO_C_SOURCE_CPP
 
 #include "C_Algorithms/c_numberDefinitions.c"
+#include "C_Algorithms/c_numberVector.c"
+#include "C_Algorithms/c_cryptoRandom.c"
 #include "C_Algorithms/c_BaseTen.c"
+#include "C_Algorithms/c_BaseTen64.c"
 
 #endif
\ No newline at end of file
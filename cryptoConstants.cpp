@@ -30,6 +30,9 @@ namespace crypto
 		/** @brief Base-10 number type integer ID
 		 */
 		const int Base10=crypto_numbertype_base10;
+		/** @brief Base-10, 64-bit limb number type integer ID
+		 */
+		const int Base10x64=crypto_numbertype_base10x64;
 	}
 	namespace numberName
 	{
@@ -39,12 +42,21 @@ namespace crypto
 		/** @brief Base-10 number type string ID
 		 */
 		const std::string Base10=std::string(crypto_numbername_base10);
+		/** @brief Base-10, 64-bit limb number type string ID
+		 */
+		const std::string Base10x64=std::string(crypto_numbername_base10x64);
 	}
     namespace algo
     {
 		/** @brief Number of test cycle for prime test
 		 */
         const uint16_t primeTestCycle=20;
+		/** @brief Miller-Rabin prime test ID
+		 */
+        const uint16_t primeMillerRabin=0;
+		/** @brief Baillie-PSW prime test ID
+		 */
+        const uint16_t primeBPSW=1;
         
 		/** @brief NULL hash algorithm ID
 		 */
@@ -122,6 +134,12 @@ namespace crypto
 		/** @brief 2048 bit public-key size in uint32_t
 		 */
 		const uint16_t public2048=64;
+		/** @brief 4096 bit public-key size in uint32_t
+		 */
+		const uint16_t public4096=128;
+		/** @brief 8192 bit public-key size in uint32_t
+		 */
+		const uint16_t public8192=256;
 		
 		/** @brief Maximum characters in a group name
 		 */
@@ -27,15 +27,19 @@ namespace crypto
 	{
 		extern const int Default;
 		extern const int Base10;
+		extern const int Base10x64;
 	}
 	namespace numberName
 	{
 		extern const std::string Default;
 		extern const std::string Base10;
+		extern const std::string Base10x64;
 	}
     namespace algo
     {
         extern const uint16_t primeTestCycle;
+        extern const uint16_t primeMillerRabin;
+        extern const uint16_t primeBPSW;
         
         extern const uint16_t hashNULL;
         extern const uint16_t hashXOR;
@@ -73,6 +77,8 @@ namespace crypto
 		extern const uint16_t public512;
 		extern const uint16_t public1024;
 		extern const uint16_t public2048;
+		extern const uint16_t public4096;
+		extern const uint16_t public8192;
 		
 		extern const uint16_t GROUP_SIZE;
 		extern const uint16_t NAME_SIZE;
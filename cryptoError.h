@@ -457,6 +457,37 @@ namespace crypto {
 		 */
 		std::string errorDescription() const {return "Could not generate a hash with the given arguments";}
 	};
+	/** @brief Random seed error
+	 *
+	 * Thrown when key material is needed
+	 * but the random number generator
+	 * has no operating system entropy.
+	 */
+	class randomSeedError: public error
+	{
+	public:
+		/** @brief Virtual destructor
+         *
+         * Destructor must be virtual, if an object
+         * of this type is deleted, the destructor
+         * of the type which inherits this class should
+         * be called.  Must explicitly declare that
+         * this function does not throw exceptions.
+         */
+		virtual ~randomSeedError() throw() {}
+		/** @brief Short error descriptor
+		 * Returns "Random Seed"
+		 * @return Error title std::string
+		 */
+		std::string errorTitle() const {return "Random Seed";}
+		/** @brief Long error descriptor
+		 * Returns "Random number generator
+		 * could not be seeded by the
+		 * operating system"
+		 * @return Error description std::string
+		 */
+		std::string errorDescription() const {return "Random number generator could not be seeded by the operating system";}
+	};
 
 	/** @brief File error
 	 *
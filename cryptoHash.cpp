@@ -57,6 +57,27 @@ using namespace crypto;
         memcpy(_data,cpy._data,_size*sizeof(unsigned char));
         return *this;
     }
+    //Move constructor
+    crypto::hash::hash(crypto::hash&& mv) noexcept
+    {
+        _size=mv._size;
+        _algorithm=mv._algorithm;
+        _data=mv._data;
+        mv._data=NULL;
+        mv._size=0;
+    }
+    //Move assignment
+    crypto::hash& crypto::hash::operator=(crypto::hash&& mv) noexcept
+    {
+        if(&mv==this) return *this;
+        delete [] _data;
+        _size=mv._size;
+        _algorithm=mv._algorithm;
+        _data=mv._data;
+        mv._data=NULL;
+        mv._size=0;
+        return *this;
+    }
     //Default destructor
     crypto::hash::~hash()
     {
@@ -16,6 +16,7 @@
 #include <string>
 #include <iostream>
 #include <stdlib.h>
+#include <utility>
 
 #include "Datastructures/Datastructures.h"
 #include "hexConversion.h"
@@ -124,6 +125,23 @@ namespace crypto {
          * @return Reference to this
          */
         hash& operator=(const hash& cpy);
+        /** @brief Hash move constructor
+         *
+         * Takes the data array of another hash,
+         * leaving it empty.
+         *
+         * @param [in/out] mv Hash to be moved from
+         */
+        hash(hash&& mv) noexcept;
+        /** @brief Move assignment
+         *
+         * Releases this hash's data and takes
+         * the data array of another hash.
+         *
+         * @param [in/out] mv Hash to be moved from
+         * @return Reference to this
+         */
+        hash& operator=(hash&& mv) noexcept;
         /** @brief Virtual destructor
          *
          * Destructor must be virtual, if an object
@@ -354,6 +372,20 @@ namespace crypto {
          * @param [in] cpy Hash to be copied
          */
         xorHash(const xorHash& cpy):hash(cpy){}
+        /** @brief XOR hash move constructor
+         * @param [in/out] mv Hash to be moved from
+         */
+        xorHash(xorHash&& mv) noexcept:hash(std::move(mv)){}
+        /** @brief XOR hash copy assignment
+         * @param [in] cpy Hash to be copied
+         * @return Reference to this
+         */
+        xorHash& operator=(const xorHash& cpy){hash::operator=(cpy);return *this;}
+        /** @brief XOR hash move assignment
+         * @param [in/out] mv Hash to be moved from
+         * @return Reference to this
+         */
+        xorHash& operator=(xorHash&& mv) noexcept{hash::operator=(std::move(mv));return *this;}
         /** @brief Binds a data-set
          *
          * Preforms the hash algorithm on the
@@ -31,8 +31,9 @@ using namespace crypto;
     {
         _numDef=numDef;
         _size = 1;
-        _data = new uint32_t[1];
+        _data = _allocate(1);
         _data[0]=0;
+        _used.store(0,std::memory_order_relaxed);
     }
     //Size constructor
     number::number(uint16_t size, struct numberType* numDef)
@@ -41,8 +42,9 @@ using namespace crypto;
         _size=size;
         if(_size<1)_size=0;
         
-        _data = new uint32_t[_size];
+        _data = _allocate(_size);
         memset(_data,0,sizeof(uint32_t)*_size);
+        _used.store(0,std::memory_order_relaxed);
     }
     //Construct with data
     number::number(const uint32_t* d, uint16_t size, struct numberType* numDef)
@@ -51,38 +53,85 @@ using namespace crypto;
         _size=size;
         if(_size<1)_size=0;
         
-        _data = new uint32_t[_size];
+        _data = _allocate(_size);
         if(size<1)
             memset(_data,0,sizeof(uint32_t)*_size);
         else
             memcpy(_data, d, sizeof(uint32_t)*_size);
+        _used.store(standardUsedLength(_data,_size),std::memory_order_relaxed);
     }
     //Copy constructor
     number::number(const number& num)
     {
         _numDef=num._numDef;
         _size=num._size;
-        _data = new uint32_t[_size];
+        _data = _allocate(_size);
         memcpy(_data, num._data, sizeof(uint32_t)*_size);
+        _used.store(num._used.load(std::memory_order_relaxed),std::memory_order_relaxed);
     }
 	//Copy number into self
 	number& number::operator=(const number& num)
 	{
 		if(&num!=this)
 		{
-			delete [] _data;
+			_release();
 			_numDef=num._numDef;
 			_size=num._size;
-			_data = new uint32_t[_size];
+			_data = _allocate(_size);
 			memcpy(_data, num._data, sizeof(uint32_t)*_size);
+			_used.store(num._used.load(std::memory_order_relaxed),std::memory_order_relaxed);
+		}
+		return *this;
+	}
+	//Move constructor
+	number::number(number&& num) noexcept
+	{
+		_take(num);
+	}
+	//Move number into self
+	number& number::operator=(number&& num) noexcept
+	{
+		if(&num!=this)
+		{
+			_release();
+			_take(num);
 		}
 		return *this;
 	}
     //Destructor
-    number::~number(){delete [] _data;}
+    number::~number(){_release();}
 
 //Size manipulation----------------------------------------------
 
+    //Inline storage if it fits, else heap
+    uint32_t* number::_allocate(uint16_t size)
+    {
+        if(size<=CRYPTO_NUMBER_INLINE_LIMBS) return _inline;
+        return new uint32_t[size];
+    }
+    //Free heap storage
+    void number::_release()
+    {
+        if(_data!=_inline) delete [] _data;
+    }
+    //Take another number's data
+    void number::_take(number& num)
+    {
+        _numDef=num._numDef;
+        _size=num._size;
+        _used.store(num._used.load(std::memory_order_relaxed),std::memory_order_relaxed);
+        if(num._data==num._inline)
+        {
+            _data=_inline;
+            memcpy(_inline,num._inline,sizeof(uint32_t)*_size);
+            return;
+        }
+        _data=num._data;
+        num._data=num._inline;
+        num._inline[0]=0;
+        num._size=1;
+        num._used.store(0,std::memory_order_relaxed);
+    }
     //Reduce the size of a number
     void number::reduce()
     {
@@ -92,10 +141,14 @@ using namespace crypto;
         targ_size++;
         if(targ_size==_size) return;
         
-        uint32_t* temp = new uint32_t[targ_size];
-        memcpy(temp, _data, sizeof(uint32_t)*targ_size);
-        delete [] _data;
-        _data =temp;
+        //Shrinking may move a heap array inline
+        uint32_t* temp = _allocate(targ_size);
+        if(temp!=_data)
+        {
+            memcpy(temp, _data, sizeof(uint32_t)*targ_size);
+            _release();
+            _data =temp;
+        }
         _size = targ_size;
     }
     //Expand the size of a number
@@ -109,14 +162,53 @@ using namespace crypto;
         }
         if(size==_size) return;
         
-        //Preform expansion
-        uint32_t* temp = new uint32_t[size];
-        memset(temp,0,sizeof(uint32_t)*size);
-        memcpy(temp, _data, sizeof(uint32_t)*_size);
-        delete [] _data;
-        _data =temp;
+        //Preform expansion, inline arrays grow in place
+        uint32_t* temp = _allocate(size);
+        if(temp!=_data)
+        {
+            memcpy(temp, _data, sizeof(uint32_t)*_size);
+            _release();
+            _data =temp;
+        }
+        memset(_data+_size,0,sizeof(uint32_t)*(size-_size));
         _size = size;
     }
+    //Elements in use
+    uint16_t number::usedSize() const
+    {
+        uint32_t used=_used.load(std::memory_order_relaxed);
+        if(used==USED_UNKNOWN)
+        {
+            used=standardUsedLength(_data,_size);
+            _used.store(used,std::memory_order_relaxed);
+        }
+        return (uint16_t)used;
+    }
+    //Operand workspace
+    struct numberScratch* number::_operandScratch(uint16_t len)
+    {
+        //Three operands, a double width product and the kernel workspace
+        struct numberScratch* scratch=numberScratchThread();
+        numberScratchReserve(scratch,NUMBER_SCRATCH_SIZE(len)+13*(uint32_t)len);
+        return scratch;
+    }
+    //Zero padded operand
+    uint32_t* number::_operandData(uint16_t len,struct numberScratch* scratch) const
+    {
+        if(len<=_size) return _data;
+        uint32_t* ret=numberScratchPush(scratch,len);
+        if(!ret) return NULL;
+        memset(ret,0,sizeof(uint32_t)*len);
+        memcpy(ret,_data,sizeof(uint32_t)*_size);
+        return ret;
+    }
+    //Clear and count a kernel result
+    void number::_finishResult(uint16_t len)
+    {
+        if(len<_size)
+            memset(_data+len,0,sizeof(uint32_t)*(_size-len));
+        _used.store(standardUsedLength(_data,len<_size?len:_size),std::memory_order_relaxed);
+    }
 
 //Get Data-------------------------------------------------------
 
@@ -173,7 +265,8 @@ using namespace crypto;
     {
         //Reset everything
         _size=1;
-        delete [] _data;
+        _used.store(USED_UNKNOWN,std::memory_order_relaxed);
+        _release();
         uint16_t totLen=1;
         int groupLen=0;
         
@@ -187,7 +280,7 @@ using namespace crypto;
                 if(groupLen>8)
                 {
                     cryptoerr<<"Illegal number construction string!"<<std::endl;
-                    _data=new uint32_t[_size];
+                    _data=_allocate(_size);
                     memset(_data,0,sizeof(uint32_t)*_size);
                     return;
                 }
@@ -202,7 +295,7 @@ using namespace crypto;
             else
             {
                 cryptoerr<<"Illegal number construction string!"<<std::endl;
-                _data=new uint32_t[_size];
+                _data=_allocate(_size);
                 memset(_data,0,sizeof(uint32_t)*_size);
                 return;
             }
@@ -210,7 +303,7 @@ using namespace crypto;
         
         //Build target array
         _size=totLen;
-        _data=new uint32_t[_size];
+        _data=_allocate(_size);
         memset(_data,0,sizeof(uint32_t)*_size);
         int strTrace = 0;
         for(uint16_t trc=_size;trc>0 && strTrace<str.length();trc--)
@@ -258,8 +351,10 @@ using namespace crypto;
 		if(pos>_size)
 		{
 			cryptoerr<<"Position "<<pos<<" is outside of the bounds of size "<<_size<<"!"<<std::endl;
+			_used.store(USED_UNKNOWN,std::memory_order_relaxed);
 			return _data[0];
 		}
+		_used.store(USED_UNKNOWN,std::memory_order_relaxed);
 		return _data[pos];
 	}
 
@@ -272,9 +367,8 @@ using namespace crypto;
         if(ret._size<op._size)
             ret.expand(op._size);
         
-        uint16_t i;
-        for(i=0;i<_size && i<op._size;++i)
-            ret._data[i]=_data[i]|op._data[i];
+        uint16_t i=_size<op._size?_size:op._size;
+        standardOr(_data,op._data,ret._data,i);
         while(i<_size)
         {
             ret._data[i]=_data[i];
@@ -285,6 +379,7 @@ using namespace crypto;
             ret._data[i]=op._data[i];
             ++i;
         }
+        ret._used.store(USED_UNKNOWN,std::memory_order_relaxed);
         
         return ret;
     }
@@ -293,8 +388,8 @@ using namespace crypto;
     {
         if(_size<op._size)
             expand(op._size);
-        for(uint16_t i=0;i<_size && i<op._size;++i)
-            _data[i]|=op._data[i];
+        standardOr(_data,op._data,_data,_size<op._size?_size:op._size);
+        _used.store(USED_UNKNOWN,std::memory_order_relaxed);
         return *this;
     }
     //AND operator
@@ -304,9 +399,8 @@ using namespace crypto;
         if(ret._size<op._size)
             ret.expand(op._size);
         
-        uint16_t i;
-        for(i=0;i<_size && i<op._size;++i)
-            ret._data[i]=_data[i]&op._data[i];
+        standardAnd(_data,op._data,ret._data,_size<op._size?_size:op._size);
+        ret._used.store(USED_UNKNOWN,std::memory_order_relaxed);
         
         return ret;
     }
@@ -315,14 +409,14 @@ using namespace crypto;
     {
         if(_size<op._size)
             expand(op._size);
-        uint16_t i;
-        for(i=0;i<_size && i<op._size;++i)
-            _data[i]&=op._data[i];
+        uint16_t i=_size<op._size?_size:op._size;
+        standardAnd(_data,op._data,_data,i);
         while(i<_size)
         {
             _data[i]=0;
             ++i;
         }
+        _used.store(USED_UNKNOWN,std::memory_order_relaxed);
         return *this;
     }
     //XOR operator
@@ -332,9 +426,8 @@ using namespace crypto;
         if(ret._size<op._size)
             ret.expand(op._size);
         
-        uint16_t i;
-        for(i=0;i<_size && i<op._size;++i)
-            ret._data[i]=_data[i]^op._data[i];
+        uint16_t i=_size<op._size?_size:op._size;
+        standardXor(_data,op._data,ret._data,i);
         while(i<_size)
         {
             ret._data[i]=_data[i];
@@ -345,6 +438,7 @@ using namespace crypto;
             ret._data[i]=op._data[i];
             ++i;
         }
+        ret._used.store(USED_UNKNOWN,std::memory_order_relaxed);
         
         return ret;
     }
@@ -353,16 +447,16 @@ using namespace crypto;
     {
         if(_size<op._size)
             expand(op._size);
-        for(uint16_t i=0;i<_size && i<op._size;++i)
-            _data[i]^=op._data[i];
+        standardXor(_data,op._data,_data,_size<op._size?_size:op._size);
+        _used.store(USED_UNKNOWN,std::memory_order_relaxed);
         return *this;
     }
     //Negate
     number number::operator~() const
     {
         number ret(*this);
-        for(uint16_t i=0;i<ret.size();++i)
-            ret._data[i]= ~ret._data[i];
+        standardNot(ret._data,ret._data,ret._size);
+        ret._used.store(USED_UNKNOWN,std::memory_order_relaxed);
         return ret;
     }
 
@@ -381,28 +475,20 @@ using namespace crypto;
             return ((long) this) - ((long) n2);
         }
         
-        //See if sizes need to be rectified
-        if(_size==n2->_size)
-            return _numDef->compare(_data,n2->_data,_size);
+        //Only compare the elements in use
+        uint16_t len=usedSize();
+        if(n2->usedSize()>len) len=n2->usedSize();
+        if(len<1) return 0;
+        struct numberScratch* scratch=_operandScratch(len);
+        uint32_t mark=scratch->used;
+        uint32_t* d1=_operandData(len,scratch);
+        uint32_t* d2=n2->_operandData(len,scratch);
         
-        //Rectify sizes
-        const number* tn1=this;
-        const number* tn2=n2;
-        number temp;
-        if(tn1->_size>tn2->_size)
-        {
-            temp=number(tn2->_data,tn2->_size);
-            temp.expand(_size);
-            tn2=&temp;
-        }
-        else
-        {
-            temp=number(_data,_size);
-            temp.expand(tn2->_size);
-            tn1=&temp;
-        }
+        int ret=(d1 && d2)?_numDef->compare(d1,d2,len):0;
         
-        return _numDef->compare(tn1->_data,tn2->_data,_size);
+        //Release padded operands
+        scratch->used=mark;
+        return ret;
     }
     //Addition function
     void number::addition(const number* n2, number* result) const
@@ -420,36 +506,30 @@ using namespace crypto;
         int targ_size=_size;
         if(n2->_size>targ_size) targ_size=n2->_size;
         if(result->_size>targ_size) targ_size=result->_size;
-        result->expand(targ_size);
-        uint32_t* d1=_data;
-        uint32_t* d2=n2->_data;
         
-        //Build temp hold values
-        if(targ_size>_size)
-        {
-            d1=new uint32_t[targ_size];
-            memset(d1,0,sizeof(uint32_t)*targ_size);
-            memcpy(d1, _data, sizeof(uint32_t)*_size);
-        }
-        if(targ_size>n2->_size)
-        {
-            d2=new uint32_t[targ_size];
-            memset(d2,0,sizeof(uint32_t)*targ_size);
-            memcpy(d2, n2->_data, sizeof(uint32_t)*n2->_size);
-        }
+        //Elements in use, plus one for the carry
+        uint16_t len=usedSize();
+        if(n2->usedSize()>len) len=n2->usedSize();
+        if(len<targ_size) len++;
+        
+        result->expand(targ_size);
+        struct numberScratch* scratch=_operandScratch(len);
+        uint32_t mark=scratch->used;
+        uint32_t* d1=_operandData(len,scratch);
+        uint32_t* d2=n2->_operandData(len,scratch);
         
         bool good=true;
-        good = _numDef->addition(d1,d2,result->_data,targ_size);
+        good = d1 && d2 && _numDef->addition(d1,d2,result->_data,len);
         
-        //Delete temp hold values (if we need to)
-        if(targ_size>_size) delete [] d1;
-        if(targ_size>n2->_size) delete [] d2;
+        //Release padded operands
+        scratch->used=mark;
         
         if(!good)
         {
             cryptoerr<<"Addition error!"<<std::endl;
             *result=integer();
         }
+        else result->_finishResult(len);
         
         return;
     }
@@ -469,36 +549,30 @@ using namespace crypto;
         int targ_size=_size;
         if(n2->_size>targ_size) targ_size=n2->_size;
         if(result->_size>targ_size) targ_size=result->_size;
-        result->expand(targ_size);
-        uint32_t* d1=_data;
-        uint32_t* d2=n2->_data;
         
-        //Build temp hold values
-        if(targ_size>_size)
-        {
-            d1=new uint32_t[targ_size];
-            memset(d1,0,sizeof(uint32_t)*targ_size);
-            memcpy(d1, _data, sizeof(uint32_t)*_size);
-        }
-        if(targ_size>n2->_size)
-        {
-            d2=new uint32_t[targ_size];
-            memset(d2,0,sizeof(uint32_t)*targ_size);
-            memcpy(d2, n2->_data, sizeof(uint32_t)*n2->_size);
-        }
+        //Elements in use
+        uint16_t len=usedSize();
+        if(n2->usedSize()>len) len=n2->usedSize();
+        if(len<1) len=1;
+        
+        result->expand(targ_size);
+        struct numberScratch* scratch=_operandScratch(len);
+        uint32_t mark=scratch->used;
+        uint32_t* d1=_operandData(len,scratch);
+        uint32_t* d2=n2->_operandData(len,scratch);
         
         bool good=true;
-        good = _numDef->subtraction(d1,d2,result->_data,targ_size);
+        good = d1 && d2 && _numDef->subtraction(d1,d2,result->_data,len);
         
-        //Delete temp hold values (if we need to)
-        if(targ_size>_size) delete [] d1;
-        if(targ_size>n2->_size) delete [] d2;
+        //Release padded operands
+        scratch->used=mark;
         
         if(!good)
         {
             cryptoerr<<"Subtraction error!"<<std::endl;
             *result=integer();
         }
+        else result->_finishResult(len);
         
         return;
     }
@@ -516,27 +590,27 @@ using namespace crypto;
         //Resize and return result
         int targ_size=_size;
         if(result->_size>targ_size) targ_size=result->_size;
-        result->expand(targ_size);
-        uint32_t* d1=_data;
         
-        //Build temp hold values
-        if(targ_size>_size)
-        {
-            d1=new uint32_t[targ_size];
-            memset(d1,0,sizeof(uint32_t)*targ_size);
-            memcpy(d1, _data, sizeof(uint32_t)*_size);
-        }
+        //Elements in use
+        uint16_t len=usedSize();
+        if(len<1) len=1;
+        
+        result->expand(targ_size);
+        struct numberScratch* scratch=_operandScratch(len);
+        uint32_t mark=scratch->used;
+        uint32_t* d1=_operandData(len,scratch);
         
-        bool good = _numDef->rightShift(d1,n2,result->_data,targ_size);
+        bool good = d1 && _numDef->rightShift(d1,n2,result->_data,len);
         
-        //Delete temp hold values (if we need to)
-        if(targ_size>_size) delete [] d1;
+        //Release padded operands
+        scratch->used=mark;
         
         if(!good)
         {
             cryptoerr<<"Right shift error!"<<std::endl;
             *result=integer();
         }
+        else result->_finishResult(len);
         
         return;
     }
@@ -554,27 +628,29 @@ using namespace crypto;
         //Resize and return result
         int targ_size=_size;
         if(result->_size>targ_size) targ_size=result->_size;
-        result->expand(targ_size);
-        uint32_t* d1=_data;
         
-        //Build temp hold values
-        if(targ_size>_size)
-        {
-            d1=new uint32_t[targ_size];
-            memset(d1,0,sizeof(uint32_t)*targ_size);
-            memcpy(d1, _data, sizeof(uint32_t)*_size);
-        }
+        //Elements in use, plus those the shift moves into
+        uint32_t len=usedSize();
+        if(len>0) len+=n2/32+1;
+        if(len>(uint32_t)targ_size) len=targ_size;
+        if(len<1) len=1;
+        
+        result->expand(targ_size);
+        struct numberScratch* scratch=_operandScratch((uint16_t)len);
+        uint32_t mark=scratch->used;
+        uint32_t* d1=_operandData((uint16_t)len,scratch);
         
-        bool good = _numDef->leftShift(d1,n2,result->_data,targ_size);
+        bool good = d1 && _numDef->leftShift(d1,n2,result->_data,(uint16_t)len);
         
-        //Delete temp hold values (if we need to)
-        if(targ_size>_size) delete [] d1;
+        //Release padded operands
+        scratch->used=mark;
         
         if(!good)
         {
             cryptoerr<<"Left shift error!"<<std::endl;
             *result=integer();
         }
+        else result->_finishResult((uint16_t)len);
         
         return;
     }
@@ -594,34 +670,52 @@ using namespace crypto;
         int targ_size=_size;
         if(n2->_size>targ_size) targ_size=n2->_size;
         if(result->_size>targ_size) targ_size=result->_size;
+        
+        //The product uses at most the sum of the elements in use
+        uint16_t used1=usedSize();
+        uint16_t used2=n2->usedSize();
+        uint32_t used=(uint32_t)used1+used2;
+        
         result->expand(targ_size);
-        uint32_t* d1=_data;
-        uint32_t* d2=n2->_data;
+        bool good=true;
         
-        //Build temp hold values
-        if(targ_size>_size)
+        //Product wider than the operands, grow the result to fit
+        if(used>(uint32_t)targ_size && used<=0xFFFF && hasMultiplicationFull())
         {
-            d1=new uint32_t[targ_size];
-            memset(d1,0,sizeof(uint32_t)*targ_size);
-            memcpy(d1, _data, sizeof(uint32_t)*_size);
+            uint16_t len=used1>used2?used1:used2;
+            struct numberScratch* scratch=_operandScratch(len);
+            uint32_t mark=scratch->used;
+            uint32_t* d1=_operandData(len,scratch);
+            uint32_t* d2=n2->_operandData(len,scratch);
+            uint32_t* prod=numberScratchPush(scratch,2*len);
+            good = d1 && d2 && prod && _numDef->multiplicationFull(d1,d2,prod,len);
+            result->expand((uint16_t)used);
+            if(good) memcpy(result->_data,prod,sizeof(uint32_t)*used);
+            scratch->used=mark;
+            if(good) result->_finishResult((uint16_t)used);
         }
-        if(targ_size>n2->_size)
+        else
         {
-            d2=new uint32_t[targ_size];
-            memset(d2,0,sizeof(uint32_t)*targ_size);
-            memcpy(d2, n2->_data, sizeof(uint32_t)*n2->_size);
+            uint16_t len=used<(uint32_t)targ_size?(uint16_t)used:targ_size;
+            if(len<1) len=1;
+            struct numberScratch* scratch=_operandScratch(len);
+            uint32_t mark=scratch->used;
+            uint32_t* d1=_operandData(len,scratch);
+            uint32_t* d2=n2->_operandData(len,scratch);
+            
+            if(n2==this && hasSquare())
+                good = d1 && _numDef->square(d1,result->_data,len);
+            else
+                good = d1 && d2 && _numDef->multiplication(d1,d2,result->_data,len);
+            
+            //Release padded operands
+            scratch->used=mark;
+            if(good) result->_finishResult(len);
         }
         
-        bool good=true;
-        good = _numDef->multiplication(d1,d2,result->_data,targ_size);
-        
-        //Delete temp hold values (if we need to)
-        if(targ_size>_size) delete [] d1;
-        if(targ_size>n2->_size) delete [] d2;
-        
         if(!good)
         {
-            cryptoerr<<"Exponentiation error!"<<std::endl;
+            cryptoerr<<"Multiplication error!"<<std::endl;
             *result=integer();
         }
     }
@@ -641,36 +735,30 @@ using namespace crypto;
         int targ_size=_size;
         if(n2->_size>targ_size) targ_size=n2->_size;
         if(result->_size>targ_size) targ_size=result->_size;
-        result->expand(targ_size);
-        uint32_t* d1=_data;
-        uint32_t* d2=n2->_data;
         
-        //Build temp hold values
-        if(targ_size>_size)
-        {
-            d1=new uint32_t[targ_size];
-            memset(d1,0,sizeof(uint32_t)*targ_size);
-            memcpy(d1, _data, sizeof(uint32_t)*_size);
-        }
-        if(targ_size>n2->_size)
-        {
-            d2=new uint32_t[targ_size];
-            memset(d2,0,sizeof(uint32_t)*targ_size);
-            memcpy(d2, n2->_data, sizeof(uint32_t)*n2->_size);
-        }
+        //Elements in use
+        uint16_t len=usedSize();
+        if(n2->usedSize()>len) len=n2->usedSize();
+        if(len<1) len=1;
+        
+        result->expand(targ_size);
+        struct numberScratch* scratch=_operandScratch(len);
+        uint32_t mark=scratch->used;
+        uint32_t* d1=_operandData(len,scratch);
+        uint32_t* d2=n2->_operandData(len,scratch);
         
         bool good=true;
-        good = _numDef->division(d1,d2,result->_data,targ_size);
+        good = d1 && d2 && _numDef->division(d1,d2,result->_data,len);
         
-        //Delete temp hold values (if we need to)
-        if(targ_size>_size) delete [] d1;
-        if(targ_size>n2->_size) delete [] d2;
+        //Release padded operands
+        scratch->used=mark;
         
         if(!good)
         {
             cryptoerr<<"Division error!"<<std::endl;
             *result=integer();
         }
+        else result->_finishResult(len);
         
         return;
     }
@@ -690,36 +778,30 @@ using namespace crypto;
         int targ_size=_size;
         if(n2->_size>targ_size) targ_size=n2->_size;
         if(result->_size>targ_size) targ_size=result->_size;
-        result->expand(targ_size);
-        uint32_t* d1=_data;
-        uint32_t* d2=n2->_data;
         
-        //Build temp hold values
-        if(targ_size>_size)
-        {
-            d1=new uint32_t[targ_size];
-            memset(d1,0,sizeof(uint32_t)*targ_size);
-            memcpy(d1, _data, sizeof(uint32_t)*_size);
-        }
-        if(targ_size>n2->_size)
-        {
-            d2=new uint32_t[targ_size];
-            memset(d2,0,sizeof(uint32_t)*targ_size);
-            memcpy(d2, n2->_data, sizeof(uint32_t)*n2->_size);
-        }
+        //Elements in use
+        uint16_t len=usedSize();
+        if(n2->usedSize()>len) len=n2->usedSize();
+        if(len<1) len=1;
+        
+        result->expand(targ_size);
+        struct numberScratch* scratch=_operandScratch(len);
+        uint32_t mark=scratch->used;
+        uint32_t* d1=_operandData(len,scratch);
+        uint32_t* d2=n2->_operandData(len,scratch);
         
         bool good=true;
-        good = _numDef->modulo(d1,d2,result->_data,targ_size);
+        good = d1 && d2 && _numDef->modulo(d1,d2,result->_data,len);
         
-        //Delete temp hold values (if we need to)
-        if(targ_size>_size) delete [] d1;
-        if(targ_size>n2->_size) delete [] d2;
+        //Release padded operands
+        scratch->used=mark;
         
         if(!good)
         {
             cryptoerr<<"Modulo error!"<<std::endl;
             *result=integer();
         }
+        else result->_finishResult(len);
         
         return;
     }
@@ -739,36 +821,28 @@ using namespace crypto;
         int targ_size=_size;
         if(n2->_size>targ_size) targ_size=n2->_size;
         if(result->_size>targ_size) targ_size=result->_size;
-        result->expand(targ_size);
-        uint32_t* d1=_data;
-        uint32_t* d2=n2->_data;
         
-        //Build temp hold values
-        if(targ_size>_size)
-        {
-            d1=new uint32_t[targ_size];
-            memset(d1,0,sizeof(uint32_t)*targ_size);
-            memcpy(d1, _data, sizeof(uint32_t)*_size);
-        }
-        if(targ_size>n2->_size)
-        {
-            d2=new uint32_t[targ_size];
-            memset(d2,0,sizeof(uint32_t)*targ_size);
-            memcpy(d2, n2->_data, sizeof(uint32_t)*n2->_size);
-        }
+        //The result may fill the whole size
+        uint16_t len=targ_size;
+        
+        result->expand(targ_size);
+        struct numberScratch* scratch=_operandScratch(len);
+        uint32_t mark=scratch->used;
+        uint32_t* d1=_operandData(len,scratch);
+        uint32_t* d2=n2->_operandData(len,scratch);
         
         bool good=true;
-        good = _numDef->exponentiation(d1,d2,result->_data,targ_size);
+        good = d1 && d2 && _numDef->exponentiation(d1,d2,result->_data,len);
         
-        //Delete temp hold values (if we need to)
-        if(targ_size>_size) delete [] d1;
-        if(targ_size>n2->_size) delete [] d2;
+        //Release padded operands
+        scratch->used=mark;
         
         if(!good)
         {
             cryptoerr<<"Exponentiation error!"<<std::endl;
             *result=integer();
         }
+        else result->_finishResult(len);
         
         return;
     }
@@ -789,47 +863,75 @@ using namespace crypto;
         if(n2->_size>targ_size) targ_size=n2->_size;
         if(n3->_size>targ_size) targ_size=n3->_size;
         if(result->_size>targ_size) targ_size=result->_size;
-        result->expand(targ_size);
-        uint32_t* d1=_data;
-        uint32_t* d2=n2->_data;
-        uint32_t* d3=n3->_data;
         
-        //Build temp hold values
-        if(targ_size>_size)
-        {
-            d1=new uint32_t[targ_size];
-            memset(d1,0,sizeof(uint32_t)*targ_size);
-            memcpy(d1, _data, sizeof(uint32_t)*_size);
-        }
-        if(targ_size>n2->_size)
-        {
-            d2=new uint32_t[targ_size];
-            memset(d2,0,sizeof(uint32_t)*targ_size);
-            memcpy(d2, n2->_data, sizeof(uint32_t)*n2->_size);
-        }
-        if(targ_size>n3->_size)
-        {
-            d3=new uint32_t[targ_size];
-            memset(d3,0,sizeof(uint32_t)*targ_size);
-            memcpy(d3, n3->_data, sizeof(uint32_t)*n3->_size);
-        }
+        //Elements in use
+        uint16_t len=usedSize();
+        if(n2->usedSize()>len) len=n2->usedSize();
+        if(n3->usedSize()>len) len=n3->usedSize();
+        if(len<1) len=1;
+        
+        result->expand(targ_size);
+        struct numberScratch* scratch=_operandScratch(len);
+        uint32_t mark=scratch->used;
+        uint32_t* d1=_operandData(len,scratch);
+        uint32_t* d2=n2->_operandData(len,scratch);
+        uint32_t* d3=n3->_operandData(len,scratch);
         
         bool good=true;
-        good = _numDef->moduloExponentiation(d1,d2,d3,result->_data,targ_size);
+        good = d1 && d2 && d3 && _numDef->moduloExponentiation(d1,d2,d3,result->_data,len);
         
-        //Delete temp hold values (if we need to)
-        if(targ_size>_size) delete [] d1;
-        if(targ_size>n2->_size) delete [] d2;
-        if(targ_size>n3->_size) delete [] d3;
+        //Release padded operands
+        scratch->used=mark;
         
         if(!good)
         {
             cryptoerr<<"Mod exponentiation error!"<<std::endl;
             *result=integer();
         }
+        else result->_finishResult(len);
         
         return;
     }
+    //Word exponent mod exponentiation
+    void number::moduloExponentiation(uint32_t n2, const number* n3, number* result) const
+    {
+        //Check if our function is even defined
+        if(!hasModuloExponentiationWord()||n3==NULL)
+        {
+            if(!hasModuloExponentiationWord()) cryptoerr<<"Called word mod exponentiation when no word mod exponentiation function exists!"<<std::endl;
+            else cryptoerr<<"Called word mod exponentiation with NULL n3!"<<std::endl;
+            *result=integer();
+            return;
+        }
+
+        //Resize and return result
+        int targ_size=_size;
+        if(n3->_size>targ_size) targ_size=n3->_size;
+        if(result->_size>targ_size) targ_size=result->_size;
+
+        //Elements in use
+        uint16_t len=usedSize();
+        if(n3->usedSize()>len) len=n3->usedSize();
+        if(len<1) len=1;
+
+        result->expand(targ_size);
+        struct numberScratch* scratch=_operandScratch(len);
+        uint32_t mark=scratch->used;
+        uint32_t* d1=_operandData(len,scratch);
+        uint32_t* d3=n3->_operandData(len,scratch);
+
+        bool good = d1 && d3 && _numDef->moduloExponentiationWord(d1,n2,d3,result->_data,len);
+
+        //Release padded operands
+        scratch->used=mark;
+
+        if(!good)
+        {
+            cryptoerr<<"Mod exponentiation error!"<<std::endl;
+            *result=integer();
+        }
+        else result->_finishResult(len);
+    }
     //Preform GCD operation
     void number::gcd(const number* n2,number* result) const
     {
@@ -846,36 +948,30 @@ using namespace crypto;
         int targ_size=_size;
         if(n2->_size>targ_size) targ_size=n2->_size;
         if(result->_size>targ_size) targ_size=result->_size;
-        result->expand(targ_size);
-        uint32_t* d1=_data;
-        uint32_t* d2=n2->_data;
         
-        //Build temp hold values
-        if(targ_size>_size)
-        {
-            d1=new uint32_t[targ_size];
-            memset(d1,0,sizeof(uint32_t)*targ_size);
-            memcpy(d1, _data, sizeof(uint32_t)*_size);
-        }
-        if(targ_size>n2->_size)
-        {
-            d2=new uint32_t[targ_size];
-            memset(d2,0,sizeof(uint32_t)*targ_size);
-            memcpy(d2, n2->_data, sizeof(uint32_t)*n2->_size);
-        }
+        //Elements in use
+        uint16_t len=usedSize();
+        if(n2->usedSize()>len) len=n2->usedSize();
+        if(len<1) len=1;
+        
+        result->expand(targ_size);
+        struct numberScratch* scratch=_operandScratch(len);
+        uint32_t mark=scratch->used;
+        uint32_t* d1=_operandData(len,scratch);
+        uint32_t* d2=n2->_operandData(len,scratch);
         
         bool good=true;
-        good = _numDef->gcd(d1,d2,result->_data,targ_size);
+        good = d1 && d2 && _numDef->gcd(d1,d2,result->_data,len);
         
-        //Delete temp hold values (if we need to)
-        if(targ_size>_size) delete [] d1;
-        if(targ_size>n2->_size) delete [] d2;
+        //Release padded operands
+        scratch->used=mark;
         
         if(!good)
         {
             cryptoerr<<"GCD error!"<<std::endl;
             *result=integer();
         }
+        else result->_finishResult(len);
         
         return;
     }
@@ -895,64 +991,173 @@ using namespace crypto;
         int targ_size=_size;
         if(n2->_size>targ_size) targ_size=n2->_size;
         if(result->_size>targ_size) targ_size=result->_size;
+        
+        //Elements in use
+        uint16_t len=usedSize();
+        if(n2->usedSize()>len) len=n2->usedSize();
+        if(len<1) len=1;
+        
         result->expand(targ_size);
-        uint32_t* d1=_data;
-        uint32_t* d2=n2->_data;
+        struct numberScratch* scratch=_operandScratch(len);
+        uint32_t mark=scratch->used;
+        uint32_t* d1=_operandData(len,scratch);
+        uint32_t* d2=n2->_operandData(len,scratch);
+        
+        bool good=true;
+        good = d1 && d2 && _numDef->modInverse(d1,d2,result->_data,len);
         
-        //Build temp hold values
-        if(targ_size>_size)
+        //Release padded operands
+        scratch->used=mark;
+        
+        if(!good)
         {
-            d1=new uint32_t[targ_size];
-            memset(d1,0,sizeof(uint32_t)*targ_size);
-            memcpy(d1, _data, sizeof(uint32_t)*_size);
+            cryptoerr<<"Modulo Inverse error!"<<std::endl;
+            *result=integer();
         }
-        if(targ_size>n2->_size)
+        else result->_finishResult(len);
+        
+        return;
+    }
+    //Word addition
+    void number::additionWord(uint32_t n2, number* result) const
+    {
+        //Check if our function is even defined
+        if(!hasAddWord())
         {
-            d2=new uint32_t[targ_size];
-            memset(d2,0,sizeof(uint32_t)*targ_size);
-            memcpy(d2, n2->_data, sizeof(uint32_t)*n2->_size);
+            cryptoerr<<"Called word addition when no word addition function exists!"<<std::endl;
+            *result=integer();
+            return;
         }
         
-        bool good=true;
-        good = _numDef->modInverse(d1,d2,result->_data,targ_size);
+        //Resize and return result
+        int targ_size=_size;
+        if(result->_size>targ_size) targ_size=result->_size;
+        
+        //Elements in use, plus one for the carry
+        uint16_t len=usedSize();
+        if(len<targ_size) len++;
+        
+        result->expand(targ_size);
+        struct numberScratch* scratch=_operandScratch(len);
+        uint32_t mark=scratch->used;
+        uint32_t* d1=_operandData(len,scratch);
+        
+        bool good = d1 && _numDef->addWord(d1,n2,result->_data,len);
         
-        //Delete temp hold values (if we need to)
-        if(targ_size>_size) delete [] d1;
-        if(targ_size>n2->_size) delete [] d2;
+        //Release padded operands
+        scratch->used=mark;
         
         if(!good)
         {
-            cryptoerr<<"Modulo Inverse error!"<<std::endl;
+            cryptoerr<<"Word addition error!"<<std::endl;
             *result=integer();
         }
+        else result->_finishResult(len);
+    }
+    //Word multiplication
+    void number::multiplicationWord(uint32_t n2, number* result) const
+    {
+        //Check if our function is even defined
+        if(!hasMulWord())
+        {
+            cryptoerr<<"Called word multiplication when no word multiplication function exists!"<<std::endl;
+            *result=integer();
+            return;
+        }
         
-        return;
+        //Resize and return result
+        int targ_size=_size;
+        if(result->_size>targ_size) targ_size=result->_size;
+        
+        //Elements in use, plus one for the carry, grow to fit
+        uint32_t len=(uint32_t)usedSize()+1;
+        if(len>(uint32_t)targ_size && len<=0xFFFF) targ_size=len;
+        if(len>(uint32_t)targ_size) len=targ_size;
+        
+        result->expand(targ_size);
+        struct numberScratch* scratch=_operandScratch((uint16_t)len);
+        uint32_t mark=scratch->used;
+        uint32_t* d1=_operandData((uint16_t)len,scratch);
+        
+        bool good = d1 && _numDef->mulWord(d1,n2,result->_data,(uint16_t)len);
+        
+        //Release padded operands
+        scratch->used=mark;
+        
+        if(!good)
+        {
+            cryptoerr<<"Word multiplication error!"<<std::endl;
+            *result=integer();
+        }
+        else result->_finishResult((uint16_t)len);
     }
-
-//Comparison functions-------------------------------------------
-
-    //Compare two numbers
-    int number::_compare(const number& n2) const
+    //Word division
+    void number::divisionWord(uint32_t n2, number* result, uint32_t* remainder) const
     {
-        uint16_t comp_len=_size;
+        //Check if our function is even defined
+        if(!hasDivmodWord())
+        {
+            cryptoerr<<"Called word division when no word division function exists!"<<std::endl;
+            *result=integer();
+            return;
+        }
+        
+        //Resize and return result
+        int targ_size=_size;
+        if(result->_size>targ_size) targ_size=result->_size;
+        
+        //Elements in use
+        uint16_t len=usedSize();
+        if(len<1) len=1;
         
-        //Size mis-matches
-        if(_size>n2._size)
+        result->expand(targ_size);
+        struct numberScratch* scratch=_operandScratch(len);
+        uint32_t mark=scratch->used;
+        uint32_t* d1=_operandData(len,scratch);
+        
+        bool good = d1 && _numDef->divmodWord(d1,n2,result->_data,remainder,len);
+        
+        //Release padded operands
+        scratch->used=mark;
+        
+        if(!good)
         {
-            comp_len=n2._size;
-            for(uint16_t trc=_size;trc>comp_len;trc--)
-            {
-                if(_data[trc-1]>0) return 1;
-            }
+            cryptoerr<<"Word division error!"<<std::endl;
+            *result=integer();
         }
-        else if(_size<n2._size)
+        else result->_finishResult(len);
+    }
+    //Word modulo
+    uint32_t number::moduloWord(uint32_t n2) const
+    {
+        //Check if our function is even defined
+        if(!hasModWord())
         {
-            for(uint16_t trc=n2._size;trc>comp_len;trc--)
-            {
-                if(n2._data[trc-1]>0) return -1;
-            }
+            cryptoerr<<"Called word modulo when no word modulo function exists!"<<std::endl;
+            return 0;
         }
         
+        uint32_t ret=0;
+        uint16_t len=usedSize();
+        if(len<1) return 0;
+        if(!_numDef->modWord(_data,n2,&ret,len))
+        {
+            cryptoerr<<"Word modulo error!"<<std::endl;
+            return 0;
+        }
+        return ret;
+    }
+
+//Comparison functions-------------------------------------------
+
+    //Compare two numbers
+    int number::_compare(const number& n2) const
+    {
+        //More elements in use is larger
+        uint16_t comp_len=usedSize();
+        if(comp_len>n2.usedSize()) return 1;
+        if(comp_len<n2.usedSize()) return -1;
+        
         //Matched size
         for(uint16_t trc=comp_len;trc>0;trc--)
         {
@@ -979,16 +1184,21 @@ using namespace crypto;
  ================================================================*/
 
     //Static
-    integer integer::one()
+    const integer& integer::zero()
     {
-        integer ret;
-        ret[0]=1;
+        static const integer ret;
         return ret;
     }
-	integer integer::two()
+    const integer& integer::one()
+    {
+        static const uint32_t val=1;
+        static const integer ret(&val,1);
+        return ret;
+    }
+	const integer& integer::two()
 	{
-        integer ret;
-        ret[0]=2;
+        static const uint32_t val=2;
+        static const integer ret(&val,1);
         return ret;
     }
     //Basic integer constructor
@@ -997,8 +1207,21 @@ using namespace crypto;
     integer::integer(uint16_t size):number(size,buildBaseTenType()){}
     //Data constructor
     integer::integer(const uint32_t* d, uint16_t size):number(d,size,buildBaseTenType()){}
+    //Typed size constructor
+    integer::integer(uint16_t size, struct numberType* numDef):number(size,numDef){}
     //Copy constructor
     integer::integer(const integer& num):number(num){}
+    integer::integer(integer&& num) noexcept:number(std::move(num)){}
+    integer& integer::operator=(const integer& num)
+    {
+        number::operator=(num);
+        return *this;
+    }
+    integer& integer::operator=(integer&& num) noexcept
+    {
+        number::operator=(std::move(num));
+        return *this;
+    }
 
     //Checks type
     bool integer::checkType() const
@@ -1014,19 +1237,41 @@ using namespace crypto;
         if(!hasMultiplication()) return false;
         if(!hasDivision()) return false;
         if(!hasModulo()) return false;
+        if(!hasMultiplicationFull()) return false;
+        if(!hasModuloFull()) return false;
+        if(!hasAddWord()) return false;
+        if(!hasMulWord()) return false;
+        if(!hasDivmodWord()) return false;
+        if(!hasModWord()) return false;
         if(!hasExponentiation()) return false;
         if(!hasModuloExponentiation()) return false;
+        if(!hasModuloExponentiationWord()) return false;
         if(!hasGCD()) return false;
         if(!hasModInverse()) return false;
         return true;
     }
+    //Integer type definitions
+    struct numberType* integer::typeDefinition(int typeID)
+    {
+        if(typeID==numberType::Base10) return buildBaseTenType();
+        if(typeID==numberType::Base10x64) return buildBaseTen64Type();
+        return NULL;
+    }
+    //Convert type
+    bool integer::convertType(int typeID)
+    {
+        struct numberType* numDef=typeDefinition(typeID);
+        if(!numDef) return false;
+        _numDef=numDef;
+        return true;
+    }
 
 //Operators--------------------------------------------------------
 
     //Addition operators
     integer integer::operator+(const integer& n) const
     {
-        integer ret(_size);
+        integer ret(_size,_numDef);
         addition(&n,&ret);
         return ret;
     }
@@ -1035,21 +1280,32 @@ using namespace crypto;
         addition(&n,this);
         return *this;
     }
+    integer integer::operator+(uint32_t n) const
+    {
+        integer ret(_size,_numDef);
+        additionWord(n,&ret);
+        return ret;
+    }
+    integer& integer::operator+=(uint32_t n)
+    {
+        additionWord(n,this);
+        return *this;
+    }
     integer& integer::operator++()
     {
-        *this+=integer::one();
+        additionWord(1,this);
         return *this;
     }
     integer integer::operator++(int dummy)
     {
         integer ret(*this);
-        *this+=integer::one();
+        additionWord(1,this);
         return ret;
     }
     //Subtraction operators
     integer integer::operator-(const integer& n) const
     {
-        integer ret(_size);
+        integer ret(_size,_numDef);
         subtraction(&n,&ret);
         return ret;
     }
@@ -1072,20 +1328,20 @@ using namespace crypto;
     //Shift operators
     integer integer::operator>>(unsigned n) const
     {
-        integer ret(_size);
+        integer ret(_size,_numDef);
         rightShift(n,&ret);
         return ret;
     }
     integer integer::operator<<(unsigned n) const
     {
-        integer ret(_size);
+        integer ret(_size,_numDef);
         leftShift(n,&ret);
         return ret;
     }
     //Multiplication operators
     integer integer::operator*(const integer& n) const
     {
-        integer ret(_size);
+        integer ret(_size,_numDef);
         multiplication(&n,&ret);
         return ret;
     }
@@ -1094,10 +1350,21 @@ using namespace crypto;
         multiplication(&n,this);
         return *this;
     }
+    integer integer::operator*(uint32_t n) const
+    {
+        integer ret(_size,_numDef);
+        multiplicationWord(n,&ret);
+        return ret;
+    }
+    integer& integer::operator*=(uint32_t n)
+    {
+        multiplicationWord(n,this);
+        return *this;
+    }
     //Division operators
     integer integer::operator/(const integer& n) const
     {
-        integer ret(_size);
+        integer ret(_size,_numDef);
         division(&n,&ret);
         return ret;
     }
@@ -1106,10 +1373,21 @@ using namespace crypto;
         division(&n,this);
         return *this;
     }
+    integer integer::operator/(uint32_t n) const
+    {
+        integer ret(_size,_numDef);
+        divisionWord(n,&ret);
+        return ret;
+    }
+    integer& integer::operator/=(uint32_t n)
+    {
+        divisionWord(n,this);
+        return *this;
+    }
     //Modulo operators
     integer integer::operator%(const integer& n) const
     {
-        integer ret(_size);
+        integer ret(_size,_numDef);
         modulo(&n,&ret);
         return ret;
     }
@@ -1118,10 +1396,14 @@ using namespace crypto;
         modulo(&n,this);
         return *this;
     }
+    uint32_t integer::operator%(uint32_t n) const
+    {
+        return moduloWord(n);
+    }
     //Exponentiation operators
     integer integer::exponentiation(const integer& n) const
     {
-        integer ret(_size);
+        integer ret(_size,_numDef);
         number::exponentiation(&n,&ret);
         return ret;
     }
@@ -1133,7 +1415,7 @@ using namespace crypto;
     //Modulo exponentiation operators
     integer integer::moduloExponentiation(const integer& n, const integer& mod) const
     {
-        integer ret(_size);
+        integer ret(_size,_numDef);
         number::moduloExponentiation(&n,&mod,&ret);
         return ret;
     }
@@ -1142,10 +1424,16 @@ using namespace crypto;
         number::moduloExponentiation(&n,&mod,this);
         return *this;
     }
+    integer integer::moduloExponentiation(uint32_t n, const integer& mod) const
+    {
+        integer ret(_size,_numDef);
+        number::moduloExponentiation(n,&mod,&ret);
+        return ret;
+    }
     //GCD
     integer integer::gcd(const integer& n) const
     {
-        integer ret(_size);
+        integer ret(_size,_numDef);
         number::gcd(&n,&ret);
         return ret;
     }
@@ -1157,7 +1445,7 @@ using namespace crypto;
     //Mod inverse
     integer integer::modInverse(const integer& n) const
     {
-        integer ret(_size);
+        integer ret(_size,_numDef);
         number::modInverse(&n,&ret);
         return ret;
     }
@@ -1166,9 +1454,42 @@ using namespace crypto;
         number::modInverse(&n,this);
         return *this;
     }
+    //Operators on temporaries, reusing their storage
+    integer crypto::operator+(integer&& n1, const integer& n2)
+    {
+        n1+=n2;
+        return std::move(n1);
+    }
+    integer crypto::operator-(integer&& n1, const integer& n2)
+    {
+        n1-=n2;
+        return std::move(n1);
+    }
+    integer crypto::operator*(integer&& n1, const integer& n2)
+    {
+        n1*=n2;
+        return std::move(n1);
+    }
+    integer crypto::operator/(integer&& n1, const integer& n2)
+    {
+        n1/=n2;
+        return std::move(n1);
+    }
+    integer crypto::operator%(integer&& n1, const integer& n2)
+    {
+        n1%=n2;
+        return std::move(n1);
+    }
     //Prime testing
-    bool integer::prime(uint16_t testVal) const
+    bool integer::prime(uint16_t testVal,uint16_t mode) const
     {
+        if(mode==algo::primeBPSW)
+            return primeTestBPSW(_data,testVal,_size);
+        if(mode!=algo::primeMillerRabin)
+        {
+            cryptoerr<<"Unknown prime test algorithm!"<<std::endl;
+            return false;
+        }
         return primeTest(_data,testVal,_size);
     }
 
@@ -20,7 +20,20 @@
 #include "hexConversion.h"
 #include "cryptoConstants.h"
 #include "cryptoCHeaders.h"
+#include <atomic>
 #include <string>
+#include <utility>
+
+/** @brief Elements stored inside a number
+ *
+ * Numbers of up to this many uint32_t
+ * keep their data array inside the object
+ * and never allocate.  The default covers
+ * the product of two 2048-bit values.
+ */
+#ifndef CRYPTO_NUMBER_INLINE_LIMBS
+	#define CRYPTO_NUMBER_INLINE_LIMBS 128
+#endif
 
 namespace crypto
 {
@@ -62,9 +75,89 @@ namespace crypto
 		 */
         uint16_t _size;
 		/** @brief Data array
+		 *
+		 * Points to crypto::number::_inline when
+		 * crypto::number::_size is at most
+		 * CRYPTO_NUMBER_INLINE_LIMBS, otherwise
+		 * to a heap array.
 		 */
         uint32_t* _data;
+		/** @brief Inline data storage
+		 */
+        uint32_t _inline[CRYPTO_NUMBER_INLINE_LIMBS];
+		/** @brief Cached count of elements in use
+		 *
+		 * crypto::number::USED_UNKNOWN when the
+		 * data array may have been modified since
+		 * the count was last taken.  Atomic since
+		 * constant numbers shared between threads
+		 * fill in the count on first use.
+		 */
+        mutable std::atomic<uint32_t> _used;
+		/** @brief Marks crypto::number::_used as stale
+		 */
+        static const uint32_t USED_UNKNOWN=0xFFFFFFFF;
+
+		/** @brief Storage for a data array
+		 *
+		 * Returns crypto::number::_inline if size
+		 * elements fit, otherwise a new heap array.
+		 *
+		 * @param [in] size Number of elements required
+		 * @return Uninitialized array of size elements
+		 */
+        uint32_t* _allocate(uint16_t size);
+		/** @brief Free the data array
+		 *
+		 * Deletes crypto::number::_data if it
+		 * is not the inline storage.
+		 *
+		 * @return void
+		 */
+        void _release();
+		/** @brief Take the data of another number
+		 *
+		 * Steals the heap array of num, leaving num
+		 * as a one element zero, or copies its inline
+		 * data.  This number must not own a heap array.
+		 *
+		 * @param [in/out] num Number to take from
+		 * @return void
+		 */
+        void _take(number& num);
         
+		/** @brief Operand workspace
+		 *
+		 * Returns the workspace of this thread with
+		 * room for the padded operands and product of
+		 * an operation of length len, as well as for
+		 * the workspace of the kernel.  The caller
+		 * records scratch->used and restores it.
+		 *
+		 * @param [in] len Length of the operation
+		 * @return Workspace of this thread
+		 */
+        static struct numberScratch* _operandScratch(uint16_t len);
+		/** @brief Operand array of a given length
+		 *
+		 * Returns the data array if it holds at least
+		 * len elements, otherwise a zero padded copy
+		 * taken from the workspace.
+		 *
+		 * @param [in] len Number of elements required
+		 * @param [in/out] scratch Workspace from crypto::number::_operandScratch
+		 * @return Array of at least len elements, NULL if the workspace is full
+		 */
+        uint32_t* _operandData(uint16_t len,struct numberScratch* scratch) const;
+		/** @brief Complete a kernel result
+		 *
+		 * Clears the elements the kernel did not
+		 * write and records the elements in use.
+		 *
+		 * @param [in] len Number of elements written by the kernel
+		 * @return void
+		 */
+        void _finishResult(uint16_t len);
 		/** @brief Compares two numbers
 		 * @param [in] n2 Number to be compared against
 		 * @return 0 if equal, 1 if greater than, -1 if less than
@@ -95,6 +188,15 @@ namespace crypto
 		 * @return Reference to this
 		 */
 		number& operator=(const number& num);
+		/** @brief Move constructor
+		 * @param [in/out] num Number whose data is taken
+		 */
+        number(number&& num) noexcept;
+		/** @brief Move assignment
+		 * @param [in/out] num Number whose data is taken
+		 * @return Reference to this
+		 */
+		number& operator=(number&& num) noexcept;
 		/** @brief Virtual destructor
          *
          * Destructor must be virtual, if an object
@@ -246,7 +348,12 @@ namespace crypto
 		 * Preforms this*n2=result.  Note
 		 * that this function will only preform
 		 * the multiplication if the number definition
-		 * defines an multiplication function.
+		 * defines an multiplication function.  If n2
+		 * is this number, the square function is used
+		 * when it is defined.  When the product needs
+		 * more elements than the operands, the result
+		 * grows to fit it using the full width
+		 * multiplication function.
 		 *
 		 * @param [in] n2 Number to be multiplied
 		 * @param [out] result Result of multiplication
@@ -302,6 +409,20 @@ namespace crypto
 		 * @return void
 		 */
 		void moduloExponentiation(const number* n2, const number* n3, number* result) const;
+        /** @brief Word exponent modular exponentiation
+		 *
+		 * Preforms this^n2 %n3=result for a
+		 * single word exponent.  Note that this
+		 * function will only preform the modular
+		 * exponentiation if the number definition
+		 * defines a word modular exponentiation function.
+		 *
+		 * @param [in] n2 Exponent
+		 * @param [in] n3 Number defines modulo space
+		 * @param [out] result Result of exponentiation
+		 * @return void
+		 */
+		void moduloExponentiation(uint32_t n2, const number* n3, number* result) const;
         /** @brief Greatest-common-denominator function
 		 *
 		 * Preforms GCD of this and n2=result.  Note
@@ -326,6 +447,56 @@ namespace crypto
 		 * @return void
 		 */
 		void modInverse(const number* n2, number* result) const;
+        /** @brief Word addition function
+		 *
+		 * Preforms this+n2=result for a single
+		 * word n2.  Note that this function will
+		 * only preform the addition if the number
+		 * definition defines a word addition function.
+		 *
+		 * @param [in] n2 Word to be added
+		 * @param [out] result Result of addition
+		 * @return void
+		 */
+		void additionWord(uint32_t n2, number* result) const;
+        /** @brief Word multiplication function
+		 *
+		 * Preforms this*n2=result for a single
+		 * word n2.  Note that this function will
+		 * only preform the multiplication if the number
+		 * definition defines a word multiplication function.
+		 * The result grows by one element if the
+		 * product needs it.
+		 *
+		 * @param [in] n2 Word to be multiplied
+		 * @param [out] result Result of multiplication
+		 * @return void
+		 */
+		void multiplicationWord(uint32_t n2, number* result) const;
+        /** @brief Word division function
+		 *
+		 * Preforms this/n2=result for a single
+		 * word n2.  Note that this function will
+		 * only preform the division if the number
+		 * definition defines a word division function.
+		 *
+		 * @param [in] n2 Word to be divided by
+		 * @param [out] result Result of division
+		 * @param [out] remainder this%n2, ignored if NULL
+		 * @return void
+		 */
+		void divisionWord(uint32_t n2, number* result, uint32_t* remainder=NULL) const;
+        /** @brief Word modulo function
+		 *
+		 * Preforms this%n2 for a single word n2.
+		 * Note that this function will only preform
+		 * the modulo if the number definition defines
+		 * a word modulo function.
+		 *
+		 * @param [in] n2 Word defining modulo space
+		 * @return this%n2, 0 on error
+		 */
+		uint32_t moduloWord(uint32_t n2) const;
         
         /** @brief Or operator
 		 *
@@ -436,6 +607,10 @@ namespace crypto
 		 * @return crypto::number::_numDef->multiplication
 		 */
         inline bool hasMultiplication() const {return _numDef->multiplication;}
+		/** @brief Check for the 'square' function
+		 * @return crypto::number::_numDef->square
+		 */
+        inline bool hasSquare() const {return _numDef->square;}
 		/** @brief Check for the 'division' function
 		 * @return crypto::number::_numDef->division
 		 */
@@ -444,6 +619,30 @@ namespace crypto
 		 * @return crypto::number::_numDef->modulo
 		 */
         inline bool hasModulo() const {return _numDef->modulo;}
+		/** @brief Check for the 'multiplicationFull' function
+		 * @return crypto::number::_numDef->multiplicationFull
+		 */
+        inline bool hasMultiplicationFull() const {return _numDef->multiplicationFull;}
+		/** @brief Check for the 'moduloFull' function
+		 * @return crypto::number::_numDef->moduloFull
+		 */
+        inline bool hasModuloFull() const {return _numDef->moduloFull;}
+		/** @brief Check for the 'addWord' function
+		 * @return crypto::number::_numDef->addWord
+		 */
+        inline bool hasAddWord() const {return _numDef->addWord;}
+		/** @brief Check for the 'mulWord' function
+		 * @return crypto::number::_numDef->mulWord
+		 */
+        inline bool hasMulWord() const {return _numDef->mulWord;}
+		/** @brief Check for the 'divmodWord' function
+		 * @return crypto::number::_numDef->divmodWord
+		 */
+        inline bool hasDivmodWord() const {return _numDef->divmodWord;}
+		/** @brief Check for the 'modWord' function
+		 * @return crypto::number::_numDef->modWord
+		 */
+        inline bool hasModWord() const {return _numDef->modWord;}
 		/** @brief Check for the 'exponentiation' function
 		 * @return crypto::number::_numDef->exponentiation
 		 */
@@ -452,6 +651,10 @@ namespace crypto
 		 * @return crypto::number::_numDef->moduloExponentiation
 		 */
         inline bool hasModuloExponentiation() const {return _numDef->moduloExponentiation;}
+		/** @brief Check for the 'moduloExponentiationWord' function
+		 * @return crypto::number::_numDef->moduloExponentiationWord
+		 */
+        inline bool hasModuloExponentiationWord() const {return _numDef->moduloExponentiationWord;}
 		/** @brief Check for the 'gcd' function
 		 * @return crypto::number::_numDef->gcd
 		 */
@@ -465,10 +668,24 @@ namespace crypto
 		 * @return crypto::number::_size
 		 */
         uint16_t size() const{return _size;}
+		/** @brief Elements in use
+		 *
+		 * Number of elements up to and including
+		 * the highest non-zero element, 0 for zero.
+		 * Arithmetic only runs over these elements.
+		 *
+		 * @return Count of elements in use
+		 */
+        uint16_t usedSize() const;
 		/** @brief Data access
+		 *
+		 * The data may be modified through the
+		 * returned pointer, so the elements in use
+		 * are re-counted on the next operation.
+		 *
 		 * @return crypto::number::_data
 		 */
-        uint32_t* data() {return _data;}
+        uint32_t* data() {_used.store(USED_UNKNOWN,std::memory_order_relaxed);return _data;}
 		/** @brief Constant data access
 		 * @return crypto::number::_data
 		 */
@@ -503,18 +720,22 @@ namespace crypto
     class integer:public number
     {
     public:
-        /** @brief Constructs a '0' integer
+        /** @brief Shared '0' integer
+		 *
+		 * Built once, so repeated calls
+		 * do not allocate.
+		 *
 		 * @return 0
 		 */
-        static integer zero(){return integer();}
-		/** @brief Constructs a '1' integer
+        static const integer& zero();
+		/** @brief Shared '1' integer
 		 * @return 1
 		 */
-        static integer one();
-		/** @brief Constructs a '2' integer
+        static const integer& one();
+		/** @brief Shared '2' integer
 		 * @return 2
 		 */
-		static integer two();
+		static const integer& two();
         
 		/** @brief Default integer constructor
 		 */
@@ -528,10 +749,29 @@ namespace crypto
 		 * @param [in] size Size of array
 		 */
         integer(const uint32_t* d, uint16_t size);
+		/** @brief Construct integer with size and number type
+		 * @param [in] size Size integer is initialized with
+		 * @param [in] numDef Integer number definition
+		 */
+        integer(uint16_t size, struct numberType* numDef);
 		/** @brief Copy constructor
 		 * @param [in] num Integer used to construct this
 		 */
         integer(const integer& num);
+		/** @brief Move constructor
+		 * @param [in/out] num Integer whose data is taken
+		 */
+        integer(integer&& num) noexcept;
+		/** @brief Copy assignment
+		 * @param [in] num Integer to be copied
+		 * @return Reference to this
+		 */
+        integer& operator=(const integer& num);
+		/** @brief Move assignment
+		 * @param [in/out] num Integer whose data is taken
+		 * @return Reference to this
+		 */
+        integer& operator=(integer&& num) noexcept;
         /** @brief Virtual destructor
          *
          * Destructor must be virtual, if an object
@@ -544,12 +784,33 @@ namespace crypto
         /** @brief Check if the number is valid
 		 *
 		 * Checks to ensure that the number definition
-		 * for this object is the Base-10 type.  Ensure
+		 * for this object is a Base-10 type.  Ensure
 		 * that all basic mathematical operators are defined.
 		 *
 		 * @return true if valid type, else, false
 		 */
         bool checkType() const;
+        /** @brief Integer number definitions
+		 *
+		 * Maps a number ID to one of the integer
+		 * types, all of which share the base-10 storage.
+		 * Results of integer operators carry the type
+		 * of the left operand.
+		 *
+		 * @param [in] typeID crypto::numberType::Base10 or crypto::numberType::Base10x64
+		 * @return Number definition, NULL if typeID is not an integer type
+		 */
+        static struct numberType* typeDefinition(int typeID);
+        /** @brief Convert integer type
+		 *
+		 * Binds this integer to another integer
+		 * type.  The data is unchanged, only the
+		 * kernels used by the operators differ.
+		 *
+		 * @param [in] typeID Number ID of the new type
+		 * @return true if converted, false if typeID is not an integer type
+		 */
+        bool convertType(int typeID);
         
         /** @brief Integer addition operator
 		 * @param [in] n Integer to be added
@@ -561,6 +822,16 @@ namespace crypto
 		 * @reutrn this = this + n
 		 */
         integer& operator+=(const integer& n);
+		/** @brief Word addition operator
+		 * @param [in] n Word to be added
+		 * @reutrn this + n
+		 */
+		integer operator+(uint32_t n) const;
+		/** @brief Word addition equals operator
+		 * @param [in] n Word to be added
+		 * @reutrn this = this + n
+		 */
+        integer& operator+=(uint32_t n);
 		/** @brief Increment operator
 		 * @return ++this
 		 */
@@ -610,6 +881,16 @@ namespace crypto
 		 * @reutrn this = this * n
 		 */
         integer& operator*=(const integer& n);
+		/** @brief Word multiplication operator
+		 * @param [in] n Word to be multiplied
+		 * @reutrn this * n
+		 */
+        integer operator*(uint32_t n) const;
+		/** @brief Word multiplication equals operator
+		 * @param [in] n Word to be multiplied
+		 * @reutrn this = this * n
+		 */
+        integer& operator*=(uint32_t n);
         
 		/** @brief Integer division operator
 		 * @param [in] n Integer to be divided by
@@ -621,6 +902,16 @@ namespace crypto
 		 * @reutrn this = this / n
 		 */
         integer& operator/=(const integer& n);
+		/** @brief Word division operator
+		 * @param [in] n Word to be divided by
+		 * @reutrn this / n
+		 */
+        integer operator/(uint32_t n) const;
+		/** @brief Word division equals operator
+		 * @param [in] n Word to be divided by
+		 * @reutrn this = this / n
+		 */
+        integer& operator/=(uint32_t n);
         
 		/** @brief Integer modulo operator
 		 * @param [in] n Integer defining modulo space
@@ -632,6 +923,15 @@ namespace crypto
 		 * @reutrn this = this % n
 		 */
         integer& operator%=(const integer& n);
+		/** @brief Word modulo operator
+		 *
+		 * Reduces by a single word, returning
+		 * the remainder as a word.
+		 *
+		 * @param [in] n Word defining modulo space
+		 * @reutrn this % n
+		 */
+        uint32_t operator%(uint32_t n) const;
         
 		/** @brief Integer exponentiation function
 		 * @param [in] n Integer to be raised to
@@ -655,6 +955,16 @@ namespace crypto
 		 * @return this = this^n % mod
 		 */
         integer& moduloExponentiationEquals(const integer& n, const integer& mod);
+		/** @brief Integer word exponent modulo-exponentiation function
+		 *
+		 * Runs one squaring per exponent bit, suited
+		 * to short exponents such as the RSA public exponent.
+		 *
+		 * @param [in] n Exponent
+		 * @param [in] mod Integer representing modulo space
+		 * @return this^n % mod
+		 */
+        integer moduloExponentiation(uint32_t n, const integer& mod) const;
 		/** @brief Integer GCD function
 		 * @param [in] n Integer to be compared against
 		 * @return GCD of this and n
@@ -681,13 +991,53 @@ namespace crypto
 		 * Preforms a probabilistic prime test
 		 * on this number.  This operation can
 		 * be quite expensive, especially for
-		 * large numbers.
+		 * large numbers.  crypto::algo::primeMillerRabin
+		 * runs testVal Miller-Rabin rounds, while
+		 * crypto::algo::primeBPSW runs a Baillie-PSW
+		 * test followed by testVal random rounds.
 		 *
 		 * @param [in] testVal Number of test cycles, crytpo::algo::primeTestCycle by default
+		 * @param [in] mode Prime test algorithm, crypto::algo::primeMillerRabin by default
 		 * @return true if prime, else, false
 		 */
-        bool prime(uint16_t testVal=algo::primeTestCycle) const;
+        bool prime(uint16_t testVal=algo::primeTestCycle,uint16_t mode=algo::primeMillerRabin) const;
     };
+
+	/** @brief Addition of a temporary
+	 *
+	 * Adds n2 into the storage of n1, so chained
+	 * expressions such as (a*b)+c do not build
+	 * another result.
+	 *
+	 * @param [in/out] n1 Temporary integer
+	 * @param [in] n2 Integer to be added
+	 * @return n1 + n2
+	 */
+	integer operator+(integer&& n1, const integer& n2);
+	/** @brief Subtraction of a temporary
+	 * @param [in/out] n1 Temporary integer
+	 * @param [in] n2 Integer to be subtracted
+	 * @return n1 - n2
+	 */
+	integer operator-(integer&& n1, const integer& n2);
+	/** @brief Multiplication of a temporary
+	 * @param [in/out] n1 Temporary integer
+	 * @param [in] n2 Integer to be multiplied
+	 * @return n1 * n2
+	 */
+	integer operator*(integer&& n1, const integer& n2);
+	/** @brief Division of a temporary
+	 * @param [in/out] n1 Temporary integer
+	 * @param [in] n2 Integer to be divided by
+	 * @return n1 / n2
+	 */
+	integer operator/(integer&& n1, const integer& n2);
+	/** @brief Modulo of a temporary
+	 * @param [in/out] n1 Temporary integer
+	 * @param [in] n2 Integer defining modulo space
+	 * @return n1 % n2
+	 */
+	integer operator%(integer&& n1, const integer& n2);
 }
 
 #endif
@@ -19,6 +19,11 @@
 #include "cryptoPublicKey.h"
 #include "cryptoError.h"
 #include "binaryEncryption.h"
+#include "fixedInteger.h"
+#include "keyPool.h"
+#include <thread>
+#include <mutex>
+#include <vector>
 
 using namespace crypto;
 
@@ -221,13 +226,14 @@ using namespace crypto;
 		n=copyConvert(_n);
 		d=copyConvert(_d);
 		_timestamp=tms;
+		pruneContexts();
 	}
 
     //Static copy/convert
     os::smart_ptr<number> publicKey::copyConvert(const os::smart_ptr<number> num,uint16_t size)
     {
         os::smart_ptr<number> ret(new number(*num),os::shared_type);
-        ret->expand(size*2);
+        if(ret->size()<size) ret->expand(size);
         return ret;
     }
     //Static copy/convert
@@ -238,7 +244,7 @@ using namespace crypto;
 			ret=os::smart_ptr<number>(new number(),os::shared_type);
 		else
 			ret=os::smart_ptr<number>(new number(arr,(uint16_t)len),os::shared_type);
-        ret->expand(size*2);
+        if(ret->size()<size) ret->expand(size);
         return ret;
     }
     //Static copy/convert
@@ -292,6 +298,7 @@ using namespace crypto;
             oldD.remove(&oldD.last());
 		while(_timestamps.size()>_history)
             _timestamps.remove(&_timestamps.last());
+		pruneContexts();
         markChanged();
     }
     //Set the history length
@@ -307,10 +314,66 @@ using namespace crypto;
 				oldD.remove(&oldD.last());
 			while(_timestamps.size()>_history)
 				_timestamps.remove(&_timestamps.last());
+			pruneContexts();
         }
         _history=hist;
 		markChanged();
     }
+	//Drop contexts of keys no longer held
+	void publicKey::pruneContexts()
+	{
+		std::lock_guard<std::mutex> lock(_contextLock);
+		for(size_t i=0;i<_contexts.size();)
+		{
+			bool held=_contexts[i].source.get()==n.get();
+			for(auto trc=oldN.first();trc && !held;++trc)
+				held=_contexts[i].source.get()==(&trc).get();
+			if(held) ++i;
+			else _contexts.erase(_contexts.begin()+i);
+		}
+	}
+	//Build or find the context of a modulus
+	os::smart_ptr<modularContext> publicKey::keyContext(os::smart_ptr<number> mod) const
+	{
+		if(!mod || !integer::typeDefinition(mod->typeID())) return NULL;
+		std::lock_guard<std::mutex> lock(_contextLock);
+		for(size_t i=0;i<_contexts.size();++i)
+		{
+			if(_contexts[i].source.get()==mod.get())
+				return _contexts[i].context;
+		}
+		contextEntry entry;
+		entry.source=mod;
+		entry.context=modularContext::build(*os::cast<integer,number>(mod),_size);
+		_contexts.push_back(entry);
+		return entry.context;
+	}
+	//Old N without a copy
+	os::smart_ptr<number> publicKey::storedN(size_t history)
+	{
+		if(history==CURRENT_INDEX) return n;
+		readLock();
+		auto trc=oldN.first();
+		for(size_t i=0;i<history&&trc;++i)
+			++trc;
+		os::smart_ptr<number> ret;
+		if(trc) ret=&trc;
+		readUnlock();
+		return ret;
+	}
+	//Old D without a copy
+	os::smart_ptr<number> publicKey::storedD(size_t history)
+	{
+		if(history==CURRENT_INDEX) return d;
+		readLock();
+		auto trc=oldD.first();
+		for(size_t i=0;i<history&&trc;++i)
+			++trc;
+		os::smart_ptr<number> ret;
+		if(trc) ret=&trc;
+		readUnlock();
+		return ret;
+	}
 
 //Access and Generation----------------------------------------
 
@@ -377,6 +440,18 @@ using namespace crypto;
 		if(!trc) return NULL;
 		return *(&trc);
 	}
+	//Generate a new key, with result
+	std::shared_future<bool> publicKey::generateNewKeysAsync(os::smart_ptr<generationToken> token)
+	{
+		std::promise<bool> ret;
+		if(token && token->cancelled()) ret.set_value(false);
+		else
+		{
+			generateNewKeys();
+			ret.set_value(true);
+		}
+		return ret.get_future().share();
+	}
 	//Generate a new key
 	void publicKey::generateNewKeys()
 	{
@@ -387,8 +462,9 @@ using namespace crypto;
 		d=os::smart_ptr<number>(new number(),os::shared_type);
 		_timestamp=os::getTimestamp();
 
-		n->expand(2*_size);
-		d->expand(2*_size);
+		n->expand(_size);
+		d->expand(_size);
+		pruneContexts();
 		writeUnlock();
         
 		readLock();
@@ -444,9 +520,9 @@ using namespace crypto;
 		uint32_t ldval;
 		for(unsigned int i1=0;i1<2;i1++)
 		{
-			os::smart_ptr<number> t;
-			if(i1==0) t=n;
-			else t=d;
+			const number* t;
+			if(i1==0) t=n.get();
+			else t=d.get();
 			for(unsigned int i2=0;i2<_size;i2++)
 			{
 				ldval=os::to_comp_mode(t->data()[i2]);
@@ -464,7 +540,12 @@ using namespace crypto;
         }
 
         //Old n and d's
-        dumpVal=os::to_comp_mode((uint16_t)_history);
+		bool extended=extendedKeyData();
+		size_t dataLen=keyDataLength(extended);
+		uint16_t histVal=(uint16_t)_history;
+		if(dataLen>0) histVal|=KEY_DATA_FLAG;
+		if(dataLen>0 && extended) histVal|=KEY_DATA_EXTENDED_FLAG;
+        dumpVal=os::to_comp_mode(histVal);
         memcpy(dumpArray.get(),&dumpVal,2);
         ben->write(dumpArray.get(),2);
         if(!ben->good())
@@ -473,20 +554,38 @@ using namespace crypto;
             errorSaving("Write failed");
             throw errorPointer(new actionOnFileError(),os::shared_type);
         }
+
+		//Key data for the current pair
+		os::smart_ptr<unsigned char> dataArray;
+		if(dataLen>0)
+		{
+			dataArray=os::smart_ptr<unsigned char>(new unsigned char[dataLen],os::shared_type_array);
+			memset(dataArray.get(),0,dataLen);
+			writeKeyData(dataArray.get(),CURRENT_INDEX,extended);
+			ben->write(dataArray.get(),dataLen);
+			if(!ben->good())
+			{
+				readUnlock();
+				errorSaving("Write failed");
+				throw errorPointer(new actionOnFileError(),os::shared_type);
+			}
+		}
         
         auto ntrc=oldN.last();
         auto dtrc=oldD.last();
 		auto ttrc=_timestamps.last();
+		size_t histTrc=oldN.size();
         while(ntrc && dtrc && ttrc)
         {
+			histTrc--;
 			tsTemp=os::to_comp_mode(*ttrc);
 			ben->write((unsigned char*)&tsTemp,8);
 
             for(unsigned int i1=0;i1<2;i1++)
             {
-                os::smart_ptr<number> t;
-                if(i1==0) t=&ntrc;
-                else t=&dtrc;
+                const number* t;
+                if(i1==0) t=&(*ntrc);
+                else t=&(*dtrc);
                 for(unsigned int i2=0;i2<_size;i2++)
                 {
                     ldval=os::to_comp_mode(t->data()[i2]);
@@ -494,6 +593,12 @@ using namespace crypto;
                 }
             }
             ben->write(dumpArray.get(),2*4*_size);
+			if(dataLen>0)
+			{
+				memset(dataArray.get(),0,dataLen);
+				writeKeyData(dataArray.get(),histTrc,extended);
+				ben->write(dataArray.get(),dataLen);
+			}
             
             //Go to the next n and d
             if(!ben->good())
@@ -513,6 +618,7 @@ using namespace crypto;
     void publicKey::loadFile()
     {
 		writeLock();
+		clearKeyData();
         if(_fileName=="")
 		{
 			writeUnlock();
@@ -585,12 +691,30 @@ using namespace crypto;
             throw errorPointer(new actionOnFileError(),os::shared_type);
         }
         memcpy(&dumpVal,initArray,2);
-        _history=os::from_comp_mode(dumpVal);
+        dumpVal=os::from_comp_mode(dumpVal);
+		size_t dataLen=0;
+		bool extended=(dumpVal&KEY_DATA_EXTENDED_FLAG)!=0;
+		if(dumpVal&KEY_DATA_FLAG) dataLen=keyDataLength(extended);
+        _history=dumpVal&~(KEY_DATA_FLAG|KEY_DATA_EXTENDED_FLAG);
         if(_history>20)
         {
             writeUnlock();
             throw errorPointer(new customError("History Size","History size invalid, must be less than or equal to 20"),os::shared_type);
         }
+
+		//Key data for the current pair
+		os::smart_ptr<unsigned char> dataArray;
+		if(dataLen>0)
+		{
+			dataArray=os::smart_ptr<unsigned char>(new unsigned char[dataLen],os::shared_type_array);
+			bde->read(dataArray.get(),dataLen);
+			if(!bde->good())
+			{
+				writeUnlock();
+				throw errorPointer(new actionOnFileError(),os::shared_type);
+			}
+			readKeyData(dataArray.get(),CURRENT_INDEX,extended);
+		}
         
 		//Read in old n and d, oldest first
 		unsigned int numOlds=0;
@@ -619,6 +743,18 @@ using namespace crypto;
 				if(i1==0) oldN.insert(copyConvert(keyArray.get(),_size));
 				else oldD.insert(copyConvert(keyArray.get(),_size));
 			}
+
+			//Parse key data
+			if(dataLen>0)
+			{
+				bde->read(dataArray.get(),dataLen);
+				if(!bde->good())
+				{
+					writeUnlock();
+					throw errorPointer(new actionOnFileError(),os::shared_type);
+				}
+				readKeyData(dataArray.get(),numOlds,extended);
+			}
 			numOlds++;
 		}
 		writeUnlock();
@@ -683,7 +819,7 @@ using namespace crypto;
 	//Static raw encode
     void publicKey::encode(unsigned char* code, size_t codeLength, unsigned const char* publicN, size_t nLength, uint16_t size)
     {
-        os::smart_ptr<number> enc=publicKey::encode(publicKey::copyConvert(code,codeLength,size),publicKey::copyConvert(code,codeLength,size),size);
+        os::smart_ptr<number> enc=publicKey::encode(publicKey::copyConvert(code,codeLength,size),publicKey::copyConvert(publicN,nLength,size),size);
         size_t tLen;
 		auto tdat=enc->getCompCharData(tLen);
 		memset(code,0,codeLength);
@@ -739,10 +875,113 @@ using namespace crypto;
 		else memcpy(code,tdat.get(),tLen);
 	}
 
+//Batch encoding and decoding---------------------------------
+
+	//Static batch encode
+	std::vector<os::smart_ptr<number> > publicKey::encodeBatch(const std::vector<os::smart_ptr<number> >& codes, os::smart_ptr<number> publicN, uint16_t size)
+	{
+		std::vector<os::smart_ptr<number> > ret(codes.size());
+		workerPool::singleton()->parallelFor(codes.size(),[&](size_t i)
+		{
+			ret[i]=publicKey::encode(codes[i],publicN,size);
+		});
+		return ret;
+	}
+	//Static batch raw encode
+	void publicKey::encodeBatch(unsigned char* const* codes, size_t count, size_t codeLength, os::smart_ptr<number> publicN, uint16_t size)
+	{
+		workerPool::singleton()->parallelFor(count,[&](size_t i)
+		{
+			publicKey::encode(codes[i],codeLength,publicN,size);
+		});
+	}
+	//Batch encode
+	std::vector<os::smart_ptr<number> > publicKey::encodeBatch(const std::vector<os::smart_ptr<number> >& codes, os::smart_ptr<number> publicN) const
+	{
+		std::vector<os::smart_ptr<number> > ret(codes.size());
+		workerPool::singleton()->parallelFor(codes.size(),[&](size_t i)
+		{
+			ret[i]=encode(codes[i],publicN);
+		});
+		return ret;
+	}
+	//Batch raw encode
+	void publicKey::encodeBatch(unsigned char* const* codes, size_t count, size_t codeLength, os::smart_ptr<number> publicN) const
+	{
+		workerPool::singleton()->parallelFor(count,[&](size_t i)
+		{
+			encode(codes[i],codeLength,publicN);
+		});
+	}
+	//Batch decode
+	std::vector<os::smart_ptr<number> > publicKey::decodeBatch(const std::vector<os::smart_ptr<number> >& codes) const
+	{
+		std::vector<os::smart_ptr<number> > ret(codes.size());
+		workerPool::singleton()->parallelFor(codes.size(),[&](size_t i)
+		{
+			ret[i]=decode(codes[i]);
+		});
+		return ret;
+	}
+	//Old batch decode
+	std::vector<os::smart_ptr<number> > publicKey::decodeBatch(const std::vector<os::smart_ptr<number> >& codes, size_t hist)
+	{
+		std::vector<os::smart_ptr<number> > ret(codes.size());
+		workerPool::singleton()->parallelFor(codes.size(),[&](size_t i)
+		{
+			ret[i]=decode(codes[i],hist);
+		});
+		return ret;
+	}
+	//Batch raw decode
+	void publicKey::decodeBatch(unsigned char* const* codes, size_t count, size_t codeLength) const
+	{
+		workerPool::singleton()->parallelFor(count,[&](size_t i)
+		{
+			decode(codes[i],codeLength);
+		});
+	}
+	//Old batch raw decode
+	void publicKey::decodeBatch(unsigned char* const* codes, size_t count, size_t codeLength, size_t hist)
+	{
+		workerPool::singleton()->parallelFor(count,[&](size_t i)
+		{
+			decode(codes[i],codeLength,hist);
+		});
+	}
+
 /*------------------------------------------------------------
     RSA Public Key
  ------------------------------------------------------------*/
 
+	//Modular exponentiation on a cached context, general path without one
+	static integer rsaExponentiation(const integer& base,const integer& exp,const integer& mod,os::smart_ptr<modularContext> ctx)
+	{
+		if(!ctx) return base.moduloExponentiation(exp,mod);
+		integer ret;
+		ctx->exponentiation(base,exp.data(),exp.usedSize(),ret);
+		return ret;
+	}
+	//Word exponent modular exponentiation on a cached context
+	static integer rsaExponentiation(const integer& base,uint32_t exp,const integer& mod,os::smart_ptr<modularContext> ctx)
+	{
+		if(!ctx) return base.moduloExponentiation(exp,mod);
+		integer ret;
+		ctx->exponentiation(base,&exp,1,ret);
+		return ret;
+	}
+	//Public exponent encode against a modulus and its context
+	static os::smart_ptr<number> rsaEncode(os::smart_ptr<number> code,os::smart_ptr<number> publicN,os::smart_ptr<modularContext> ctx)
+	{
+		if(*code > *publicN)
+			throw errorPointer(new publicKeySizeWrong(), os::shared_type);
+		if(!integer::typeDefinition(code->typeID()) || !integer::typeDefinition(publicN->typeID()))
+			throw errorPointer(new illegalAlgorithmBind("Base10"),os::shared_type);
+		integer val(*os::cast<integer,number>(code));
+		val.convertType(publicRSA::integerType());
+		return os::smart_ptr<number> (new integer(rsaExponentiation(val,publicRSA::PUBLIC_EXPONENT,*os::cast<integer,number>(publicN),ctx)),os::shared_type);
+	}
+
     //Default constructor
     publicRSA::publicRSA(uint16_t sz):
         publicKey(algo::publicRSA,sz)
@@ -750,6 +989,13 @@ using namespace crypto;
         initE();
         generateNewKeys();
     }
+	//Optionally generate
+	publicRSA::publicRSA(uint16_t sz,bool generate):
+		publicKey(algo::publicRSA,sz)
+	{
+		initE();
+		if(generate) generateNewKeys();
+	}
     //Copy constructor
     publicRSA::publicRSA(publicRSA& ky):
         publicKey(ky)
@@ -770,6 +1016,11 @@ using namespace crypto;
         for(auto trc=ky._timestamps.last();trc;--trc)
 			_timestamps.insert(&trc);
 
+		//Copy CRT parameters
+		crt=ky.crt;
+		for(auto trc=ky.oldCRT.last();trc;--trc)
+			oldCRT.insert(&trc);
+
         markChanged();
     }
     //N, D constructor
@@ -805,28 +1056,168 @@ using namespace crypto;
         initE();
         loadFile();
     }
+	//Stop generating into this key
+	publicRSA::~publicRSA()
+	{
+		readLock();
+		os::smart_ptr<RSAKeyGenerator> gen=keyGen;
+		readUnlock();
+		if(!gen) return;
+
+		gen->stop();
+		if(gen->start()) gen->abandon();
+		else gen->result().wait();
+	}
     //Init the "e" variable
     void publicRSA::initE()
     {
-        e=(integer::one()<<(unsigned)16)+integer::one();
+        e=integer();
+        e[0]=PUBLIC_EXPONENT;
     }
 
+//History and key data----------------------------------------
+
+	//Push the old keys, with CRT parameters
+	void publicRSA::pushOldKeys(os::smart_ptr<number> n, os::smart_ptr<number> d,uint64_t ts)
+	{
+		os::smart_ptr<RSACRTParameters> oldVal=crt;
+		crt=NULL;
+		if(!n || !d) return;
+		if(history()==0) return;
+
+		if(!oldVal) oldVal=os::smart_ptr<RSACRTParameters>(new RSACRTParameters(),os::shared_type);
+		oldCRT.insert(oldVal);
+		while(oldCRT.size()>history())
+			oldCRT.remove(&oldCRT.last());
+		publicKey::pushOldKeys(n,d,ts);
+	}
+	//Five numbers per key pair, three more for each further prime
+	size_t publicRSA::keyDataLength(bool extended) const
+	{
+		if(extended) return (5+3*(MAX_PRIMES-2))*4*size();
+		return 5*4*size();
+	}
+	//Any multi-prime pair
+	bool publicRSA::extendedKeyData() const
+	{
+		if(crt && crt->primes()>2) return true;
+		for(auto trc=oldCRT.first();trc;++trc)
+		{
+			if(trc->primes()>2) return true;
+		}
+		return false;
+	}
+	//Write CRT parameters
+	void publicRSA::writeKeyData(unsigned char* arr,size_t hist,bool extended) const
+	{
+		os::smart_ptr<RSACRTParameters> val;
+		if(hist==CURRENT_INDEX) val=crt;
+		else
+		{
+			auto trc=oldCRT.first();
+			for(size_t i=0;i<hist&&trc;++i)
+				++trc;
+			if(trc) val=&trc;
+		}
+		if(!val || !val->valid()) return;
+
+		const integer* nums[5+3*(MAX_PRIMES-2)]={&val->p,&val->q,&val->dP,&val->dQ,&val->qInv};
+		unsigned int count=5;
+		if(extended)
+		{
+			for(size_t i=0;i<val->otherPrimes.size() && i<MAX_PRIMES-2;++i)
+			{
+				nums[count++]=&val->otherPrimes[i].prime;
+				nums[count++]=&val->otherPrimes[i].exponent;
+				nums[count++]=&val->otherPrimes[i].coefficient;
+			}
+		}
+		uint32_t ldval;
+		for(unsigned int i1=0;i1<count;i1++)
+		{
+			for(unsigned int i2=0;i2<size() && i2<nums[i1]->size();i2++)
+			{
+				ldval=os::to_comp_mode(nums[i1]->data()[i2]);
+				memcpy(arr+i1*4*size()+i2*4,&ldval,4);
+			}
+		}
+	}
+	//Read CRT parameters
+	void publicRSA::readKeyData(const unsigned char* arr,size_t hist,bool extended)
+	{
+		unsigned int count=5;
+		if(extended) count+=3*(MAX_PRIMES-2);
+		os::smart_ptr<number> nums[5+3*(MAX_PRIMES-2)];
+		for(unsigned int i1=0;i1<count;i1++)
+			nums[i1]=copyConvert(arr+i1*4*size(),4*size());
+
+		os::smart_ptr<RSACRTParameters> val(new RSACRTParameters(*os::cast<integer,number>(nums[0]),
+			*os::cast<integer,number>(nums[1]),
+			*os::cast<integer,number>(nums[2]),
+			*os::cast<integer,number>(nums[3]),
+			*os::cast<integer,number>(nums[4])),os::shared_type);
+
+		//Unused prime slots are zero
+		for(unsigned int i1=5;i1<count && val->valid();i1+=3)
+		{
+			if(nums[i1]->usedSize()==0) break;
+			val->addPrime(*os::cast<integer,number>(nums[i1]),
+				*os::cast<integer,number>(nums[i1+1]),
+				*os::cast<integer,number>(nums[i1+2]));
+		}
+
+		if(hist==CURRENT_INDEX)
+		{
+			if(val->valid()) crt=val;
+			else crt=NULL;
+		}
+		else oldCRT.insert(val);
+	}
+	//Drop CRT parameters
+	void publicRSA::clearKeyData()
+	{
+		crt=NULL;
+		while(oldCRT.size()>0)
+			oldCRT.remove(&oldCRT.first());
+	}
+	//Return CRT parameters
+	os::smart_ptr<RSACRTParameters> publicRSA::getCRT(size_t history)
+	{
+		if(history==CURRENT_INDEX) return crt;
+		if(history>=oldCRT.size()) return NULL;
+
+		readLock();
+		auto trc=oldCRT.first();
+		for(unsigned int i=0;i<history&&trc;++i)
+		{
+			++trc;
+		}
+		readUnlock();
+
+		if(!trc || !trc->valid()) return NULL;
+		return &trc;
+	}
+
     //Static copy/convert
     os::smart_ptr<number> publicRSA::copyConvert(const os::smart_ptr<number> num,uint16_t size)
     {
-        os::smart_ptr<number> ret(new integer(num->data(),num->size()),os::shared_type);
-        ret->expand(size*2);
+        integer* val=new integer(((const number*)num.get())->data(),num->size());
+        val->convertType(integerType());
+        os::smart_ptr<number> ret(val,os::shared_type);
+        if(ret->size()<size) ret->expand(size);
         return ret;
     }
     //Static copy/convert
     os::smart_ptr<number> publicRSA::copyConvert(const uint32_t* arr,size_t len,uint16_t size)
     {
-        os::smart_ptr<number> ret;
+        integer* val;
 		if(arr==NULL)
-			ret=os::smart_ptr<number>(new integer(),os::shared_type);
+			val=new integer();
 		else
-			ret=os::smart_ptr<number>(new integer(arr,(uint16_t)len),os::shared_type);
-        ret->expand(size*2);
+			val=new integer(arr,(uint16_t)len);
+        val->convertType(integerType());
+        os::smart_ptr<number> ret(val,os::shared_type);
+        if(ret->size()<size) ret->expand(size);
         return ret;
     }
     //Static copy/convert
@@ -856,12 +1247,11 @@ using namespace crypto;
     //Static encode
     os::smart_ptr<number> publicRSA::encode(os::smart_ptr<number> code, os::smart_ptr<number> publicN, uint16_t size)
     {
-        if(*code > *publicN)
-            throw errorPointer(new publicKeySizeWrong(), os::shared_type);
-        if(code->typeID()!=numberType::Base10 || publicN->typeID()!=numberType::Base10)
-            throw errorPointer(new illegalAlgorithmBind("Base10"),os::shared_type);
-        integer e((integer::one()<<(unsigned)16)+integer::one());
-        return os::smart_ptr<number> (new integer(os::cast<integer,number>(code)->moduloExponentiation(e, *os::cast<integer,number>(publicN))),os::shared_type);
+		//Unknown modulus, build a context for this call only
+		os::smart_ptr<modularContext> ctx;
+		if(integer::typeDefinition(publicN->typeID()))
+			ctx=modularContext::build(*os::cast<integer,number>(publicN),size);
+		return rsaEncode(code,publicN,ctx);
 	}
     //Static hybrid encode
 	void publicRSA::encode(unsigned char* code, size_t codeLength, os::smart_ptr<number> publicN, uint16_t size)
@@ -876,7 +1266,7 @@ using namespace crypto;
 	//Static raw encode
     void publicRSA::encode(unsigned char* code, size_t codeLength, unsigned const char* publicN, size_t nLength, uint16_t size)
     {
-        os::smart_ptr<number> enc=publicRSA::encode(publicRSA::copyConvert(code,codeLength,size),publicRSA::copyConvert(code,codeLength,size),size);
+        os::smart_ptr<number> enc=publicRSA::encode(publicRSA::copyConvert(code,codeLength,size),publicRSA::copyConvert(publicN,nLength,size),size);
         size_t tLen;
 		auto tdat=enc->getCompCharData(tLen);
 		memset(code,0,codeLength);
@@ -884,17 +1274,52 @@ using namespace crypto;
 		else memcpy(code,tdat.get(),tLen);
     }
 
+	//Static batch encode, one context for the batch
+	std::vector<os::smart_ptr<number> > publicRSA::encodeBatch(const std::vector<os::smart_ptr<number> >& codes, os::smart_ptr<number> publicN, uint16_t size)
+	{
+		os::smart_ptr<modularContext> ctx;
+		if(integer::typeDefinition(publicN->typeID()))
+			ctx=modularContext::build(*os::cast<integer,number>(publicN),size);
+		std::vector<os::smart_ptr<number> > ret(codes.size());
+		workerPool::singleton()->parallelFor(codes.size(),[&](size_t i)
+		{
+			ret[i]=rsaEncode(codes[i],publicN,ctx);
+		});
+		return ret;
+	}
+	//Static batch raw encode, one context for the batch
+	void publicRSA::encodeBatch(unsigned char* const* codes, size_t count, size_t codeLength, os::smart_ptr<number> publicN, uint16_t size)
+	{
+		os::smart_ptr<modularContext> ctx;
+		if(integer::typeDefinition(publicN->typeID()))
+			ctx=modularContext::build(*os::cast<integer,number>(publicN),size);
+		workerPool::singleton()->parallelFor(count,[&](size_t i)
+		{
+			os::smart_ptr<number> enc=rsaEncode(publicRSA::copyConvert(codes[i],codeLength,size),publicN,ctx);
+			size_t tLen;
+			auto tdat=enc->getCompCharData(tLen);
+			memset(codes[i],0,codeLength);
+			if(tLen>codeLength) memcpy(codes[i],tdat.get(),codeLength);
+			else memcpy(codes[i],tdat.get(),tLen);
+		});
+	}
+
     //Encode key
     os::smart_ptr<number> publicRSA::encode(os::smart_ptr<number> code, os::smart_ptr<number> publicN) const
     {
         if(!publicN) publicN=n;
-        return publicRSA::encode(code,publicN,size());
+		if(publicN.get()!=n.get()) return publicRSA::encode(code,publicN,size());
+		return rsaEncode(code,publicN,keyContext(publicN));
     }
     //Hybrid encode
 	void publicRSA::encode(unsigned char* code, size_t codeLength, os::smart_ptr<number> publicN) const
 	{
-		if(!publicN) publicN=n;
-		publicRSA::encode(code,codeLength,publicN,size());
+		os::smart_ptr<number> enc=encode(copyConvert(code,codeLength),publicN);
+		size_t tLen;
+		auto tdat=enc->getCompCharData(tLen);
+		memset(code,0,codeLength);
+		if(tLen>codeLength) memcpy(code,tdat.get(),codeLength);
+		else memcpy(code,tdat.get(),tLen);
 	}
 	//Raw encode
     void publicRSA::encode(unsigned char* code, size_t codeLength, unsigned const char* publicN, size_t nLength) const
@@ -903,64 +1328,260 @@ using namespace crypto;
     //Decode key
     os::smart_ptr<number> publicRSA::decode(os::smart_ptr<number> code) const
     {
-        if(code->typeID()!=numberType::Base10)
+        if(!integer::typeDefinition(code->typeID()))
             throw errorPointer(new illegalAlgorithmBind("Base10"),os::shared_type);
         publicKey::decode(code);
-        return os::smart_ptr<number>(new integer(os::cast<integer,number>(code)->moduloExponentiation(*os::cast<integer,number>(d), *os::cast<integer,number>(n))),os::shared_type);
+        integer typed(*os::cast<integer,number>(code));
+        typed.convertType(integerType());
+		os::smart_ptr<RSACRTParameters> val=crt;
+		if(val) return os::smart_ptr<number>(new integer(val->decode(typed)),os::shared_type);
+        return os::smart_ptr<number>(new integer(rsaExponentiation(typed,*os::cast<integer,number>(d),*os::cast<integer,number>(n),keyContext(n))),os::shared_type);
     }
 	//Old decode key
     os::smart_ptr<number> publicRSA::decode(os::smart_ptr<number> code, size_t hist)
     {
 		if(hist==CURRENT_INDEX)
 			return decode(code);
-        if(code->typeID()!=numberType::Base10)
+        if(!integer::typeDefinition(code->typeID()))
             throw errorPointer(new illegalAlgorithmBind("Base10"),os::shared_type);
-        os::smart_ptr<number> histN=getOldN(hist);
-		os::smart_ptr<number> histD=getOldD(hist);
-		if(!histN) throw errorPointer(new NULLPublicKey(),os::shared_type);
+        os::smart_ptr<number> histN=storedN(hist);
+		os::smart_ptr<number> histD=storedD(hist);
+		if(!histN || !histD) throw errorPointer(new NULLPublicKey(),os::shared_type);
 		if(*code > *histN) throw errorPointer(new publicKeySizeWrong(), os::shared_type);
 
-        return os::smart_ptr<number>(new integer(os::cast<integer,number>(code)->moduloExponentiation(*os::cast<integer,number>(histD), *os::cast<integer,number>(histN))),os::shared_type);
+		integer typed(*os::cast<integer,number>(code));
+		typed.convertType(integerType());
+		os::smart_ptr<RSACRTParameters> val=getCRT(hist);
+		if(val) return os::smart_ptr<number>(new integer(val->decode(typed)),os::shared_type);
+        return os::smart_ptr<number>(new integer(rsaExponentiation(typed,*os::cast<integer,number>(histD),*os::cast<integer,number>(histN),keyContext(histN))),os::shared_type);
     }
 
+/*------------------------------------------------------------
+    RSA CRT Parameters
+ ------------------------------------------------------------*/
+
+	//Construct from primes and private key
+	RSACRTParameters::RSACRTParameters(const integer& _p,const integer& _q,const integer& _d,uint16_t sz)
+	{
+		p=_p;
+		q=_q;
+		if(p.size()<sz) p.expand(sz);
+		if(q.size()<sz) q.expand(sz);
+
+		dP=_d%(p-integer::one());
+		dQ=_d%(q-integer::one());
+		qInv=q.modInverse(p);
+		pContext=modularContext::build(p,fixedIntegerLimbs(p.usedSize()));
+		qContext=modularContext::build(q,fixedIntegerLimbs(q.usedSize()));
+	}
+	//Construct from stored parameters
+	RSACRTParameters::RSACRTParameters(const integer& _p,const integer& _q,const integer& _dP,const integer& _dQ,const integer& _qInv)
+	{
+		p=_p;
+		q=_q;
+		dP=_dP;
+		dQ=_dQ;
+		qInv=_qInv;
+		pContext=modularContext::build(p,fixedIntegerLimbs(p.usedSize()));
+		qContext=modularContext::build(q,fixedIntegerLimbs(q.usedSize()));
+	}
+	//Compute exponent and coefficient of the next prime
+	void RSACRTParameters::addPrime(const integer& _r,const integer& _d)
+	{
+		integer product=p*q;
+		for(size_t i=0;i<otherPrimes.size();++i)
+			product*=otherPrimes[i].prime;
+		addPrime(_r,_d%(_r-integer::one()),(product%_r).modInverse(_r));
+	}
+	//Bind the next prime
+	void RSACRTParameters::addPrime(const integer& _r,const integer& _dR,const integer& _tR)
+	{
+		primeInfo info;
+		info.prime=_r;
+		info.exponent=_dR;
+		info.coefficient=_tR;
+		info.context=modularContext::build(_r,fixedIntegerLimbs(_r.usedSize()));
+		otherPrimes.push_back(std::move(info));
+	}
+	//Two primes plus the others
+	size_t RSACRTParameters::primes() const
+	{
+		if(!valid()) return 0;
+		return 2+otherPrimes.size();
+	}
+	//Check for both primes
+	bool RSACRTParameters::valid() const
+	{
+		return p!=integer(p.size()) && q!=integer(q.size());
+	}
+	//Garner's recombination
+	integer RSACRTParameters::decode(const integer& code) const
+	{
+		//Primes of a supported key size have cached contexts
+		integer m1=rsaExponentiation(code,dP,p,pContext);
+		integer m2=rsaExponentiation(code,dQ,q,qContext);
+
+		//h=qInv*(m1-m2) mod p, offset by p to stay positive
+		integer h=(m1+p)-(m2%p);
+		h=(h*qInv)%p;
+		integer ret=m2+h*q;
+
+		//Each further prime extends the result modulo the product so far
+		integer product=p*q;
+		for(size_t i=0;i<otherPrimes.size();++i)
+		{
+			const primeInfo& info=otherPrimes[i];
+			integer mi=rsaExponentiation(code,info.exponent,info.prime,info.context);
+			h=(mi+info.prime)-(ret%info.prime);
+			h=(h*info.coefficient)%info.prime;
+			ret+=h*product;
+			if(i+1<otherPrimes.size()) product*=info.prime;
+		}
+		return ret;
+	}
+
 /*------------------------------------------------------------
     RSA Public Key Generation
  ------------------------------------------------------------*/
 
 
 	//Basic constructor
-	RSAKeyGenerator::RSAKeyGenerator(publicRSA& m)
+	RSAKeyGenerator::RSAKeyGenerator(publicRSA& m,os::smart_ptr<generationToken> tk)
 	{
 		master=&m;
+		token=tk;
+		stopped=false;
+		started=false;
+		_result=promise.get_future().share();
+		smallPrimes=os::smart_ptr<uint16_t>(new uint16_t[SIEVE_BOUND/2],os::shared_type_array);
+		smallPrimeCount=base10SmallPrimes(smallPrimes.get(),SIEVE_BOUND/2,SIEVE_BOUND);
 	}
-	//Generate prime
-	integer RSAKeyGenerator::generatePrime()
+	//Primes for this key size
+	unsigned int RSAKeyGenerator::primeTarget() const
+	{
+		unsigned int count=publicRSA::primeCount();
+		unsigned int bound=publicRSA::maxPrimes(master->size());
+		if(count>bound) count=bound;
+		return count;
+	}
+	//Split the key between the primes
+	uint16_t RSAKeyGenerator::primeLength(unsigned int index,unsigned int count) const
+	{
+		uint16_t length=master->size()/count;
+		if(index<master->size()%count) length++;
+		return length;
+	}
+	//Random starting point
+	integer RSAKeyGenerator::randomCandidate(uint16_t length)
 	{
-		integer ret(2*master->size());
-		for(uint16_t i=0;i<master->size()/2;++i)
-			ret[i]=((uint32_t) rand())^(((uint32_t)rand())<<16);
+		integer ret(master->size());
+		if(!cryptoRandomFill(ret.data(),length*sizeof(uint32_t)))
+			throw errorPointer(new randomSeedError(),os::shared_type);
 		ret[0]=ret[0]|1;
-		ret[master->size()/2-1]^=1<<31;
-		while(!ret.prime())
-			ret+=integer::two();
+		//Top three bits, up to four primes multiply to the full key length
+		ret[length-1]|=(uint32_t)7<<29;
+		return ret;
+	}
+	//Search sieved intervals for a prime
+	bool RSAKeyGenerator::searchPrime(integer& candidate,const std::atomic<bool>* cancel)
+	{
+		os::smart_ptr<uint16_t> residues(new uint16_t[smallPrimeCount],os::shared_type_array);
+		os::smart_ptr<uint8_t> sieve(new uint8_t[SIEVE_WIDTH],os::shared_type_array);
+		base10SieveResidues(candidate.data(),candidate.size(),smallPrimes.get(),smallPrimeCount,residues.get());
+
+		while(true)
+		{
+			base10SieveInterval(residues.get(),smallPrimes.get(),smallPrimeCount,sieve.get(),SIEVE_WIDTH);
+			for(uint32_t i=0;i<SIEVE_WIDTH;++i)
+			{
+				if(sieve[i]) continue;
+				if((cancel && *cancel) || cancelled()) return false;
+
+				//e must be invertible mod test-1
+				integer test=candidate+(uint32_t)(2*i);
+				if(test%publicRSA::PUBLIC_EXPONENT==1) continue;
+				if(test.prime(0,algo::primeBPSW))
+				{
+					candidate=std::move(test);
+					return true;
+				}
+			}
+			candidate+=(uint32_t)(2*SIEVE_WIDTH);
+		}
+	}
+	//Generate prime
+	integer RSAKeyGenerator::generatePrime(uint16_t length)
+	{
+		integer ret=randomCandidate(length);
+		searchPrime(ret);
 		return ret;
 	}
+	//Search for every prime concurrently
+	bool RSAKeyGenerator::generatePrimes()
+	{
+		unsigned int count=primeTarget();
+		unsigned int threads=publicRSA::generationThreads();
+		primes.clear();
+		primes.resize(count);
+		std::vector<std::atomic<bool> > found(count);
+		for(unsigned int i=0;i<count;++i)
+			found[i]=false;
+
+		if(threads>=2)
+		{
+			//Draw every start before any search runs
+			std::vector<integer> starts;
+			for(unsigned int i=0;i<threads;++i)
+				starts.push_back(randomCandidate(primeLength(i%count,count)));
+
+			//Search i looks for prime i%count
+			std::mutex resultLock;
+			workerPool::singleton()->parallelFor(threads,[this,&starts,&found,&resultLock,count](size_t i)
+			{
+				if(!searchPrime(starts[i],&found[i%count])) return;
+
+				std::lock_guard<std::mutex> lock(resultLock);
+				if(found[i%count]) return;
+				primes[i%count]=std::move(starts[i]);
+				found[i%count]=true;
+			});
+		}
+
+		//Primes no search found, and repeats
+		for(unsigned int i=0;i<count;++i)
+		{
+			bool repeated=false;
+			do
+			{
+				if(cancelled()) return false;
+				if(!found[i] || repeated) primes[i]=generatePrime(primeLength(i,count));
+				found[i]=true;
+				repeated=false;
+				for(unsigned int j=0;j<i;++j)
+					repeated=repeated || primes[i]==primes[j];
+			} while(repeated);
+		}
+		return !cancelled();
+	}
 	//Push calculated values
 	void RSAKeyGenerator::pushValues()
 	{
-		master->writeLock();
-		if(master->n && master->d) master->pushOldKeys(master->n,master->d,master->_timestamp);
-
-		integer tn=p*q;
-		integer phi = (p-integer::one())*(q-integer::one());
-		phi.expand(2*master->size());
+		integer tn=primes[0]*primes[1];
+		integer phi = (primes[0]-integer::one())*(primes[1]-integer::one());
+		for(size_t i=2;i<primes.size();++i)
+		{
+			tn*=primes[i];
+			phi*=primes[i]-integer::one();
+		}
 		integer td = master->e.modInverse(phi);
 
-		master->n=os::smart_ptr<number>(new integer(tn),os::shared_type);
-		master->d=os::smart_ptr<number>(new integer(td),os::shared_type);
-		master->_timestamp=os::getTimestamp();
-        master->n->expand(2*master->size());
-		master->d->expand(2*master->size());
+		os::smart_ptr<RSACRTParameters> tcrt(new RSACRTParameters(primes[0],primes[1],td,master->size()),os::shared_type);
+		for(size_t i=2;i<primes.size();++i)
+			tcrt->addPrime(primes[i],td);
+
+		master->writeLock();
+		master->installKeys(os::smart_ptr<number>(new integer(std::move(tn)),os::shared_type),
+			os::smart_ptr<number>(new integer(std::move(td)),os::shared_type),tcrt);
                 
         publicRSA* temp=master;
         temp->keyGen=NULL;
@@ -971,36 +1592,161 @@ using namespace crypto;
 		temp->readUnlock();
 
         temp->markChanged();
+		promise.set_value(true);
+	}
+	//Finish without keys
+	void RSAKeyGenerator::abandon(std::exception_ptr error)
+	{
+		master->writeLock();
+		master->keyGen=NULL;
+		master->writeUnlock();
+		if(error) promise.set_exception(error);
+		else promise.set_value(false);
 	}
 	
 	//Key generation function
 	namespace crypto
 	{
-		//Basic key generation thread
-		void generateKeys(void* ptr)
+		//Basic key generation task
+		static void generateKeys(os::smart_ptr<RSAKeyGenerator> rkg)
 		{
-			RSAKeyGenerator* rkg=(RSAKeyGenerator*) ptr;
-			rkg->p=rkg->generatePrime();
-			rkg->q=rkg->generatePrime();
-			rkg->pushValues();
+			if(!rkg->start()) return;
+			bool found;
+			try{found=rkg->generatePrimes();}
+			catch(...)
+			{
+				rkg->abandon(std::current_exception());
+				return;
+			}
+			if(found) rkg->pushValues();
+			else rkg->abandon();
+		}
+		//Resolved generation result
+		static std::shared_future<bool> generationResult(bool val)
+		{
+			std::promise<bool> ret;
+			ret.set_value(val);
+			return ret.get_future().share();
 		}
 	}
 
 	//Generating keys
 	void publicRSA::generateNewKeys()
 	{
-		writeLock();
+		generateNewKeysAsync();
+	}
+	//Generating keys, with result
+	std::shared_future<bool> publicRSA::generateNewKeysAsync(os::smart_ptr<generationToken> token)
+	{
+		readLock();
+		if(keyGen)
+		{
+			std::shared_future<bool> ret=keyGen->result();
+			readUnlock();
+			return ret;
+		}
+		readUnlock();
+		if(token && token->cancelled())
+			return generationResult(false);
 
+		//Ready keys are taken unlocked, the pool may write its file
+		os::smart_ptr<publicRSA> pooled;
+		try{pooled=os::cast<publicRSA,publicKey>(keyPool::singleton()->take(algorithm(),size()));}
+		catch(errorPointer e){pooled=NULL;}
+
+		writeLock();
 		if(keyGen)
 		{
+			std::shared_future<bool> ret=keyGen->result();
+			writeUnlock();
+			return ret;
+		}
+		if(pooled)
+		{
+			installKeys(pooled->n,pooled->d,pooled->crt);
 			writeUnlock();
-			return;
+
+			readLock();
+			keyChangeSender::triggerEvent();
+			readUnlock();
+
+			markChanged();
+			return generationResult(true);
 		}
 
-        srand((unsigned)time(NULL));
-		keyGen=os::smart_ptr<RSAKeyGenerator>(new RSAKeyGenerator(*this),os::shared_type);
-		os::spawnThread(&generateKeys,keyGen.get(),"RSA Key Generation");
+		keyGen=os::smart_ptr<RSAKeyGenerator>(new RSAKeyGenerator(*this,token),os::shared_type);
+		os::smart_ptr<RSAKeyGenerator> gen=keyGen;
+		std::shared_future<bool> ret=gen->result();
+		workerPool::singleton()->post([gen](){generateKeys(gen);});
 		writeUnlock();
+		return ret;
+	}
+	//Generate on this thread
+	os::smart_ptr<publicKey> publicRSA::generateNow(uint16_t sz,os::smart_ptr<generationToken> token)
+	{
+		os::smart_ptr<publicRSA> ret(new publicRSA(sz,false),os::shared_type);
+		RSAKeyGenerator gen(*ret,token);
+		gen.start();
+		if(!gen.generatePrimes()) return NULL;
+		gen.pushValues();
+		return os::cast<publicKey,publicRSA>(ret);
+	}
+	//Bind generated keys
+	void publicRSA::installKeys(os::smart_ptr<number> _n,os::smart_ptr<number> _d,os::smart_ptr<RSACRTParameters> _crt)
+	{
+		if(n && d) pushOldKeys(n,d,_timestamp);
+		crt=_crt;
+		n=_n;
+		d=_d;
+		_timestamp=os::getTimestamp();
+		if(n->size()<size()) n->expand(size());
+		if(d->size()<size()) d->expand(size());
+		pruneContexts();
+	}
+	//Prime search threads
+	std::atomic<unsigned int> publicRSA::_generationThreads(0);
+	void publicRSA::setGenerationThreads(unsigned int threads)
+	{
+		_generationThreads=threads;
+	}
+	unsigned int publicRSA::generationThreads()
+	{
+		unsigned int threads=_generationThreads;
+		if(threads==0) threads=std::thread::hardware_concurrency();
+		if(threads==0) threads=1;
+		return threads;
+	}
+	//Primes per generated key
+	std::atomic<unsigned int> publicRSA::_primeCount(2);
+	bool publicRSA::setPrimeCount(unsigned int primes)
+	{
+		if(primes<2 || primes>MAX_PRIMES) return false;
+		_primeCount=primes;
+		return true;
+	}
+	unsigned int publicRSA::primeCount()
+	{
+		return _primeCount;
+	}
+	unsigned int publicRSA::maxPrimes(uint16_t sz)
+	{
+		if(sz<size::public1024) return 2;
+		if(sz<size::public4096) return 3;
+		return 4;
+	}
+	std::atomic<int> publicRSA::_integerType(0);
+	bool publicRSA::setIntegerType(int typeID)
+	{
+		if(typeID!=numberType::Default && !integer::typeDefinition(typeID)) return false;
+		_integerType=typeID;
+		return true;
+	}
+	int publicRSA::integerType()
+	{
+		int typeID=_integerType;
+		if(typeID!=numberType::Default) return typeID;
+		if(base10x64Supported()) return numberType::Base10x64;
+		return numberType::Base10;
 	}
     //Checks to see if we are even generating
     bool publicRSA::generating()
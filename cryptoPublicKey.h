@@ -17,8 +17,14 @@
 
 #include "Datastructures/Datastructures.h"
 #include "cryptoNumber.h"
+#include "fixedInteger.h"
+#include "workerPool.h"
 #include "streamPackage.h"
 #include "osMechanics/osMechanics.h"
+#include <atomic>
+#include <future>
+#include <mutex>
+#include <vector>
 
 namespace crypto
 {
@@ -119,6 +125,35 @@ namespace crypto
 		virtual bool operator<=(const keyChangeSender& l) const{return this<=&l;}
 	};
 
+	/** @brief Cancels asynchronous key generation
+	 *
+	 * Passed to asynchronous key generation.
+	 * Generation which has not finished when the
+	 * token is cancelled stops without binding keys.
+	 * One token may cancel several generations.
+	 */
+	class generationToken
+	{
+		/** @brief Set once cancelled
+		 */
+		std::atomic<bool> _cancelled;
+	public:
+		/** @brief Default constructor
+		 */
+		generationToken(){_cancelled=false;}
+		/** @brief Virtual destructor
+		 */
+		virtual ~generationToken(){}
+		/** @brief Cancel generation
+		 * @return void
+		 */
+		void cancel(){_cancelled=true;}
+		/** @brief Tests for cancellation
+		 * @return True if crypto::generationToken::cancel was called
+		 */
+		bool cancelled() const {return _cancelled;}
+	};
+
 	/** @brief Base public-key class
 	 *
 	 * Class which defines the general
@@ -128,6 +163,12 @@ namespace crypto
 	 */
 	class publicKey: public os::savable, public keyChangeSender
 	{
+		/** @brief Friendship with the key pool
+		 *
+		 * The crypto::keyPool saves and loads
+		 * the keys it holds.
+		 */
+		friend class keyPool;
 		/**@ brief Size of the keys used
 		 */
 		uint16_t _size;
@@ -153,6 +194,28 @@ namespace crypto
 		/**@ brief Mutex for replacing the keys
 		 */
 		os::readWriteLock keyLock;
+
+		/** @brief Cached modular context
+		 *
+		 * Binds a context to the modulus it was built
+		 * from.  Holding the modulus keeps its address
+		 * from being reused by a different key.
+		 */
+		struct contextEntry
+		{
+			/** @brief Modulus the context was built from
+			 */
+			os::smart_ptr<number> source;
+			/** @brief Context, NULL if the modulus is even
+			 */
+			os::smart_ptr<modularContext> context;
+		};
+		/** @brief Contexts of the current and old public keys
+		 */
+		mutable std::vector<contextEntry> _contexts;
+		/** @brief Mutex for the context cache
+		 */
+		mutable std::mutex _contextLock;
 	protected:
 		/**@ brief Public key
 		 */
@@ -237,7 +300,107 @@ namespace crypto
 		 * @param [in] ts Old time-stamp
 		 * @return void
 		 */
-        void pushOldKeys(os::smart_ptr<number> n, os::smart_ptr<number> d,uint64_t ts);
+        virtual void pushOldKeys(os::smart_ptr<number> n, os::smart_ptr<number> d,uint64_t ts);
+		/** @brief Drop stale contexts
+		 *
+		 * Releases cached contexts whose modulus is no
+		 * longer the current or a historical public key.
+		 * Called with the write lock held whenever keys
+		 * are replaced.
+		 *
+		 * @return void
+		 */
+		void pruneContexts();
+		/** @brief Context of a public key
+		 *
+		 * Builds the context the first time a modulus
+		 * is used and returns the cached one after.
+		 * Contexts are read-only and may be shared
+		 * between threads.
+		 *
+		 * @param [in] mod Current or historical public key
+		 * @return Context, NULL if mod is not an odd integer
+		 */
+		os::smart_ptr<modularContext> keyContext(os::smart_ptr<number> mod) const;
+		/** @brief Stored old public key
+		 *
+		 * Unlike crypto::publicKey::getOldN, does not copy.
+		 *
+		 * @param [in] history Historical index
+		 * @return Public key at given index, NULL if there is none
+		 */
+		os::smart_ptr<number> storedN(size_t history);
+		/** @brief Stored old private key
+		 *
+		 * Unlike crypto::publicKey::getOldD, does not copy.
+		 *
+		 * @param [in] history Historical index
+		 * @return Private key at given index, NULL if there is none
+		 */
+		os::smart_ptr<number> storedD(size_t history);
+
+		/** @brief Marks key data in the history field
+		 *
+		 * Set in the history size written to the key file
+		 * when each key pair is followed by algorithm-specific
+		 * key data.  Files without this flag predate key data.
+		 */
+		static const uint16_t KEY_DATA_FLAG=0x8000;
+		/** @brief Marks extended key data in the history field
+		 *
+		 * Set alongside crypto::publicKey::KEY_DATA_FLAG
+		 * when the key data uses the algorithm's extended
+		 * layout.  Readers which predate the flag reject
+		 * the file as an invalid history size.
+		 */
+		static const uint16_t KEY_DATA_EXTENDED_FLAG=0x4000;
+		/** @brief Length of algorithm-specific key data
+		 *
+		 * Algorithms which store data beyond n and d
+		 * with each key pair return the number of bytes
+		 * written to the key file after every pair.
+		 *
+		 * @param [in] extended Extended layout
+		 * @return 0 by default
+		 */
+		virtual size_t keyDataLength(bool extended) const {return 0;}
+		/** @brief Key data requires the extended layout
+		 *
+		 * Checked when saving, the extended layout is
+		 * only written when some key pair needs it.
+		 *
+		 * @return false by default
+		 */
+		virtual bool extendedKeyData() const {return false;}
+		/** @brief Write algorithm-specific key data
+		 *
+		 * @param [out] arr Array of crypto::publicKey::keyDataLength() bytes
+		 * @param [in] hist Historical index, crypto::publicKey::CURRENT_INDEX for the current pair
+		 * @param [in] extended Extended layout
+		 * @return void
+		 */
+		virtual void writeKeyData(unsigned char* arr,size_t hist,bool extended) const {}
+		/** @brief Read algorithm-specific key data
+		 *
+		 * Called for the current pair first, then for
+		 * each historical pair, oldest first, directly
+		 * after that pair is bound to the history.
+		 *
+		 * @param [in] arr Array of crypto::publicKey::keyDataLength() bytes
+		 * @param [in] hist Historical index, crypto::publicKey::CURRENT_INDEX for the current pair
+		 * @param [in] extended Extended layout
+		 * @return void
+		 */
+		virtual void readKeyData(const unsigned char* arr,size_t hist,bool extended) {}
+		/** @brief Clear algorithm-specific key data
+		 *
+		 * Called by crypto::publicKey::loadFile before
+		 * reading, so data of the replaced keys is not
+		 * kept when the file has none.
+		 *
+		 * @return void
+		 */
+		virtual void clearKeyData() {}
     public:
 		/** @brief Current key index
 		 * Allows the current key to be accessed
@@ -360,6 +523,16 @@ namespace crypto
 		 * @return void
 		 */
 		virtual void generateNewKeys();
+		/** @brief Asynchronous key generation
+		 *
+		 * Starts generating new keys like
+		 * crypto::publicKey::generateNewKeys and
+		 * returns without waiting on them.
+		 *
+		 * @param [in] token Cancels generation, NULL by default
+		 * @return True once new keys are bound, false if cancelled
+		 */
+		virtual std::shared_future<bool> generateNewKeysAsync(os::smart_ptr<generationToken> token=NULL);
 		/** @brief Tests if the keys are in the process of generating
 		 * @return True if generating new keys
 		 */
@@ -402,6 +575,13 @@ namespace crypto
         inline size_t history() const {return _history;}
 
 		/** @brief Re-save the entire structure
+		 *
+		 * Returns without saving while keys are
+		 * generating, the keys are saved once they
+		 * are bound.  Wait on the result of
+		 * crypto::publicKey::generateNewKeysAsync
+		 * to save on the calling thread.
+		 *
 		 * @return void
 		 */
 		void save();
@@ -562,6 +742,82 @@ namespace crypto
 		 */
         void decode(unsigned char* code, size_t codeLength, size_t hist);
 
+		/** @brief Static batch number encode
+		 *
+		 * Encodes every number in codes on the
+		 * crypto::workerPool.  Algorithms re-implement
+		 * this to share precomputation on publicN
+		 * across the batch.
+		 *
+		 * @param [in] codes Data to be encoded
+		 * @param [in] publicN Public key to be encoded against
+		 * @param [in] size Size of key used
+		 * @return Encoded numbers, in the order of codes
+		 */
+		static std::vector<os::smart_ptr<number> > encodeBatch(const std::vector<os::smart_ptr<number> >& codes, os::smart_ptr<number> publicN, uint16_t size);
+		/** @brief Static batch data encode
+		 *
+		 * @param [in/out] codes Buffers to be encoded
+		 * @param [in] count Number of buffers
+		 * @param [in] codeLength Length of each buffer
+		 * @param [in] publicN Public key to be encoded against
+		 * @param [in] size Size of key used
+		 * @return void
+		 */
+		static void encodeBatch(unsigned char* const* codes, size_t count, size_t codeLength, os::smart_ptr<number> publicN, uint16_t size);
+		/** @brief Batch number encode
+		 *
+		 * Encodes every number in codes on the
+		 * crypto::workerPool, sharing this key's
+		 * precomputation.  Throws the first error
+		 * of the batch.
+		 *
+		 * @param [in] codes Data to be encoded
+		 * @param [in] publicN Public key to be encoded against, NULL by default
+		 * @return Encoded numbers, in the order of codes
+		 */
+		std::vector<os::smart_ptr<number> > encodeBatch(const std::vector<os::smart_ptr<number> >& codes, os::smart_ptr<number> publicN=NULL) const;
+		/** @brief Batch data encode
+		 * @param [in/out] codes Buffers to be encoded
+		 * @param [in] count Number of buffers
+		 * @param [in] codeLength Length of each buffer
+		 * @param [in] publicN Public key to be encoded against, NULL by default
+		 * @return void
+		 */
+		void encodeBatch(unsigned char* const* codes, size_t count, size_t codeLength, os::smart_ptr<number> publicN=NULL) const;
+		/** @brief Batch number decode
+		 *
+		 * Decodes every number in codes on the
+		 * crypto::workerPool, sharing this key's
+		 * precomputation.  Throws the first error
+		 * of the batch.
+		 *
+		 * @param [in] codes Data to be decoded
+		 * @return Decoded numbers, in the order of codes
+		 */
+		std::vector<os::smart_ptr<number> > decodeBatch(const std::vector<os::smart_ptr<number> >& codes) const;
+		/** @brief Batch number decode, old key
+		 * @param [in] codes Data to be decoded
+		 * @param [in] hist Index of historical key
+		 * @return Decoded numbers, in the order of codes
+		 */
+		std::vector<os::smart_ptr<number> > decodeBatch(const std::vector<os::smart_ptr<number> >& codes, size_t hist);
+		/** @brief Batch data decode
+		 * @param [in/out] codes Buffers to be decoded
+		 * @param [in] count Number of buffers
+		 * @param [in] codeLength Length of each buffer
+		 * @return void
+		 */
+		void decodeBatch(unsigned char* const* codes, size_t count, size_t codeLength) const;
+		/** @brief Batch data decode, old key
+		 * @param [in/out] codes Buffers to be decoded
+		 * @param [in] count Number of buffers
+		 * @param [in] codeLength Length of each buffer
+		 * @param [in] hist Index of historical key
+		 * @return void
+		 */
+		void decodeBatch(unsigned char* const* codes, size_t count, size_t codeLength, size_t hist);
+
         /** @brief Compare this with another public key
          *
          * Compares based on the algorithm ID and size of
@@ -586,6 +842,139 @@ namespace crypto
     ///@cond INTERNAL
 	class RSAKeyGenerator;
 	///@endcond
+
+	/** @brief RSA Chinese Remainder Theorem parameters
+	 *
+	 * Holds the prime factors of an RSA modulus
+	 * along with the reduced private exponents
+	 * and the coefficients used to recombine the
+	 * exponentiations modulo each prime.  Two-prime
+	 * keys only use p and q, multi-prime keys list
+	 * their further primes in otherPrimes.  A default
+	 * constructed set is empty and marks a key
+	 * which must be decoded over the full modulus.
+	 */
+	class RSACRTParameters
+	{
+	public:
+		/** @brief First prime factor
+		 */
+		integer p;
+		/** @brief Second prime factor
+		 */
+		integer q;
+		/** @brief d mod (p-1)
+		 */
+		integer dP;
+		/** @brief d mod (q-1)
+		 */
+		integer dQ;
+		/** @brief q^-1 mod p
+		 */
+		integer qInv;
+		/** @brief Context of p
+		 */
+		os::smart_ptr<modularContext> pContext;
+		/** @brief Context of q
+		 */
+		os::smart_ptr<modularContext> qContext;
+
+		/** @brief Third or later prime factor
+		 *
+		 * Follows OtherPrimeInfo of RFC 8017.
+		 */
+		struct primeInfo
+		{
+			/** @brief Prime factor r_i
+			 */
+			integer prime;
+			/** @brief d mod (r_i-1)
+			 */
+			integer exponent;
+			/** @brief (p*q*...*r_(i-1))^-1 mod r_i
+			 */
+			integer coefficient;
+			/** @brief Context of r_i
+			 */
+			os::smart_ptr<modularContext> context;
+		};
+		/** @brief Prime factors after p and q
+		 *
+		 * Empty for two-prime keys.
+		 */
+		std::vector<primeInfo> otherPrimes;
+
+		/** @brief Empty constructor
+		 */
+		RSACRTParameters(){}
+		/** @brief Construct from primes and private key
+		 *
+		 * @param [in] _p First prime factor
+		 * @param [in] _q Second prime factor
+		 * @param [in] _d Private key
+		 * @param [in] sz Size of key
+		 */
+		RSACRTParameters(const integer& _p,const integer& _q,const integer& _d,uint16_t sz);
+		/** @brief Construct from stored parameters
+		 *
+		 * @param [in] _p First prime factor
+		 * @param [in] _q Second prime factor
+		 * @param [in] _dP d mod (p-1)
+		 * @param [in] _dQ d mod (q-1)
+		 * @param [in] _qInv q^-1 mod p
+		 */
+		RSACRTParameters(const integer& _p,const integer& _q,const integer& _dP,const integer& _dQ,const integer& _qInv);
+		/** @brief Virtual destructor
+         *
+         * Destructor must be virtual, if an object
+         * of this type is deleted, the destructor
+         * of the type which inherits this class should
+         * be called.
+         */
+		virtual ~RSACRTParameters(){}
+
+		/** @brief Add a prime factor
+		 *
+		 * Binds the next prime of a multi-prime key,
+		 * primes must be added in order.
+		 *
+		 * @param [in] _r Prime factor
+		 * @param [in] _d Private key
+		 * @return void
+		 */
+		void addPrime(const integer& _r,const integer& _d);
+		/** @brief Add a stored prime factor
+		 *
+		 * @param [in] _r Prime factor
+		 * @param [in] _dR d mod (r-1)
+		 * @param [in] _tR Coefficient of r
+		 * @return void
+		 */
+		void addPrime(const integer& _r,const integer& _dR,const integer& _tR);
+		/** @brief Number of prime factors
+		 * @return 0 if the parameters are not defined
+		 */
+		size_t primes() const;
+		/** @brief Tests if the parameters are defined
+		 * @return True if both primes are non-zero
+		 */
+		bool valid() const;
+		/** @brief Private key exponentiation
+		 *
+		 * Computes code^d mod n with one exponentiation
+		 * modulo each prime and Garner's recombination.
+		 *
+		 * @param [in] code Data to be decoded
+		 * @return Decoded number
+		 */
+		integer decode(const integer& code) const;
+
+		#undef CURRENT_CLASS
+        #define CURRENT_CLASS RSACRTParameters
+        POINTER_HASH_CAST
+        POINTER_COMPARE
+        COMPARE_OPERATORS
+	};
 	
 	/** @brief RSA public-key encryption
 	 *
@@ -610,10 +999,117 @@ namespace crypto
 		 * key is currently being generated/
 		 */
 		os::smart_ptr<RSAKeyGenerator> keyGen;
+		/** @brief CRT parameters of the current keys
+		 *
+		 * NULL if the current keys were bound without
+		 * their prime factors.
+		 */
+		os::smart_ptr<RSACRTParameters> crt;
+		/** @brief List of old CRT parameters
+		 *
+		 * Indexed the same as crypto::publicKey::oldN,
+		 * empty parameters mark historical keys without
+		 * prime factors.
+		 */
+		os::pointerUnsortedList<RSACRTParameters> oldCRT;
+		/** @brief Number of prime search threads
+		 *
+		 * Zero selects the hardware concurrency.
+		 */
+		static std::atomic<unsigned int> _generationThreads;
+		/** @brief Integer type ID of RSA arithmetic
+		 *
+		 * crypto::numberType::Default selects the
+		 * fastest integer type available.
+		 */
+		static std::atomic<int> _integerType;
+		/** @brief Number of primes in generated keys
+		 */
+		static std::atomic<unsigned int> _primeCount;
 		/** @brief Subroutine initializing crypto::publicRSA::e
 		 */
 		void initE();
+		/** @brief Constructs an RSA key
+		 *
+		 * Allows crypto::publicRSA::generateNow to
+		 * construct a key without keys.
+		 *
+		 * @param [in] sz Size of keys
+		 * @param [in] generate Generate keys as crypto::publicRSA::publicRSA(uint16_t) does
+		 */
+		publicRSA(uint16_t sz,bool generate);
+		/** @brief Bind newly generated keys
+		 *
+		 * Moves the current keys into the history.
+		 * Requires the write lock.
+		 *
+		 * @param [in] _n New public key
+		 * @param [in] _d New private key
+		 * @param [in] _crt CRT parameters of the new keys
+		 * @return void
+		 */
+		void installKeys(os::smart_ptr<number> _n,os::smart_ptr<number> _d,os::smart_ptr<RSACRTParameters> _crt);
+	protected:
+		/** @brief Bind old keys to history
+		 *
+		 * Moves the current CRT parameters into the
+		 * history alongside the old n and d.
+		 *
+		 * @param [in] n Old public key
+		 * @param [in] d Old private key
+		 * @param [in] ts Old time-stamp
+		 * @return void
+		 */
+		void pushOldKeys(os::smart_ptr<number> n, os::smart_ptr<number> d,uint64_t ts);
+		/** @brief Length of CRT key data
+		 *
+		 * The extended layout follows the five two-prime
+		 * numbers with the prime, exponent and coefficient
+		 * of each further prime, up to crypto::publicRSA::MAX_PRIMES.
+		 *
+		 * @param [in] extended Extended layout
+		 * @return Five numbers of crypto::publicKey::size(), 11 when extended
+		 */
+		size_t keyDataLength(bool extended) const;
+		/** @brief Multi-prime keys present
+		 * @return True if the current or a historical pair has more than two primes
+		 */
+		bool extendedKeyData() const;
+		/** @brief Write CRT key data
+		 *
+		 * @param [out] arr Array of crypto::publicRSA::keyDataLength() bytes
+		 * @param [in] hist Historical index, crypto::publicKey::CURRENT_INDEX for the current pair
+		 * @param [in] extended Extended layout
+		 * @return void
+		 */
+		void writeKeyData(unsigned char* arr,size_t hist,bool extended) const;
+		/** @brief Read CRT key data
+		 *
+		 * @param [in] arr Array of crypto::publicRSA::keyDataLength() bytes
+		 * @param [in] hist Historical index, crypto::publicKey::CURRENT_INDEX for the current pair
+		 * @param [in] extended Extended layout
+		 * @return void
+		 */
+		void readKeyData(const unsigned char* arr,size_t hist,bool extended);
+		/** @brief Clear CRT key data
+		 *
+		 * Drops the current and historical
+		 * CRT parameters.
+		 *
+		 * @return void
+		 */
+		void clearKeyData();
 	public:
+		/** @brief RSA public exponent
+		 *
+		 * Every RSA key uses e=65537, which
+		 * allows encoding to run on a single
+		 * word exponent.
+		 */
+		static const uint32_t PUBLIC_EXPONENT=65537;
+		/** @brief Most primes in a key
+		 */
+		static const unsigned int MAX_PRIMES=4;
 		/** @brief Default RSA constructor
 		 *
 		 * Initializes and generates keys for
@@ -669,9 +1165,10 @@ namespace crypto
          * Destructor must be virtual, if an object
          * of this type is deleted, the destructor
          * of the type which inherits this class should
-         * be called.
+         * be called.  Cancels key generation and waits
+         * for a running generation to stop.
          */
-	    virtual ~publicRSA(){}
+	    virtual ~publicRSA();
 
 		/** @brief Converts number to integer
 		 * @param [in] num Number to be converted
@@ -727,13 +1224,100 @@ namespace crypto
 		bool generating();
 		/** @brief Key generation function
 		 *
-		 * Generates new keys for the specific
-		 * algorithm.  This is re-implemented
-		 * by every algorithm.
+		 * Binds a key from crypto::keyPool::singleton()
+		 * if one of this size is ready.  Otherwise,
+		 * generates new keys on crypto::workerPool::singleton().
 		 *
 		 * @return void
 		 */
 		void generateNewKeys();
+		/** @brief Asynchronous key generation
+		 *
+		 * Binds a key from crypto::keyPool::singleton()
+		 * if one of this size is ready.  Otherwise,
+		 * generates new keys on crypto::workerPool::singleton().
+		 * While keys are generating, returns the result
+		 * of the generation already running.
+		 *
+		 * @param [in] token Cancels generation, NULL by default
+		 * @return True once new keys are bound, false if cancelled
+		 */
+		std::shared_future<bool> generateNewKeysAsync(os::smart_ptr<generationToken> token=NULL);
+		/** @brief Generates a key on the calling thread
+		 *
+		 * Does not take from crypto::keyPool, which
+		 * fills its stock with this function.
+		 *
+		 * @param [in] sz Size of keys
+		 * @param [in] token Cancels generation, NULL by default
+		 * @return Newly generated key, NULL if cancelled
+		 */
+		static os::smart_ptr<publicKey> generateNow(uint16_t sz,os::smart_ptr<generationToken> token=NULL);
+		/** @brief CRT parameter access
+		 *
+		 * @param history Historical index, crypto::publicKey::CURRENT_INDEX by default
+		 * @return CRT parameters, NULL if the keys have none
+		 */
+		os::smart_ptr<RSACRTParameters> getCRT(size_t history=CURRENT_INDEX);
+		/** @brief Sets the number of prime search threads
+		 *
+		 * Key generation runs this many searches for the
+		 * primes, one search for each prime in turn.  The
+		 * searches run concurrently on crypto::workerPool,
+		 * bounded by crypto::workerPool::threads().  Zero,
+		 * the default, uses the hardware concurrency.
+		 *
+		 * @param [in] threads Number of threads, 0 for hardware concurrency
+		 * @return void
+		 */
+		static void setGenerationThreads(unsigned int threads);
+		/** @brief Number of prime search threads
+		 * @return Threads used by key generation, at least 1
+		 */
+		static unsigned int generationThreads();
+		/** @brief Sets the number of primes in generated keys
+		 *
+		 * Private operations on a key with k primes run
+		 * k exponentiations of 1/k the key size.  The public
+		 * key is an ordinary modulus, peers see no difference.
+		 * Keys too small to hold the count safely are
+		 * generated with crypto::publicRSA::maxPrimes instead.
+		 *
+		 * @param [in] primes Between 2, the default, and crypto::publicRSA::MAX_PRIMES
+		 * @return true if set, false if primes is out of range
+		 */
+		static bool setPrimeCount(unsigned int primes);
+		/** @brief Number of primes in generated keys
+		 * @return Count bound by crypto::publicRSA::setPrimeCount
+		 */
+		static unsigned int primeCount();
+		/** @brief Most primes for a key size
+		 *
+		 * Keeps every prime large enough to resist
+		 * factoring: two primes below 1024 bits, three
+		 * below 4096 bits and four from 4096 bits.
+		 *
+		 * @param [in] sz Size of key
+		 * @return Number of primes allowed
+		 */
+		static unsigned int maxPrimes(uint16_t sz);
+		/** @brief Sets the integer type of RSA arithmetic
+		 *
+		 * Numbers converted by crypto::publicRSA::copyConvert
+		 * and codes passed to encode and decode are bound
+		 * to this type.  crypto::numberType::Default, the default,
+		 * selects crypto::numberType::Base10x64 when its 64-bit
+		 * kernels are available.  Key files and encoded data
+		 * do not depend on the selection.
+		 *
+		 * @param [in] typeID Integer number ID, or crypto::numberType::Default
+		 * @return true if set, false if typeID is not an integer type
+		 */
+		static bool setIntegerType(int typeID);
+		/** @brief Integer type of RSA arithmetic
+		 * @return crypto::numberType::Base10 or crypto::numberType::Base10x64
+		 */
+		static int integerType();
 	    
 	    /** @brief Static number encode
 		 *
@@ -777,6 +1361,31 @@ namespace crypto
 		 * @return void
 		 */
 		static void encode(unsigned char* code, size_t codeLength, unsigned const char* publicN, size_t nLength, uint16_t size);
+		/** @brief Static batch number encode
+		 *
+		 * Builds the context of publicN once
+		 * for the whole batch.
+		 *
+		 * @param [in] codes Data to be encoded
+		 * @param [in] publicN Public key to be encoded against
+		 * @param [in] size Size of key used
+		 * @return Encoded numbers, in the order of codes
+		 */
+		static std::vector<os::smart_ptr<number> > encodeBatch(const std::vector<os::smart_ptr<number> >& codes, os::smart_ptr<number> publicN, uint16_t size);
+		/** @brief Static batch data encode
+		 *
+		 * Builds the context of publicN once
+		 * for the whole batch.
+		 *
+		 * @param [in/out] codes Buffers to be encoded
+		 * @param [in] count Number of buffers
+		 * @param [in] codeLength Length of each buffer
+		 * @param [in] publicN Public key to be encoded against
+		 * @param [in] size Size of key used
+		 * @return void
+		 */
+		static void encodeBatch(unsigned char* const* codes, size_t count, size_t codeLength, os::smart_ptr<number> publicN, uint16_t size);
+		using publicKey::encodeBatch;
 	    
 		/** @brief Number encode
 		 * @param [in] code Data to be encoded
@@ -803,7 +1412,8 @@ namespace crypto
 		 *
 		 * Uses the private key to decode a
 		 * set of data based on the RSA
-		 * algorithm.
+		 * algorithm.  Keys with CRT parameters
+		 * decode modulo each prime.
 		 *
 		 * @param  [in] code Data to be decoded
 		 * @return Decoded number
@@ -813,7 +1423,8 @@ namespace crypto
 		 *
 		 * Uses old private keys to decode a
 		 * set of data based on the RSA
-		 * algorithm.
+		 * algorithm.  Keys with CRT parameters
+		 * decode modulo each prime.
 		 *
 		 * @param  [in] code Data to be decoded
 		 * @param [in] hist Index of historical key
@@ -836,22 +1447,50 @@ namespace crypto
 		 * its generated keys into.
 		 */
 		publicRSA* master;
+		/** @brief Odd primes used to sieve candidates
+		 */
+		os::smart_ptr<uint16_t> smallPrimes;
+		/** @brief Number of entries in crypto::RSAKeyGenerator::smallPrimes
+		 */
+		uint16_t smallPrimeCount;
+		/** @brief Cancels generation, may be NULL
+		 */
+		os::smart_ptr<generationToken> token;
+		/** @brief Set when master is destroyed
+		 */
+		std::atomic<bool> stopped;
+		/** @brief Set once generation is claimed
+		 */
+		std::atomic<bool> started;
+		/** @brief Result of generation
+		 */
+		std::promise<bool> promise;
+		/** @brief Future of crypto::RSAKeyGenerator::promise
+		 */
+		std::shared_future<bool> _result;
 	
 	public:
-		/** @brief Intermediate prime
+		/** @brief Exclusive bound of the sieve primes
 		 */
-		integer p;
-		/** @brief Intermediate prime
+		static const uint32_t SIEVE_BOUND=32768;
+		/** @brief Odd candidates sieved at a time
 		 */
-		integer q;
+		static const uint32_t SIEVE_WIDTH=4096;
+
+		/** @brief Intermediate primes, p and q first
+		 */
+		std::vector<integer> primes;
 		
 		/** @brief Constructs a generator with an RSA key
 		 *
 		 * This class is meaningless without a
 		 * a reference to an RSA key to bind
 		 * newly created keys to.
+		 *
+		 * @param [in/out] m Key to bind generated keys to
+		 * @param [in] tk Cancels generation, NULL by default
 		 */
-		RSAKeyGenerator(publicRSA& m);
+		RSAKeyGenerator(publicRSA& m,os::smart_ptr<generationToken> tk=NULL);
 		/** @brief Virtual destructor
          *
          * Destructor must be virtual, if an object
@@ -861,14 +1500,103 @@ namespace crypto
          */
 		virtual ~RSAKeyGenerator(){}
 		
+		/** @brief Claim generation
+		 *
+		 * Generation runs on whichever thread claims
+		 * it first, or is abandoned by the destructor
+		 * of its key.
+		 *
+		 * @return True if not claimed before
+		 */
+		bool start() {return !started.exchange(true);}
+		/** @brief Stop generation
+		 *
+		 * Called when the key is destroyed.
+		 *
+		 * @return void
+		 */
+		void stop() {stopped=true;}
+		/** @brief Tests for cancellation
+		 * @return True if stopped or the token is cancelled
+		 */
+		bool cancelled() const {return stopped || (token && token->cancelled());}
+		/** @brief Result of generation
+		 * @return True once keys are bound, false if cancelled
+		 */
+		std::shared_future<bool> result() const {return _result;}
+		/** @brief Number of primes generated
+		 * @return crypto::publicRSA::primeCount() bound by crypto::publicRSA::maxPrimes()
+		 */
+		unsigned int primeTarget() const;
+		/** @brief Length of a prime
+		 *
+		 * Splits the key size between the primes,
+		 * earlier primes take the remainder.
+		 *
+		 * @param [in] index Index of the prime
+		 * @param [in] count Number of primes
+		 * @return Length in uint32_t
+		 */
+		uint16_t primeLength(unsigned int index,unsigned int count) const;
+		/** @brief Random prime search start
+		 *
+		 * Sets the top three bits, so the product of up
+		 * to crypto::publicRSA::MAX_PRIMES primes has every
+		 * bit of the key.  Throws crypto::randomSeedError
+		 * if the random number generator is not seeded.
+		 *
+		 * @param [in] length Length in uint32_t
+		 * @return Odd integer of length uint32_t, top three bits set
+		 */
+		integer randomCandidate(uint16_t length);
+		/** @brief Sieved prime search
+		 *
+		 * Steps an odd candidate upward through
+		 * intervals of crypto::RSAKeyGenerator::SIEVE_WIDTH
+		 * odd numbers.  Only candidates without a
+		 * small prime factor reach the primality test.
+		 * Candidates r with r-1 divisible by
+		 * crypto::publicRSA::PUBLIC_EXPONENT are skipped,
+		 * e has no inverse for them.  Also stops once
+		 * generation is cancelled.
+		 *
+		 * @param [in/out] candidate Odd starting point, prime on success
+		 * @param [in] cancel Stops the search when set, NULL by default
+		 * @return True if a prime was found, false if cancelled
+		 */
+		bool searchPrime(integer& candidate,const std::atomic<bool>* cancel=NULL);
 		/** @brief Generates a prime number
+		 * @param [in] length Length in uint32_t
 		 * @return Prime integer
 		 */
-		integer generatePrime();
+		integer generatePrime(uint16_t length);
+		/** @brief Generates the primes
+		 *
+		 * Splits crypto::publicRSA::generationThreads()
+		 * searches between the primes and runs them on
+		 * crypto::workerPool::singleton().  The first
+		 * search to find each prime cancels the others
+		 * searching for it.
+		 *
+		 * @return True if generated, false if cancelled
+		 */
+		bool generatePrimes();
 		/** @brief Bind generated keys to master
+		 *
+		 * Resolves crypto::RSAKeyGenerator::result to true.
+		 *
          * @return void
          */
 		void pushValues();
+		/** @brief Finish without binding keys
+		 *
+		 * Resolves crypto::RSAKeyGenerator::result to false,
+		 * or to the error which stopped generation.
+		 *
+		 * @param [in] error Error stopping generation, NULL if cancelled
+		 * @return void
+		 */
+		void abandon(std::exception_ptr error=std::exception_ptr());
 	};
   
 };
@@ -0,0 +1,158 @@
+/**
+ * @file   fixedInteger.cpp
+ * @author Jonathan Bedard
+ * @date   10/18/2026
+ * @brief  Instantiates compile-time sized integers
+ * @bug No known bugs.
+ *
+ * Instantiates the fixed size integers for
+ * the supported key sizes and dispatches
+ * modular exponentiation to them.  Consult
+ * fixedInteger.h for details.
+ *
+ */
+
+///@cond INTERNAL
+
+#ifndef FIXED_INTEGER_CPP
+#define FIXED_INTEGER_CPP
+
+#include "fixedInteger.h"
+
+namespace crypto
+{
+	template class fixedInteger<8>;
+	template class fixedInteger<12>;
+	template class fixedInteger<16>;
+	template class fixedInteger<24>;
+	template class fixedInteger<32>;
+	template class fixedInteger<48>;
+	template class fixedInteger<64>;
+	template class fixedMontgomery<8>;
+	template class fixedMontgomery<12>;
+	template class fixedMontgomery<16>;
+	template class fixedMontgomery<24>;
+	template class fixedMontgomery<32>;
+	template class fixedMontgomery<48>;
+	template class fixedMontgomery<64>;
+
+	template class fixedModularContext<8>;
+	template class fixedModularContext<12>;
+	template class fixedModularContext<16>;
+	template class fixedModularContext<24>;
+	template class fixedModularContext<32>;
+	template class fixedModularContext<48>;
+	template class fixedModularContext<64>;
+
+	//Context on one instantiation
+	template <uint16_t Limbs>
+	static os::smart_ptr<modularContext> buildContext(const integer& mod)
+	{
+		fixedModularContext<Limbs>* ctx=new fixedModularContext<Limbs>(mod);
+		if(!ctx->valid())
+		{
+			delete ctx;
+			return NULL;
+		}
+		return os::smart_ptr<modularContext>(ctx,os::shared_type);
+	}
+	//Context on the instantiation for limbs, NULL if none
+	static os::smart_ptr<modularContext> buildFixed(const integer& mod,uint16_t limbs)
+	{
+		switch(limbs)
+		{
+		case 8: return buildContext<8>(mod);
+		case 12: return buildContext<12>(mod);
+		case 16: return buildContext<16>(mod);
+		case 24: return buildContext<24>(mod);
+		case 32: return buildContext<32>(mod);
+		case 48: return buildContext<48>(mod);
+		case 64: return buildContext<64>(mod);
+		default: return NULL;
+		}
+	}
+	//Build a context
+	os::smart_ptr<modularContext> modularContext::build(const integer& mod,uint16_t limbs)
+	{
+		os::smart_ptr<modularContext> ret=buildFixed(mod,limbs);
+		if(ret) return ret;
+		montgomeryModularContext* ctx=new montgomeryModularContext(mod);
+		if(!ctx->valid())
+		{
+			delete ctx;
+			return NULL;
+		}
+		return os::smart_ptr<modularContext>(ctx,os::shared_type);
+	}
+
+	//Montgomery context of any size
+	montgomeryModularContext::montgomeryModularContext(const integer& mod):_mod(mod)
+	{
+		_valid=base10MontgomeryInit(&_ctx,mod.data(),mod.size(),NULL)!=0;
+	}
+	montgomeryModularContext::~montgomeryModularContext()
+	{
+		base10MontgomeryFree(&_ctx);
+	}
+	//Exponentiation on the thread's workspace
+	void montgomeryModularContext::exponentiation(const integer& base,const uint32_t* exp,uint16_t expLen,integer& result) const
+	{
+		//Montgomery form only needs the base below R
+		uint16_t len=_ctx.length;
+		integer reduced;
+		const integer* src=&base;
+		if(base.usedSize()>len)
+		{
+			reduced=base%_mod;
+			src=&reduced;
+		}
+
+		//Reserve before taking from the workspace, growing it moves the data
+		struct numberScratch* scratch=numberScratchThread();
+		if(!numberScratchReserve(scratch,NUMBER_SCRATCH_SIZE(len)))
+		{
+			result=base.moduloExponentiation(integer(exp,expLen),_mod);
+			return;
+		}
+		uint32_t mark=scratch->used;
+		uint32_t* val=numberScratchPush(scratch,len);
+		memset(val,0,sizeof(uint32_t)*len);
+		memcpy(val,src->data(),sizeof(uint32_t)*(src->size()<len?src->size():len));
+		base10MontgomeryExponentiation(&_ctx,val,exp,expLen,val,scratch);
+
+		result=integer(val,len);
+		scratch->used=mark;
+		result.convertType(base.typeID());
+		uint16_t targ=base.size();
+		if(_mod.size()>targ) targ=_mod.size();
+		if(result.size()<targ) result.expand(targ);
+	}
+
+	//Supported sizes
+	bool fixedIntegerSupported(uint16_t limbs)
+	{
+		return fixedIntegerLimbs(limbs)==limbs;
+	}
+	//Smallest instantiation holding used
+	uint16_t fixedIntegerLimbs(uint16_t used)
+	{
+		static const uint16_t sizes[]={8,12,16,24,32,48,64};
+		for(unsigned int i=0;i<sizeof(sizes)/sizeof(uint16_t);++i)
+		{
+			if(used<=sizes[i]) return sizes[i];
+		}
+		return 0;
+	}
+	//Dispatch on size
+	bool fixedModuloExponentiation(const integer& base,const uint32_t* exp,uint16_t expLen,const integer& mod,uint16_t limbs,integer& result)
+	{
+		os::smart_ptr<modularContext> ctx=buildFixed(mod,limbs);
+		if(!ctx) return false;
+		ctx->exponentiation(base,exp,expLen,result);
+		return true;
+	}
+}
+
+#endif
+
+///@endcond
@@ -0,0 +1,651 @@
+/**
+ * @file   fixedInteger.h
+ * @author Jonathan Bedard
+ * @date   10/18/2026
+ * @brief  Compile-time sized integers
+ * @bug No known bugs.
+ *
+ * Declares integers whose length is a template
+ * argument, along with a Montgomery context on
+ * them.  Every loop in these kernels has a constant
+ * trip count, so the compiler can unroll and keep
+ * values in registers.  Instantiations exist for the
+ * supported RSA key sizes and their prime factors,
+ * including the factors of three-prime keys.
+ *
+ */
+
+#ifndef FIXED_INTEGER_H
+#define FIXED_INTEGER_H
+
+#include <array>
+#include <stdint.h>
+#include <string.h>
+#include "cryptoNumber.h"
+
+/** @brief Unroll a constant length limb loop
+ */
+#if defined(__GNUC__)
+	#define FIXED_UNROLL _Pragma("GCC unroll 16")
+#else
+	#define FIXED_UNROLL
+#endif
+
+namespace crypto
+{
+#ifdef __SIZEOF_INT128__
+	/** @brief Limb of a fixed integer
+	 */
+	typedef uint64_t fixedLimb;
+	/** @brief Product of two fixed limbs
+	 */
+	typedef unsigned __int128 fixedWide;
+#else
+	/** @brief Limb of a fixed integer
+	 */
+	typedef uint32_t fixedLimb;
+	/** @brief Product of two fixed limbs
+	 */
+	typedef uint64_t fixedWide;
+#endif
+
+	/** @brief Fixed size integer
+	 *
+	 * Unsigned integer of exactly Limbs uint32_t,
+	 * stored by value in 64-bit limbs when the
+	 * compiler has a 128-bit product.  Limbs
+	 * is counted in uint32_t to match the key
+	 * sizes in crypto::size.
+	 */
+	template <uint16_t Limbs>
+	class fixedInteger
+	{
+		static_assert(Limbs>0 && Limbs%2==0,"fixedInteger requires an even number of uint32_t");
+
+		/** @brief uint32_t in each limb
+		 */
+		static const uint16_t ratio=sizeof(fixedLimb)/sizeof(uint32_t);
+	public:
+		/** @brief Number of limbs
+		 */
+		static const uint16_t words=Limbs/ratio;
+	protected:
+		/** @brief Limbs, least significant first
+		 */
+		std::array<fixedLimb,words> _data;
+	public:
+		/** @brief Zero constructor
+		 */
+		fixedInteger(){_data.fill(0);}
+		/** @brief Construct from uint32_t array
+		 * @param [in] src Little-endian array
+		 * @param [in] length Length of src
+		 */
+		fixedInteger(const uint32_t* src,uint16_t length){load(src,length);}
+
+		/** @brief Load from uint32_t array
+		 *
+		 * Elements of src past Limbs are ignored.
+		 *
+		 * @param [in] src Little-endian array
+		 * @param [in] length Length of src
+		 * @return void
+		 */
+		void load(const uint32_t* src,uint16_t length)
+		{
+			_data.fill(0);
+			if(length>Limbs) length=Limbs;
+			for(uint16_t cnt=0;cnt<length;cnt++)
+				_data[cnt/ratio]|=((fixedLimb)src[cnt])<<(32*(cnt%ratio));
+		}
+		/** @brief Store to uint32_t array
+		 *
+		 * Elements of dest past Limbs are zeroed.
+		 *
+		 * @param [out] dest Little-endian array
+		 * @param [in] length Length of dest
+		 * @return void
+		 */
+		void store(uint32_t* dest,uint16_t length) const
+		{
+			memset(dest,0,sizeof(uint32_t)*length);
+			if(length>Limbs) length=Limbs;
+			for(uint16_t cnt=0;cnt<length;cnt++)
+				dest[cnt]=(uint32_t)(_data[cnt/ratio]>>(32*(cnt%ratio)));
+		}
+
+		/** @brief Limb array
+		 * @return crypto::fixedInteger::_data
+		 */
+		fixedLimb* data() {return _data.data();}
+		/** @brief Constant limb array
+		 * @return crypto::fixedInteger::_data
+		 */
+		const fixedLimb* data() const {return _data.data();}
+
+		/** @brief Compare
+		 * @param [in] cmp Integer to compare against
+		 * @return 1 if this>cmp, 0 if equal, -1 if this<cmp
+		 */
+		int compare(const fixedInteger& cmp) const
+		{
+			for(uint16_t cnt=words;cnt>0;cnt--)
+			{
+				if(_data[cnt-1]>cmp._data[cnt-1]) return 1;
+				if(_data[cnt-1]<cmp._data[cnt-1]) return -1;
+			}
+			return 0;
+		}
+		/** @brief Add in place
+		 * @param [in] src Integer to be added
+		 * @return Carry out of the top limb
+		 */
+		fixedLimb add(const fixedInteger& src)
+		{
+			fixedLimb carry=0;
+			FIXED_UNROLL
+			for(uint16_t cnt=0;cnt<words;cnt++)
+			{
+				fixedWide t=(fixedWide)_data[cnt]+src._data[cnt]+carry;
+				_data[cnt]=(fixedLimb)t;
+				carry=(fixedLimb)(t>>(8*sizeof(fixedLimb)));
+			}
+			return carry;
+		}
+		/** @brief Subtract in place
+		 * @param [in] src Integer to be subtracted
+		 * @return Borrow out of the top limb
+		 */
+		fixedLimb subtract(const fixedInteger& src)
+		{
+			fixedLimb borrow=0;
+			FIXED_UNROLL
+			for(uint16_t cnt=0;cnt<words;cnt++)
+			{
+				fixedLimb a=_data[cnt];
+				fixedLimb b=src._data[cnt];
+				_data[cnt]=a-b-borrow;
+				borrow=(a<b) || (a==b && borrow);
+			}
+			return borrow;
+		}
+
+		/** @brief Equality operator
+		 * @param [in] cmp Integer to compare against
+		 * @return true if equal
+		 */
+		bool operator==(const fixedInteger& cmp) const {return compare(cmp)==0;}
+		/** @brief Not-equals operator
+		 * @param [in] cmp Integer to compare against
+		 * @return true if not equal
+		 */
+		bool operator!=(const fixedInteger& cmp) const {return compare(cmp)!=0;}
+	};
+
+	/** @brief Fixed size Montgomery context
+	 *
+	 * Holds an odd modulus of at most Limbs uint32_t,
+	 * -n^-1 and R^2 mod n, where R=2^(32*Limbs).
+	 */
+	template <uint16_t Limbs>
+	class fixedMontgomery
+	{
+	public:
+		/** @brief Integer type of this context
+		 */
+		typedef fixedInteger<Limbs> value;
+		/** @brief Number of limbs
+		 */
+		static const uint16_t words=value::words;
+	private:
+		/** @brief Modulus
+		 */
+		value _modulus;
+		/** @brief R^2 mod n
+		 */
+		value _rSquared;
+		/** @brief -n^-1 mod 2^limb
+		 */
+		fixedLimb _nPrime;
+		/** @brief Modulus is usable
+		 */
+		bool _valid;
+
+		/** @brief Final subtraction
+		 * @param [in] src1 Value below 2n, words+1 limbs
+		 * @param [out] dest Value below n
+		 * @return void
+		 */
+		void finish(fixedLimb* src1,value& dest) const
+		{
+			fixedLimb* out=dest.data();
+			memcpy(out,src1,sizeof(fixedLimb)*words);
+			if(src1[words] || dest.compare(_modulus)>=0)
+				dest.subtract(_modulus);
+		}
+	public:
+		/** @brief Construct from modulus
+		 *
+		 * The context is only valid if mod
+		 * is odd, greater than one and no
+		 * longer than Limbs.
+		 *
+		 * @param [in] mod Modulus
+		 */
+		fixedMontgomery(const integer& mod)
+		{
+			uint16_t used=mod.usedSize();
+			_valid=used>0 && used<=Limbs && (mod[0]&1) && !(used==1 && mod[0]==1);
+			_nPrime=0;
+			if(!_valid) return;
+			_modulus.load(mod.data(),used);
+
+			//n'=-n^-1, Newton iteration doubles the correct bits
+			fixedLimb inv=_modulus.data()[0];
+			for(int cnt=0;cnt<5;cnt++)
+				inv*=2-_modulus.data()[0]*inv;
+			_nPrime=(fixedLimb)0-inv;
+
+			//R^2 mod n
+			integer r((uint16_t)(2*Limbs+1));
+			r[2*Limbs]=1;
+			r%=mod;
+			_rSquared.load(r.data(),r.size());
+		}
+
+		/** @brief Context is usable
+		 * @return crypto::fixedMontgomery::_valid
+		 */
+		bool valid() const {return _valid;}
+		/** @brief Modulus
+		 * @return crypto::fixedMontgomery::_modulus
+		 */
+		const value& modulus() const {return _modulus;}
+
+		/** @brief Montgomery multiplication
+		 *
+		 * dest=src1*src2*R^-1 mod n, interleaving
+		 * each row of the product with one limb of
+		 * reduction.  dest may alias either source.
+		 *
+		 * @param [in] src1 First factor
+		 * @param [in] src2 Second factor
+		 * @param [out] dest Product
+		 * @return void
+		 */
+		void multiply(const value& src1,const value& src2,value& dest) const
+		{
+			const fixedLimb* a=src1.data();
+			const fixedLimb* b=src2.data();
+			const fixedLimb* mod=_modulus.data();
+			fixedLimb work[words+2];
+			memset(work,0,sizeof(work));
+			for(uint16_t cnt=0;cnt<words;cnt++)
+			{
+				//work+=a*b[cnt]
+				fixedLimb carry=0;
+				FIXED_UNROLL
+				for(uint16_t cnt2=0;cnt2<words;cnt2++)
+				{
+					fixedWide t=(fixedWide)a[cnt2]*b[cnt]+work[cnt2]+carry;
+					work[cnt2]=(fixedLimb)t;
+					carry=(fixedLimb)(t>>(8*sizeof(fixedLimb)));
+				}
+				fixedWide t=(fixedWide)work[words]+carry;
+				work[words]=(fixedLimb)t;
+				work[words+1]=(fixedLimb)(t>>(8*sizeof(fixedLimb)));
+
+				//work=(work+m*n)/2^limb
+				fixedLimb m=work[0]*_nPrime;
+				t=(fixedWide)m*mod[0]+work[0];
+				carry=(fixedLimb)(t>>(8*sizeof(fixedLimb)));
+				FIXED_UNROLL
+				for(uint16_t cnt2=1;cnt2<words;cnt2++)
+				{
+					t=(fixedWide)m*mod[cnt2]+work[cnt2]+carry;
+					work[cnt2-1]=(fixedLimb)t;
+					carry=(fixedLimb)(t>>(8*sizeof(fixedLimb)));
+				}
+				t=(fixedWide)work[words]+carry;
+				work[words-1]=(fixedLimb)t;
+				work[words]=work[words+1]+(fixedLimb)(t>>(8*sizeof(fixedLimb)));
+			}
+			finish(work,dest);
+		}
+		/** @brief Montgomery squaring
+		 *
+		 * dest=src1^2*R^-1 mod n, computing each
+		 * cross product once.  dest may alias src1.
+		 *
+		 * @param [in] src1 Value to be squared
+		 * @param [out] dest Square
+		 * @return void
+		 */
+		void square(const value& src1,value& dest) const
+		{
+			const fixedLimb* a=src1.data();
+			const fixedLimb* mod=_modulus.data();
+			fixedLimb work[2*words+1];
+			memset(work,0,sizeof(work));
+
+			//Cross products once, doubled, then the diagonal
+			for(uint16_t cnt=0;cnt<words;cnt++)
+			{
+				fixedLimb carry=0;
+				FIXED_UNROLL
+				for(uint16_t cnt2=cnt+1;cnt2<words;cnt2++)
+				{
+					fixedWide t=(fixedWide)a[cnt]*a[cnt2]+work[cnt+cnt2]+carry;
+					work[cnt+cnt2]=(fixedLimb)t;
+					carry=(fixedLimb)(t>>(8*sizeof(fixedLimb)));
+				}
+				work[cnt+words]=carry;
+			}
+			fixedLimb top=0;
+			for(uint16_t cnt=0;cnt<2*words;cnt++)
+			{
+				fixedLimb next=work[cnt]>>(8*sizeof(fixedLimb)-1);
+				work[cnt]=(work[cnt]<<1)|top;
+				top=next;
+			}
+			fixedLimb carry=0;
+			for(uint16_t cnt=0;cnt<words;cnt++)
+			{
+				fixedWide t=(fixedWide)a[cnt]*a[cnt]+work[2*cnt]+carry;
+				work[2*cnt]=(fixedLimb)t;
+				t=(t>>(8*sizeof(fixedLimb)))+work[2*cnt+1];
+				work[2*cnt+1]=(fixedLimb)t;
+				carry=(fixedLimb)(t>>(8*sizeof(fixedLimb)));
+			}
+
+			//Reduce one limb at a time
+			for(uint16_t cnt=0;cnt<words;cnt++)
+			{
+				fixedLimb m=work[cnt]*_nPrime;
+				carry=0;
+				FIXED_UNROLL
+				for(uint16_t cnt2=0;cnt2<words;cnt2++)
+				{
+					fixedWide t=(fixedWide)m*mod[cnt2]+work[cnt+cnt2]+carry;
+					work[cnt+cnt2]=(fixedLimb)t;
+					carry=(fixedLimb)(t>>(8*sizeof(fixedLimb)));
+				}
+				for(uint16_t cnt2=cnt+words;carry && cnt2<=2*words;cnt2++)
+				{
+					fixedWide t=(fixedWide)work[cnt2]+carry;
+					work[cnt2]=(fixedLimb)t;
+					carry=(fixedLimb)(t>>(8*sizeof(fixedLimb)));
+				}
+			}
+			finish(work+words,dest);
+		}
+		/** @brief Modular exponentiation
+		 *
+		 * dest=base^exp mod n with a left-to-right
+		 * sliding window.  base must be below
+		 * R, input and output are in normal form.
+		 *
+		 * @param [in] base Base
+		 * @param [in] exp Little-endian exponent
+		 * @param [in] expLen Length of exp
+		 * @param [out] dest Result, may alias base
+		 * @return void
+		 */
+		void exponentiation(const value& base,const uint32_t* exp,uint16_t expLen,value& dest) const
+		{
+			value one;
+			one.data()[0]=1;
+			uint32_t bits=base10BitLength(exp,expLen);
+			if(bits==0)
+			{
+				dest=one;
+				return;
+			}
+			uint16_t window=base10WindowSize(bits,5);
+			uint32_t count=(uint32_t)1<<(window-1);
+
+			//Odd powers base, base^3, ... in Montgomery form
+			std::array<value,16> table;
+			value acc;
+			multiply(base,_rSquared,table[0]);
+			if(count>1)
+			{
+				square(table[0],acc);
+				for(uint32_t cnt=1;cnt<count;cnt++)
+					multiply(table[cnt-1],acc,table[cnt]);
+			}
+
+			//The top bit always opens a window
+			bool first=true;
+			for(int32_t cnt=(int32_t)bits-1;cnt>=0;)
+			{
+				uint32_t val=0;
+				uint16_t width=1;
+				if(exp[cnt/32]&((uint32_t)1<<(cnt%32)))
+					width=base10ExponentWindow(exp,cnt,window,&val);
+				cnt-=width;
+
+				if(first)
+				{
+					acc=table[val>>1];
+					first=false;
+					continue;
+				}
+				for(uint16_t cnt2=0;cnt2<width;cnt2++)
+					square(acc,acc);
+				if(val)
+					multiply(acc,table[val>>1],acc);
+			}
+			multiply(acc,one,dest);
+		}
+	};
+
+	/** @brief Cached modular context
+	 *
+	 * Precomputed state tied to one modulus, built
+	 * once and then shared read-only between threads.
+	 * Public keys hold one for each of their moduli.
+	 */
+	class modularContext
+	{
+	public:
+		/** @brief Virtual destructor
+		 *
+		 * Destructor must be virtual, if an object
+		 * of this type is deleted, the destructor
+		 * of the type which inherits this class should
+		 * be called.
+		 */
+		virtual ~modularContext(){}
+		/** @brief Modular exponentiation
+		 *
+		 * Computes base^exp mod n.  The result carries the
+		 * type of base and is at least as long as base.
+		 *
+		 * @param [in] base Base
+		 * @param [in] exp Little-endian exponent
+		 * @param [in] expLen Length of exp
+		 * @param [out] result base^exp mod n
+		 * @return void
+		 */
+		virtual void exponentiation(const integer& base,const uint32_t* exp,uint16_t expLen,integer& result) const=0;
+		/** @brief Build a context
+		 *
+		 * Uses the fixed size instantiation for limbs
+		 * if there is one and mod fits it, otherwise
+		 * a crypto::montgomeryModularContext.
+		 *
+		 * @param [in] mod Modulus
+		 * @param [in] limbs Instantiation, in uint32_t
+		 * @return Context, NULL if mod is even or one
+		 */
+		static os::smart_ptr<modularContext> build(const integer& mod,uint16_t limbs);
+	};
+	/** @brief Fixed size cached context
+	 *
+	 * Wraps a crypto::fixedMontgomery with
+	 * the modulus it was built from.
+	 */
+	template <uint16_t Limbs>
+	class fixedModularContext: public modularContext
+	{
+		/** @brief Modulus
+		 */
+		integer _mod;
+		/** @brief Montgomery context
+		 */
+		fixedMontgomery<Limbs> _ctx;
+	public:
+		/** @brief Construct from modulus
+		 * @param [in] mod Modulus
+		 */
+		fixedModularContext(const integer& mod):_mod(mod),_ctx(mod){}
+		/** @brief Virtual destructor
+		 */
+		virtual ~fixedModularContext(){}
+		/** @brief Context is usable
+		 * @return crypto::fixedMontgomery::valid()
+		 */
+		bool valid() const {return _ctx.valid();}
+		/** @brief Modular exponentiation
+		 * @param [in] base Base
+		 * @param [in] exp Little-endian exponent
+		 * @param [in] expLen Length of exp
+		 * @param [out] result base^exp mod n
+		 * @return void
+		 */
+		void exponentiation(const integer& base,const uint32_t* exp,uint16_t expLen,integer& result) const
+		{
+			//Montgomery form only needs the base below R
+			fixedInteger<Limbs> val;
+			if(base.usedSize()>Limbs)
+			{
+				integer reduced=base%_mod;
+				val.load(reduced.data(),reduced.size());
+			}
+			else
+				val.load(base.data(),base.size());
+			_ctx.exponentiation(val,exp,expLen,val);
+
+			uint32_t out[Limbs];
+			val.store(out,Limbs);
+			result=integer(out,Limbs);
+			result.convertType(base.typeID());
+			uint16_t targ=base.size();
+			if(_mod.size()>targ) targ=_mod.size();
+			if(result.size()<targ) result.expand(targ);
+		}
+	};
+
+	/** @brief Cached context of any size
+	 *
+	 * Holds the C Montgomery context of a
+	 * modulus without a fixed size instantiation,
+	 * so n' and R^2 mod n are computed once.
+	 * Runs on the general Base-10 kernels.
+	 */
+	class montgomeryModularContext: public modularContext
+	{
+		/** @brief Modulus
+		 */
+		integer _mod;
+		/** @brief Montgomery context, heap allocated
+		 */
+		struct montgomeryContext _ctx;
+		/** @brief Context is usable
+		 */
+		bool _valid;
+
+		/** @brief Contexts are not copied
+		 * @param [in] ctx Context
+		 */
+		montgomeryModularContext(const montgomeryModularContext& ctx);
+		/** @brief Contexts are not copied
+		 * @param [in] ctx Context
+		 * @return Reference to self
+		 */
+		montgomeryModularContext& operator=(const montgomeryModularContext& ctx);
+	public:
+		/** @brief Construct from modulus
+		 * @param [in] mod Modulus
+		 */
+		montgomeryModularContext(const integer& mod);
+		/** @brief Virtual destructor
+		 *
+		 * Frees the Montgomery context.
+		 */
+		virtual ~montgomeryModularContext();
+		/** @brief Context is usable
+		 * @return True if the modulus is odd and greater than one
+		 */
+		bool valid() const {return _valid;}
+		/** @brief Modular exponentiation
+		 * @param [in] base Base
+		 * @param [in] exp Little-endian exponent
+		 * @param [in] expLen Length of exp
+		 * @param [out] result base^exp mod n
+		 * @return void
+		 */
+		void exponentiation(const integer& base,const uint32_t* exp,uint16_t expLen,integer& result) const;
+	};
+
+	extern template class fixedInteger<8>;
+	extern template class fixedInteger<12>;
+	extern template class fixedInteger<16>;
+	extern template class fixedInteger<24>;
+	extern template class fixedInteger<32>;
+	extern template class fixedInteger<48>;
+	extern template class fixedInteger<64>;
+	extern template class fixedMontgomery<8>;
+	extern template class fixedMontgomery<12>;
+	extern template class fixedMontgomery<16>;
+	extern template class fixedMontgomery<24>;
+	extern template class fixedMontgomery<32>;
+	extern template class fixedMontgomery<48>;
+	extern template class fixedMontgomery<64>;
+	extern template class fixedModularContext<8>;
+	extern template class fixedModularContext<12>;
+	extern template class fixedModularContext<16>;
+	extern template class fixedModularContext<24>;
+	extern template class fixedModularContext<32>;
+	extern template class fixedModularContext<48>;
+	extern template class fixedModularContext<64>;
+
+	/** @brief Fixed size instantiation exists
+	 *
+	 * Instantiations cover crypto::size::public512,
+	 * crypto::size::public1024 and crypto::size::public2048
+	 * along with the half sizes of their prime factors.
+	 * 12, 24 and 48 hold the primes of three-prime keys.
+	 *
+	 * @param [in] limbs Length in uint32_t
+	 * @return true if a fixed size kernel exists for limbs
+	 */
+	bool fixedIntegerSupported(uint16_t limbs);
+	/** @brief Smallest instantiation for a length
+	 *
+	 * Moduli shorter than an instantiation run
+	 * on it unchanged, the upper limbs stay zero.
+	 *
+	 * @param [in] used Used length of the modulus, in uint32_t
+	 * @return Instantiation size in uint32_t, 0 if used is longer than all of them
+	 */
+	uint16_t fixedIntegerLimbs(uint16_t used);
+	/** @brief Fixed size modular exponentiation
+	 *
+	 * Computes base^exp mod mod on the fixedMontgomery
+	 * instantiation with limbs uint32_t.  The result
+	 * carries the type of base.
+	 *
+	 * @param [in] base Base
+	 * @param [in] exp Little-endian exponent
+	 * @param [in] expLen Length of exp
+	 * @param [in] mod Modulus
+	 * @param [in] limbs Instantiation, in uint32_t
+	 * @param [out] result base^exp mod mod
+	 * @return true if computed, false if there is no instantiation for limbs or mod does not fit it
+	 */
+	bool fixedModuloExponentiation(const integer& base,const uint32_t* exp,uint16_t expLen,const integer& mod,uint16_t limbs,integer& result);
+}
+
+#endif
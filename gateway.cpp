@@ -488,11 +488,11 @@ namespace crypto {
 			if(!selfPrimarySignatureHash || temp!=*selfPrimarySignatureHash) prim=true;
 			if(prim)
 			{
-				selfPrimarySignatureHash=os::smart_ptr<hash>(new hash(temp),os::shared_type);
 				os::smart_ptr<number> num;
 				if(temp.size()>selfPKFrame->keySize()*4) num=selfPKFrame->convert(temp.data(),selfPKFrame->keySize()*4);
 				else num=selfPKFrame->convert(temp.data(),temp.size());
 				num->data()[selfPKFrame->keySize()-1]&=(~(uint32_t)0)>>6;
+				selfPrimarySignatureHash=os::smart_ptr<hash>(new hash(std::move(temp)),os::shared_type);
 
 				size_t hist;
 				bool typ;
@@ -527,11 +527,11 @@ namespace crypto {
 				dat=oldPK->getCompCharData(chrData);
 				cpub=brotherStream->hashData(dat.get(),chrData);
 
-				selfSecondarySignatureHash=os::smart_ptr<hash>(new hash(temp),os::shared_type);
 				os::smart_ptr<number> num;
 				if(temp.size()>secondaryKeySize*4) num=oldPKSignTarg->copyConvert(temp.data(),secondaryKeySize-1);
 				else num=oldPKSignTarg->copyConvert(temp.data(),temp.size());
 				num->data()[secondaryKeySize-1]&=(~(uint32_t)0)>>6;
+				selfSecondarySignatureHash=os::smart_ptr<hash>(new hash(std::move(temp)),os::shared_type);
 
 				try
 				{
@@ -832,7 +832,7 @@ namespace crypto {
                     logError(errorPointer(new customError("Signature Failure, Primary","The brother failed to sign the hash."),os::shared_type),TIMEOUT_ERROR_STATE);
 					return NULL;
 				}
-				brotherPrimarySignatureHash=os::smart_ptr<hash>(new hash(tHash),os::shared_type);
+				brotherPrimarySignatureHash=os::smart_ptr<hash>(new hash(std::move(tHash)),os::shared_type);
 			}
 
 			//Find user, check if we already are checking a known public key
@@ -914,7 +914,7 @@ namespace crypto {
                     logError(errorPointer(new customError("Signature Failure Secondary","The brother failed to sign the hash."),os::shared_type),TIMEOUT_ERROR_STATE);
 					return NULL;
 				}
-				brotherSecondarySignatureHash=os::smart_ptr<hash>(new hash(tHash),os::shared_type);
+				brotherSecondarySignatureHash=os::smart_ptr<hash>(new hash(std::move(tHash)),os::shared_type);
 			}
 
 			//Read in our possible hash targets
@@ -1216,12 +1216,15 @@ namespace crypto {
 			logError(errorPointer(new customError("Brother Undefined","Cannot build stream when the brother is undefined"),os::shared_type));
 			return;
 		}
-		streamEstTimestamp=os::getTimestamp();
 		size_t keySize=brotherPKFrame->keySize()*sizeof(uint32_t);
 		os::smart_ptr<uint8_t> strmKey(new uint8_t[keySize],os::shared_type_array);
 		memset(strmKey.get(),0,keySize);
-		for(unsigned int i=0;i<keySize-1;++i)
-			strmKey[i]=rand();
+		if(!cryptoRandomFill(strmKey.get(),keySize-1))
+		{
+			lock.release();
+			throw errorPointer(new randomSeedError(),os::shared_type);
+		}
+		streamEstTimestamp=os::getTimestamp();
 		os::smart_ptr<number> temp=brotherPKFrame->convert(strmKey.get(),keySize);
 		strmKey=temp->getCompCharData(keySize);
 
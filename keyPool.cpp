@@ -0,0 +1,405 @@
+/**
+ * @file   keyPool.cpp
+ * @author Jonathan Bedard
+ * @date   10/18/2026
+ * @brief  Implementation of the key pool
+ * @bug No known bugs.
+ *
+ * Implements the stock of pre-generated
+ * keys and its refill thread.  Consult
+ * keyPool.h for details.
+ *
+ */
+
+///@cond INTERNAL
+
+#ifndef KEY_POOL_CPP
+#define KEY_POOL_CPP
+
+#include "keyPool.h"
+#include "publicKeyPackage.h"
+#include "binaryEncryption.h"
+#include <cstdio>
+
+namespace crypto
+{
+	//Process-wide pool
+	os::smart_ptr<keyPool> keyPool::singleton()
+	{
+		static os::smart_ptr<keyPool> _singleton(new keyPool(),os::shared_type);
+		return _singleton;
+	}
+
+	//Default constructor
+	keyPool::keyPool()
+	{
+		_stop=false;
+		_cancel=os::smart_ptr<generationToken>(new generationToken(),os::shared_type);
+		_dirty=false;
+		_keyLen=0;
+	}
+	//Stop the refill thread
+	keyPool::~keyPool() throw()
+	{
+		{
+			std::lock_guard<std::mutex> lock(_lock);
+			_stop=true;
+		}
+		_cancel->cancel();
+		_wake.notify_all();
+		if(_refill.joinable()) _refill.join();
+
+		if(!_dirty) return;
+		try{save();}
+		catch(errorPointer e){}
+	}
+
+	//Find stock by algorithm and size
+	keyPool::stock* keyPool::findStock(uint16_t algo,uint16_t sz,bool create)
+	{
+		for(size_t i=0;i<_stocks.size();++i)
+		{
+			if(_stocks[i].algorithm==algo && _stocks[i].size==sz)
+				return &_stocks[i];
+		}
+		if(!create) return NULL;
+
+		stock st;
+		st.algorithm=algo;
+		st.size=sz;
+		st.target=0;
+		_stocks.push_back(st);
+		return &_stocks.back();
+	}
+
+	//Generate keys for stocks below target
+	void keyPool::refillLoop()
+	{
+		std::unique_lock<std::mutex> lock(_lock);
+		while(!_stop)
+		{
+			//Save first, a taken key must not be loaded again
+			if(_dirty && _fileName!="")
+			{
+				lock.unlock();
+				try{save();}
+				catch(errorPointer e){logError(e);}
+				lock.lock();
+				continue;
+			}
+
+			stock* st=NULL;
+			for(size_t i=0;i<_stocks.size() && !st;++i)
+			{
+				if(_stocks[i].keys.size()<_stocks[i].target)
+					st=&_stocks[i];
+			}
+			if(!st)
+			{
+				_full.notify_all();
+				_wake.wait(lock);
+				continue;
+			}
+
+			uint16_t algo=st->algorithm;
+			uint16_t sz=st->size;
+			lock.unlock();
+
+			os::smart_ptr<publicKey> generated;
+			os::smart_ptr<publicKeyPackageFrame> pkg=publicKeyTypeBank::singleton()->findPublicKey(algo);
+			if(pkg)
+			{
+				pkg=pkg->getCopy();
+				pkg->setKeySize(sz);
+				try{generated=pkg->generateNow(_cancel);}
+				catch(errorPointer e){logError(e);}
+			}
+
+			lock.lock();
+			st=findStock(algo,sz,false);
+			if(!st || _stop) continue;
+			if(!generated)
+			{
+				//Algorithm cannot be pooled
+				st->target=0;
+				continue;
+			}
+			if(st->keys.size()<st->target)
+			{
+				st->keys.push_back(generated);
+				_dirty=true;
+			}
+		}
+	}
+
+	//Stock file
+	void keyPool::setStorage(std::string fileName,std::string password)
+	{
+		if(password=="") setStorage(fileName,NULL,0);
+		else setStorage(fileName,(unsigned char*)password.c_str(),password.length());
+	}
+	//Stock file with raw key
+	void keyPool::setStorage(std::string fileName,unsigned char* key,size_t keyLen)
+	{
+		os::smart_ptr<unsigned char> keyCopy;
+		if(key && keyLen>0)
+		{
+			keyCopy=os::smart_ptr<unsigned char>(new unsigned char[keyLen],os::shared_type_array);
+			memcpy(keyCopy.get(),key,keyLen);
+		}
+		else keyLen=0;
+
+		//A file which fails to load is not overwritten
+		std::vector<os::smart_ptr<publicKey> > keys;
+		if(fileName!="") keys=readFile(fileName,keyCopy,keyLen);
+
+		{
+			std::lock_guard<std::mutex> lock(_lock);
+			_fileName=fileName;
+			_key=keyCopy;
+			_keyLen=keyLen;
+			for(size_t i=0;i<keys.size();++i)
+				findStock(keys[i]->algorithm(),keys[i]->size(),true)->keys.push_back(keys[i]);
+			_dirty=_fileName!="";
+		}
+		_wake.notify_all();
+	}
+	//Save immediately
+	void keyPool::save()
+	{
+		//Holds the file lock from the copy, an older copy cannot be written last
+		std::lock_guard<std::mutex> fileLock(_fileLock);
+		std::vector<os::smart_ptr<publicKey> > keys;
+		std::string fileName;
+		os::smart_ptr<unsigned char> key;
+		size_t keyLen;
+		{
+			std::lock_guard<std::mutex> lock(_lock);
+			if(_fileName=="") return;
+			for(size_t i=0;i<_stocks.size();++i)
+				keys.insert(keys.end(),_stocks[i].keys.begin(),_stocks[i].keys.end());
+			fileName=_fileName;
+			key=_key;
+			keyLen=_keyLen;
+			_dirty=false;
+		}
+		writeFile(keys,fileName,key,keyLen);
+	}
+
+	//Write keys to the stock file
+	void keyPool::writeFile(const std::vector<os::smart_ptr<publicKey> >& keys,const std::string& fileName,os::smart_ptr<unsigned char> key,size_t keyLen)
+	{
+		std::string tempName=fileName+".tmp";
+		{
+			os::smart_ptr<binaryEncryptor> ben;
+			if(!key || keyLen==0) ben=os::smart_ptr<binaryEncryptor>(new binaryEncryptor(tempName,"default"),os::shared_type);
+			else ben=os::smart_ptr<binaryEncryptor>(new binaryEncryptor(tempName,key.get(),keyLen),os::shared_type);
+			if(!ben->good()) throw errorPointer(new actionOnFileError(),os::shared_type);
+
+			for(size_t i=0;i<keys.size();++i)
+			{
+				publicKey* pk=keys[i].get();
+				uint16_t sz=pk->size();
+				pk->readLock();
+
+				//Size, algorithm and timestamp
+				unsigned char header[12];
+				uint16_t dumpVal=os::to_comp_mode(sz);
+				memcpy(header,&dumpVal,2);
+				dumpVal=os::to_comp_mode(pk->algorithm());
+				memcpy(header+2,&dumpVal,2);
+				uint64_t tsTemp=os::to_comp_mode(pk->_timestamp);
+				memcpy(header+4,&tsTemp,8);
+				ben->write(header,12);
+
+				//Keys
+				os::smart_ptr<unsigned char> dumpArray(new unsigned char[2*4*sz],os::shared_type_array);
+				uint32_t ldval;
+				for(unsigned int i1=0;i1<2;i1++)
+				{
+					//Constant access, the key is shared with readers
+					const number* t;
+					if(i1==0) t=pk->n.get();
+					else t=pk->d.get();
+					for(unsigned int i2=0;i2<sz;i2++)
+					{
+						ldval=os::to_comp_mode(t->data()[i2]);
+						memcpy(dumpArray.get()+i1*4*sz+i2*4,&ldval,4);
+					}
+				}
+				ben->write(dumpArray.get(),2*4*sz);
+
+				//Key data
+				bool extended=pk->extendedKeyData();
+				size_t dataLen=pk->keyDataLength(extended);
+				uint16_t flags=0;
+				if(dataLen>0) flags|=publicKey::KEY_DATA_FLAG;
+				if(dataLen>0 && extended) flags|=publicKey::KEY_DATA_EXTENDED_FLAG;
+				dumpVal=os::to_comp_mode(flags);
+				ben->write((unsigned char*)&dumpVal,2);
+				if(dataLen>0)
+				{
+					os::smart_ptr<unsigned char> dataArray(new unsigned char[dataLen],os::shared_type_array);
+					memset(dataArray.get(),0,dataLen);
+					pk->writeKeyData(dataArray.get(),publicKey::CURRENT_INDEX,extended);
+					ben->write(dataArray.get(),dataLen);
+				}
+				pk->readUnlock();
+
+				if(!ben->good()) throw errorPointer(new actionOnFileError(),os::shared_type);
+			}
+			ben->close();
+			if(!ben->good()) throw errorPointer(new actionOnFileError(),os::shared_type);
+		}
+
+		//Replace the old stock only once written
+		if(std::rename(tempName.c_str(),fileName.c_str())!=0)
+		{
+			if(os::check_exists(fileName)) os::delete_file(fileName);
+			if(std::rename(tempName.c_str(),fileName.c_str())!=0)
+				throw errorPointer(new actionOnFileError(),os::shared_type);
+		}
+	}
+	//Read keys from the stock file
+	std::vector<os::smart_ptr<publicKey> > keyPool::readFile(const std::string& fileName,os::smart_ptr<unsigned char> key,size_t keyLen)
+	{
+		std::vector<os::smart_ptr<publicKey> > ret;
+		if(!os::check_exists(fileName)) return ret;
+
+		os::smart_ptr<binaryDecryptor> bde;
+		if(!key || keyLen==0) bde=os::smart_ptr<binaryDecryptor>(new binaryDecryptor(fileName,"default"),os::shared_type);
+		else bde=os::smart_ptr<binaryDecryptor>(new binaryDecryptor(fileName,key.get(),keyLen),os::shared_type);
+		if(!bde->good()) throw errorPointer(new actionOnFileError(),os::shared_type);
+
+		while(bde->bytesLeft()>0)
+		{
+			//Size, algorithm and timestamp
+			unsigned char header[12];
+			uint16_t dumpVal;
+			uint64_t tsTemp;
+			bde->read(header,12);
+			if(!bde->good()) throw errorPointer(new actionOnFileError(),os::shared_type);
+			memcpy(&dumpVal,header,2);
+			uint16_t sz=os::from_comp_mode(dumpVal);
+			memcpy(&dumpVal,header+2,2);
+			uint16_t algo=os::from_comp_mode(dumpVal);
+			memcpy(&tsTemp,header+4,8);
+
+			os::smart_ptr<publicKeyPackageFrame> pkg=publicKeyTypeBank::singleton()->findPublicKey(algo);
+			if(!pkg || pkg->algorithm()!=algo) throw errorPointer(new illegalAlgorithmBind("Key Pool Read"),os::shared_type);
+			pkg=pkg->getCopy();
+			pkg->setKeySize(sz);
+
+			//Keys
+			os::smart_ptr<unsigned char> dumpArray(new unsigned char[2*4*sz],os::shared_type_array);
+			os::smart_ptr<uint32_t> nArray(new uint32_t[sz],os::shared_type_array);
+			os::smart_ptr<uint32_t> dArray(new uint32_t[sz],os::shared_type_array);
+			bde->read(dumpArray.get(),2*4*sz);
+			if(!bde->good()) throw errorPointer(new actionOnFileError(),os::shared_type);
+			memcpy(nArray.get(),dumpArray.get(),4*sz);
+			memcpy(dArray.get(),dumpArray.get()+4*sz,4*sz);
+			for(unsigned int i=0;i<sz;i++)
+			{
+				nArray.get()[i]=os::from_comp_mode(nArray.get()[i]);
+				dArray.get()[i]=os::from_comp_mode(dArray.get()[i]);
+			}
+			os::smart_ptr<publicKey> pk=pkg->bindKeys(nArray.get(),dArray.get());
+			if(!pk) throw errorPointer(new illegalAlgorithmBind("Key Pool Read"),os::shared_type);
+			pk->_timestamp=os::from_comp_mode(tsTemp);
+
+			//Key data
+			bde->read((unsigned char*)&dumpVal,2);
+			if(!bde->good()) throw errorPointer(new actionOnFileError(),os::shared_type);
+			dumpVal=os::from_comp_mode(dumpVal);
+			bool extended=(dumpVal&publicKey::KEY_DATA_EXTENDED_FLAG)!=0;
+			if(dumpVal&publicKey::KEY_DATA_FLAG)
+			{
+				size_t dataLen=pk->keyDataLength(extended);
+				os::smart_ptr<unsigned char> dataArray(new unsigned char[dataLen],os::shared_type_array);
+				bde->read(dataArray.get(),dataLen);
+				if(!bde->good()) throw errorPointer(new actionOnFileError(),os::shared_type);
+				pk->writeLock();
+				pk->readKeyData(dataArray.get(),publicKey::CURRENT_INDEX,extended);
+				pk->writeUnlock();
+			}
+			ret.push_back(pk);
+		}
+		return ret;
+	}
+
+	//Set target
+	void keyPool::setStock(uint16_t algo,uint16_t sz,unsigned int count)
+	{
+		{
+			std::lock_guard<std::mutex> lock(_lock);
+			stock* st=findStock(algo,sz,count>0);
+			if(!st) return;
+			st->target=count;
+			while(st->keys.size()>count)
+			{
+				st->keys.pop_back();
+				_dirty=true;
+			}
+			if(count>0 && !_refill.joinable())
+				_refill=std::thread(&keyPool::refillLoop,this);
+		}
+		_wake.notify_all();
+	}
+	//Ready keys
+	unsigned int keyPool::stockSize(uint16_t algo,uint16_t sz)
+	{
+		std::lock_guard<std::mutex> lock(_lock);
+		stock* st=findStock(algo,sz,false);
+		if(!st) return 0;
+		return (unsigned int)st->keys.size();
+	}
+	//Block until stocks are full
+	void keyPool::waitFull()
+	{
+		std::unique_lock<std::mutex> lock(_lock);
+		while(true)
+		{
+			bool full=true;
+			for(size_t i=0;i<_stocks.size() && full;++i)
+				full=_stocks[i].keys.size()>=_stocks[i].target;
+			if(full) return;
+			_full.wait(lock);
+		}
+	}
+	//Take oldest key
+	os::smart_ptr<publicKey> keyPool::take(uint16_t algo,uint16_t sz)
+	{
+		os::smart_ptr<publicKey> ret;
+		bool stored;
+		{
+			std::lock_guard<std::mutex> lock(_lock);
+			stock* st=findStock(algo,sz,false);
+			if(!st || st->keys.empty()) return NULL;
+			ret=st->keys.front();
+			st->keys.pop_front();
+			_dirty=true;
+			stored=_fileName!="";
+		}
+
+		//A stored key is only handed out once removed from the file
+		if(stored)
+		{
+			try{save();}
+			catch(...)
+			{
+				{
+					std::lock_guard<std::mutex> lock(_lock);
+					stock* st=findStock(algo,sz,false);
+					if(st) st->keys.push_front(ret);
+				}
+				throw;
+			}
+		}
+		_wake.notify_all();
+		return ret;
+	}
+}
+
+#endif
+
+///@endcond
@@ -0,0 +1,229 @@
+/**
+ * @file   keyPool.h
+ * @author Jonathan Bedard
+ * @date   10/18/2026
+ * @brief  Stock of pre-generated public keys
+ * @bug No known bugs.
+ *
+ * Declares the pool of key pairs generated
+ * ahead of time.  A background thread keeps
+ * each stock at its target, so generating
+ * new keys takes a ready pair instead of
+ * waiting on a prime search.
+ *
+ */
+
+#ifndef KEY_POOL_H
+#define KEY_POOL_H
+
+#include "cryptoPublicKey.h"
+#include "cryptoError.h"
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace crypto
+{
+	/** @brief Pre-generated key pairs
+	 *
+	 * Holds ready keys for each algorithm and
+	 * size given a target by crypto::keyPool::setStock.
+	 * Taking a key is constant time, a background
+	 * thread replaces it.  With storage set, the
+	 * stock is saved encrypted and re-loaded across
+	 * restarts, and taking a key saves the stock.  Errors saving the stock from
+	 * the refill thread are logged.
+	 */
+	class keyPool: public errorSender
+	{
+		/** @brief Keys of one algorithm and size
+		 */
+		struct stock
+		{
+			/** @brief Public key algorithm ID
+			 */
+			uint16_t algorithm;
+			/** @brief Key size
+			 */
+			uint16_t size;
+			/** @brief Keys kept ready
+			 */
+			unsigned int target;
+			/** @brief Ready keys, oldest first
+			 */
+			std::deque<os::smart_ptr<publicKey> > keys;
+		};
+
+		/** @brief Protects the pool state
+		 */
+		std::mutex _lock;
+		/** @brief Serializes writing the stock file
+		 */
+		std::mutex _fileLock;
+		/** @brief Signals the refill thread
+		 */
+		std::condition_variable _wake;
+		/** @brief Signals waiters of full stocks
+		 */
+		std::condition_variable _full;
+		/** @brief Stocks by algorithm and size
+		 */
+		std::vector<stock> _stocks;
+		/** @brief Refill thread
+		 *
+		 * Started by the first target set.
+		 */
+		std::thread _refill;
+		/** @brief Stops the refill thread
+		 */
+		bool _stop;
+		/** @brief Cancels the key being generated on stop
+		 */
+		os::smart_ptr<generationToken> _cancel;
+		/** @brief Stock changed since last saved
+		 */
+		bool _dirty;
+		/** @brief File holding the stock, empty for none
+		 */
+		std::string _fileName;
+		/** @brief Symmetric key of the stock file
+		 */
+		os::smart_ptr<unsigned char> _key;
+		/** @brief Length of crypto::keyPool::_key
+		 */
+		size_t _keyLen;
+
+		/** @brief Find a stock
+		 *
+		 * Requires crypto::keyPool::_lock.
+		 *
+		 * @param [in] algo Public key algorithm ID
+		 * @param [in] sz Key size
+		 * @param [in] create Add the stock if missing
+		 * @return Stock, NULL if missing and not created
+		 */
+		stock* findStock(uint16_t algo,uint16_t sz,bool create);
+		/** @brief Refill thread loop
+		 * @return void
+		 */
+		void refillLoop();
+		/** @brief Write the stock file
+		 *
+		 * Writes to a temporary file which replaces
+		 * the stock file once complete.
+		 *
+		 * @param [in] keys Keys to write
+		 * @param [in] fileName Stock file
+		 * @param [in] key Symmetric key of the file
+		 * @param [in] keyLen Length of key
+		 * @return void
+		 */
+		static void writeFile(const std::vector<os::smart_ptr<publicKey> >& keys,const std::string& fileName,os::smart_ptr<unsigned char> key,size_t keyLen);
+		/** @brief Read the stock file
+		 * @param [in] fileName Stock file
+		 * @param [in] key Symmetric key of the file
+		 * @param [in] keyLen Length of key
+		 * @return Keys in the file, empty if there is no file
+		 */
+		static std::vector<os::smart_ptr<publicKey> > readFile(const std::string& fileName,os::smart_ptr<unsigned char> key,size_t keyLen);
+	public:
+		/** @brief Default constructor
+		 *
+		 * Constructs an empty pool without storage.
+		 */
+		keyPool();
+		/** @brief Virtual destructor
+		 *
+		 * Stops the refill thread, cancelling the key
+		 * being generated, and saves a changed stock.
+		 */
+		virtual ~keyPool() throw();
+
+		/** @brief Process-wide pool
+		 *
+		 * crypto::publicKeyPackage::generate and
+		 * crypto::publicRSA::generateNewKeys take
+		 * keys from this pool.
+		 *
+		 * @return Pool shared by key generation
+		 */
+		static os::smart_ptr<keyPool> singleton();
+
+		/** @brief Sets the stock file
+		 *
+		 * Loads keys saved in the file into the
+		 * pool.  The stock is saved to the file
+		 * whenever it changes.  Throws if the file
+		 * exists but cannot be read, leaving the
+		 * storage unchanged.
+		 *
+		 * @param [in] fileName Stock file, empty to stop saving
+		 * @param [in] password Password of the file
+		 * @return void
+		 */
+		void setStorage(std::string fileName,std::string password="");
+		/** @brief Sets the stock file
+		 *
+		 * Loads keys saved in the file into the
+		 * pool.  The stock is saved to the file
+		 * whenever it changes.  Throws if the file
+		 * exists but cannot be read, leaving the
+		 * storage unchanged.
+		 *
+		 * @param [in] fileName Stock file, empty to stop saving
+		 * @param [in] key Symmetric key of the file
+		 * @param [in] keyLen Length of key
+		 * @return void
+		 */
+		void setStorage(std::string fileName,unsigned char* key,size_t keyLen);
+		/** @brief Saves the stock
+		 *
+		 * The refill thread saves a changed stock
+		 * on its own, this saves it immediately.
+		 *
+		 * @return void
+		 */
+		void save();
+
+		/** @brief Sets the keys kept ready
+		 *
+		 * Keys beyond the target are discarded.
+		 *
+		 * @param [in] algo Public key algorithm ID
+		 * @param [in] sz Key size
+		 * @param [in] count Number of keys, 0 to stop keeping keys
+		 * @return void
+		 */
+		void setStock(uint16_t algo,uint16_t sz,unsigned int count);
+		/** @brief Number of ready keys
+		 * @param [in] algo Public key algorithm ID
+		 * @param [in] sz Key size
+		 * @return Keys which can be taken
+		 */
+		unsigned int stockSize(uint16_t algo,uint16_t sz);
+		/** @brief Wait for full stocks
+		 *
+		 * Blocks until every stock is at its target.
+		 *
+		 * @return void
+		 */
+		void waitFull();
+		/** @brief Take a ready key
+		 *
+		 * Removes the oldest key of the stock and
+		 * signals the refill thread to replace it.
+		 * With storage set, the stock is saved before
+		 * the key is returned, a failed save throws
+		 * and leaves the key in the stock.
+		 *
+		 * @param [in] algo Public key algorithm ID
+		 * @param [in] sz Key size
+		 * @return Generated key, NULL if the stock is empty
+		 */
+		os::smart_ptr<publicKey> take(uint16_t algo,uint16_t sz);
+	};
+}
+
+#endif
@@ -66,6 +66,44 @@ namespace crypto {
 		_messageSize=msg._messageSize;
 		_encryptionDepth=msg._encryptionDepth;
 	}
+	//Move constructor
+	message::message(message&& msg) noexcept
+	{
+		_data=msg._data;
+		_size=msg._size;
+		_messageSize=msg._messageSize;
+		_encryptionDepth=msg._encryptionDepth;
+		msg._data=NULL;
+		msg._size=0;
+		msg._messageSize=0;
+	}
+	//Copy assignment
+	message& message::operator=(const message& msg)
+	{
+		if(&msg==this) return *this;
+		uint8_t* temp=new uint8_t[msg._size];
+		memcpy(temp,msg._data,msg._size);
+		delete [] _data;
+		_data=temp;
+		_size=msg._size;
+		_messageSize=msg._messageSize;
+		_encryptionDepth=msg._encryptionDepth;
+		return *this;
+	}
+	//Move assignment
+	message& message::operator=(message&& msg) noexcept
+	{
+		if(&msg==this) return *this;
+		delete [] _data;
+		_data=msg._data;
+		_size=msg._size;
+		_messageSize=msg._messageSize;
+		_encryptionDepth=msg._encryptionDepth;
+		msg._data=NULL;
+		msg._size=0;
+		msg._messageSize=0;
+		return *this;
+	}
 	//Add string to to the message
 	bool message::pushString(std::string s)
 	{
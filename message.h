@@ -107,6 +107,24 @@ namespace crypto {
 		 * @param [in] msg Message to be copied
 		 */
 		message(const message& msg);
+		/** @brief Move constructor
+		 *
+		 * Takes the data array of msg,
+		 * leaving msg empty.
+		 *
+		 * @param [in/out] msg Message to be moved from
+		 */
+		message(message&& msg) noexcept;
+		/** @brief Copy assignment
+		 * @param [in] msg Message to be copied
+		 * @return Reference to this
+		 */
+		message& operator=(const message& msg);
+		/** @brief Move assignment
+		 * @param [in/out] msg Message to be moved from
+		 * @return Reference to this
+		 */
+		message& operator=(message&& msg) noexcept;
 		/** @brief Virtual destructor
          *
          * Destructor must be virtual, if an object
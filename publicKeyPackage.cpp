@@ -17,10 +17,69 @@
 
 #include <string>
 #include <stdint.h>
+#include <memory>
 #include "publicKeyPackage.h"
 
 namespace crypto {
     
+/*------------------------------------------------------------
+     Public Key Package Frame
+ ------------------------------------------------------------*/
+
+    //Generate on the worker pool, with future
+    std::future<os::smart_ptr<publicKey> > publicKeyPackageFrame::generateAsync(os::smart_ptr<generationToken> token) const
+    {
+        std::shared_ptr<std::promise<os::smart_ptr<publicKey> > > prom=std::make_shared<std::promise<os::smart_ptr<publicKey> > >();
+        std::future<os::smart_ptr<publicKey> > ret=prom->get_future();
+
+        //Ready keys resolve immediately
+        os::smart_ptr<publicKey> pooled;
+        try{if(!token || !token->cancelled()) pooled=keyPool::singleton()->take(algorithm(),_publicSize);}
+        catch(...)
+        {
+            prom->set_exception(std::current_exception());
+            return ret;
+        }
+        if(pooled || (token && token->cancelled()))
+        {
+            prom->set_value(pooled);
+            return ret;
+        }
+
+        os::smart_ptr<publicKeyPackageFrame> pkg=getCopy();
+        workerPool::singleton()->post([pkg,prom,token]()
+        {
+            try
+            {
+                os::smart_ptr<publicKey> gen;
+                if(pkg && (!token || !token->cancelled())) gen=pkg->generateNow(token);
+                prom->set_value(gen);
+            }
+            catch(...){prom->set_exception(std::current_exception());}
+        });
+        return ret;
+    }
+    //Generate on the worker pool, with callback
+    void publicKeyPackageFrame::generateAsync(std::function<void(os::smart_ptr<publicKey>)> callback,os::smart_ptr<generationToken> token) const
+    {
+        os::smart_ptr<publicKeyPackageFrame> pkg=getCopy();
+        workerPool::singleton()->post([pkg,callback,token]()
+        {
+            //Every failure reaches the callback as NULL
+            os::smart_ptr<publicKey> gen;
+            try
+            {
+                if(pkg && (!token || !token->cancelled()))
+                {
+                    gen=keyPool::singleton()->take(pkg->algorithm(),pkg->keySize());
+                    if(!gen) gen=pkg->generateNow(token);
+                }
+            }
+            catch(...){gen=NULL;}
+            callback(gen);
+        });
+    }
+
 /*------------------------------------------------------------
      Public Key Package
  ------------------------------------------------------------*/
@@ -14,6 +14,9 @@
 #define PUBLIC_KEY_PACKAGE_H
  
 #include "cryptoPublicKey.h"
+#include "keyPool.h"
+#include <functional>
+#include <future>
 
 namespace crypto {
     //Public key package frame
@@ -36,9 +39,17 @@ namespace crypto {
 		{publicKey::encode(code,codeLength,publicN,_publicSize);}
         virtual void encode(unsigned char* code, size_t codeLength, unsigned const char* publicN, size_t nLength) const
         {publicKey::encode(code,codeLength,publicN,nLength,_publicSize);}
+		virtual std::vector<os::smart_ptr<number> > encodeBatch(const std::vector<os::smart_ptr<number> >& codes, os::smart_ptr<number> publicN) const
+		{return publicKey::encodeBatch(codes,publicN,_publicSize);}
+		virtual void encodeBatch(unsigned char* const* codes, size_t count, size_t codeLength, os::smart_ptr<number> publicN) const
+		{publicKey::encodeBatch(codes,count,codeLength,publicN,_publicSize);}
 		
 
         virtual os::smart_ptr<publicKey> generate() const {return NULL;}
+        virtual os::smart_ptr<publicKey> generateNow(os::smart_ptr<generationToken> token=NULL) const {return NULL;}
+        //Generate on the worker pool, NULL if cancelled, callbacks run on a worker and get NULL on errors
+        std::future<os::smart_ptr<publicKey> > generateAsync(os::smart_ptr<generationToken> token=NULL) const;
+        void generateAsync(std::function<void(os::smart_ptr<publicKey>)> callback,os::smart_ptr<generationToken> token=NULL) const;
         virtual os::smart_ptr<publicKey> bindKeys(os::smart_ptr<integer> _n,os::smart_ptr<integer> _d) const {return NULL;}
         virtual os::smart_ptr<publicKey> bindKeys(uint32_t* _n,uint32_t* _d) const {return NULL;}
         
@@ -70,8 +81,18 @@ namespace crypto {
 		{pkType::encode(code,codeLength,publicN,_publicSize);}
         void encode(unsigned char* code, size_t codeLength, unsigned const char* publicN, size_t nLength) const
         {pkType::encode(code,codeLength,publicN,nLength,_publicSize);}
+		std::vector<os::smart_ptr<number> > encodeBatch(const std::vector<os::smart_ptr<number> >& codes, os::smart_ptr<number> publicN) const
+		{return pkType::encodeBatch(codes,publicN,_publicSize);}
+		void encodeBatch(unsigned char* const* codes, size_t count, size_t codeLength, os::smart_ptr<number> publicN) const
+		{pkType::encodeBatch(codes,count,codeLength,publicN,_publicSize);}
 
-		os::smart_ptr<publicKey> generate() const {return os::smart_ptr<publicKey>(new pkType(_publicSize),os::shared_type);}
+		os::smart_ptr<publicKey> generate() const
+		{
+			os::smart_ptr<publicKey> ret=keyPool::singleton()->take(pkType::staticAlgorithm(),_publicSize);
+			if(ret) return ret;
+			return os::smart_ptr<publicKey>(new pkType(_publicSize),os::shared_type);
+		}
+		os::smart_ptr<publicKey> generateNow(os::smart_ptr<generationToken> token=NULL) const {return pkType::generateNow(_publicSize,token);}
         os::smart_ptr<publicKey> bindKeys(os::smart_ptr<integer> _n,os::smart_ptr<integer> _d) const {return os::smart_ptr<publicKey>(new pkType(_n,_d,_publicSize),os::shared_type);}
         os::smart_ptr<publicKey> bindKeys(uint32_t* _n,uint32_t* _d) const {return os::smart_ptr<publicKey>(new pkType(_n,_d,_publicSize),os::shared_type);}
         os::smart_ptr<publicKey> openFile(std::string fileName,std::string password) const {return os::smart_ptr<publicKey>(new pkType(fileName,password),os::shared_type);}
@@ -43,11 +43,19 @@ using namespace crypto;
         if(_nullType->leftShift != NULL) generalTestException::throwException("NULL type left shift defined!!",locString);
         
         if(_nullType->multiplication != NULL) generalTestException::throwException("NULL type multiplication defined!!",locString);
+        if(_nullType->square != NULL) generalTestException::throwException("NULL type square defined!!",locString);
         if(_nullType->division != NULL) generalTestException::throwException("NULL type division defined!!",locString);
 		if(_nullType->modulo != NULL) generalTestException::throwException("NULL type modulo defined!!",locString);
+		if(_nullType->multiplicationFull != NULL) generalTestException::throwException("NULL type multiplicationFull defined!!",locString);
+		if(_nullType->moduloFull != NULL) generalTestException::throwException("NULL type moduloFull defined!!",locString);
+		if(_nullType->addWord != NULL) generalTestException::throwException("NULL type addWord defined!!",locString);
+		if(_nullType->mulWord != NULL) generalTestException::throwException("NULL type mulWord defined!!",locString);
+		if(_nullType->divmodWord != NULL) generalTestException::throwException("NULL type divmodWord defined!!",locString);
+		if(_nullType->modWord != NULL) generalTestException::throwException("NULL type modWord defined!!",locString);
 
 		if(_nullType->exponentiation != NULL) generalTestException::throwException("NULL type exponentiation defined!!",locString);
 		if(_nullType->moduloExponentiation != NULL) generalTestException::throwException("NULL type moduloExponentiation defined!!",locString);
+		if(_nullType->moduloExponentiationWord != NULL) generalTestException::throwException("NULL type moduloExponentiationWord defined!!",locString);
 
 		if(_nullType->gcd != NULL) generalTestException::throwException("NULL type gcd defined!!",locString);
 		if(_nullType->modInverse != NULL) generalTestException::throwException("NULL type modInverse defined!!",locString);
@@ -109,6 +117,11 @@ using namespace crypto;
             if(errorType) generalTestException::throwException("Base-10 type multiplication undefined!!",locString);
             else throw defThrow;
         }
+        if(_baseType->square == NULL)
+        {
+            if(errorType) generalTestException::throwException("Base-10 type square undefined!!",locString);
+            else throw defThrow;
+        }
         if(_baseType->division == NULL)
         {
             if(errorType) generalTestException::throwException("Base-10 type division undefined!!",locString);
@@ -119,6 +132,36 @@ using namespace crypto;
             if(errorType) generalTestException::throwException("Base-10 type modulo undefined!!",locString);
             else throw defThrow;
         }
+		if(_baseType->multiplicationFull == NULL)
+        {
+            if(errorType) generalTestException::throwException("Base-10 type multiplicationFull undefined!!",locString);
+            else throw defThrow;
+        }
+		if(_baseType->moduloFull == NULL)
+        {
+            if(errorType) generalTestException::throwException("Base-10 type moduloFull undefined!!",locString);
+            else throw defThrow;
+        }
+		if(_baseType->addWord == NULL)
+        {
+            if(errorType) generalTestException::throwException("Base-10 type addWord undefined!!",locString);
+            else throw defThrow;
+        }
+		if(_baseType->mulWord == NULL)
+        {
+            if(errorType) generalTestException::throwException("Base-10 type mulWord undefined!!",locString);
+            else throw defThrow;
+        }
+		if(_baseType->divmodWord == NULL)
+        {
+            if(errorType) generalTestException::throwException("Base-10 type divmodWord undefined!!",locString);
+            else throw defThrow;
+        }
+		if(_baseType->modWord == NULL)
+        {
+            if(errorType) generalTestException::throwException("Base-10 type modWord undefined!!",locString);
+            else throw defThrow;
+        }
 
 		if(_baseType->exponentiation == NULL)
         {
@@ -130,6 +173,11 @@ using namespace crypto;
             if(errorType) generalTestException::throwException("Base-10 type moduloExponentiation undefined!!",locString);
             else throw defThrow;
         }
+		if(_baseType->moduloExponentiationWord == NULL)
+        {
+            if(errorType) generalTestException::throwException("Base-10 type moduloExponentiationWord undefined!!",locString);
+            else throw defThrow;
+        }
 
 		if(_baseType->gcd == NULL)
         {
@@ -427,6 +475,17 @@ using namespace crypto;
         ret = _baseType->rightShift(src1,33,dest1,4);
         if(_baseType->compare(src2,dest1,4)!=0 || !ret)
             generalTestException::throwException("0:3:0:0>>33 failed!",locString);
+
+        //6:0:0:0>>1, top element
+        src1[2]=0;
+        src1[3]=6;
+        src2[0]=0;
+        src2[1]=0;
+        src2[2]=0;
+        src2[3]=3;
+        ret = _baseType->rightShift(src1,1,src1,4);
+        if(_baseType->compare(src2,src1,4)!=0 || !ret)
+            generalTestException::throwException("6:0:0:0>>1 failed!",locString);
     }
     //Multiplication test
     void base10multiplicationTest()
@@ -485,7 +544,110 @@ using namespace crypto;
 		if(ret)
 			generalTestException::throwException("Overflow 2 failed!",locString);
     }
+    //Squaring test
+    void base10squareTest()
+    {
+        struct numberType* _baseType = typeCheckBase10();
+        std::string locString = "c_cryptoTesting.cpp, base10squareTest()";
+    
+        uint32_t src1[4];
+        uint32_t src2[4];
+        uint32_t dest1[4];
+        uint32_t dest2[4];
+        int ret;
+    
+        src1[3]=0;  src1[2]=0;  src1[1]=0;  src1[0]=0;
+        src2[3]=0;  src2[2]=0;  src2[1]=0;  src2[0]=0;
+
+		//0*0
+		ret=_baseType->square(src1,dest1,4);
+        if(_baseType->compare(src1,dest1,4)!=0 || !ret)
+            generalTestException::throwException("0*0 failed!",locString);
+
+		//3*3
+		src1[0]=3;
+		src2[0]=9;
+		ret=_baseType->square(src1,dest1,4);
+        if(_baseType->compare(src2,dest1,4)!=0 || !ret)
+            generalTestException::throwException("3*3 failed!",locString);
+
+		//Carry test
+		src1[0]=(uint32_t) -1;
+		src1[1]=(uint32_t) -1;
+		src2[0]=1;
+		src2[1]=0;
+		src2[2]=(uint32_t) -2;
+		src2[3]=(uint32_t) -1;
+		ret=_baseType->square(src1,dest1,4);
+        if(_baseType->compare(src2,dest1,4)!=0 || !ret)
+            generalTestException::throwException("Carry failed!",locString);
+
+		//Match multiplication, in place
+		src1[0]=2654435761u;
+		src1[1]=40503;
+		src1[2]=0;
+		src1[3]=0;
+		ret=_baseType->multiplication(src1,src1,dest2,4);
+		ret&=_baseType->square(src1,src1,4);
+        if(_baseType->compare(src1,dest2,4)!=0 || !ret)
+            generalTestException::throwException("In place failed!",locString);
+
+		//Overflow test
+		src1[2]=1;
+		ret=_baseType->square(src1,dest1,4);
+		if(ret)
+			generalTestException::throwException("Overflow failed!",locString);
+    }
     //Division test
+    //Karatsuba test
+    void base10KaratsubaTest()
+    {
+        std::string locString = "c_cryptoTesting.cpp, base10KaratsubaTest()";
+        struct numberScratch* scratch=numberScratchThread();
+        if(!numberScratchReserve(scratch,NUMBER_SCRATCH_SIZE(256)))
+            generalTestException::throwException("Workspace reserve failed",locString);
+
+        uint32_t src1[128];
+        uint32_t src2[128];
+        uint32_t dest1[256];
+        uint32_t dest2[256];
+        uint32_t dest3[256];
+        uint32_t dest4[256];
+        uint32_t seed=1;
+        for(int cnt=0;cnt<128;cnt++)
+        {
+            seed=seed*1664525+1013904223;
+            src1[cnt]=seed;
+            seed=seed*1664525+1013904223;
+            src2[cnt]=seed;
+        }
+        src1[127]=4294967295;
+        src2[127]=4294967295;
+        uint16_t oldMultiply=base10GetKaratsubaThreshold();
+        uint16_t oldSquare=base10GetKaratsubaSquareThreshold();
+
+        uint16_t lengths[]={4,7,8,31,64,65,128};
+        for(int cnt1=0;cnt1<7;cnt1++)
+        {
+            for(int cnt2=0;cnt2<7;cnt2++)
+            {
+                uint16_t len1=lengths[cnt1];
+                uint16_t len2=lengths[cnt2];
+                base10MultiplyLimbs(src1+128-len1,len1,src2+128-len2,len2,dest1,len1+len2);
+                base10SetKaratsubaThreshold(4,4);
+                base10MultiplyFull(src1+128-len1,len1,src2+128-len2,len2,dest2,scratch);
+                base10SquareFull(src1+128-len1,len1,dest4,scratch);
+                base10SquareLimbs(src1+128-len1,len1,dest3);
+                base10SetKaratsubaThreshold(oldMultiply,oldSquare);
+                if(memcmp(dest1,dest2,sizeof(uint32_t)*(len1+len2))!=0)
+                    generalTestException::throwException("Mismatch at "+std::to_string((long long unsigned int)len1)+"x"+std::to_string((long long unsigned int)len2),locString);
+                if(memcmp(dest3,dest4,sizeof(uint32_t)*2*len1)!=0)
+                    generalTestException::throwException("Square mismatch at "+std::to_string((long long unsigned int)len1),locString);
+            }
+        }
+        if(scratch->used!=0)
+            generalTestException::throwException("Workspace not released",locString);
+    }
     void base10divisionTest()
     {
         struct numberType* _baseType = typeCheckBase10();
@@ -558,6 +720,14 @@ using namespace crypto;
 		src1[1]=0;
         if(_baseType->compare(src1,dest1,4)!=0 || !ret)
             generalTestException::throwException("0:0:2:2/0:0:1:1 failed!",locString);
+
+		//Quotient estimate too large, requires add back
+		src1[3]=2147483647;  src1[2]=2147483648;  src1[1]=0;  src1[0]=0;
+		src2[3]=0;  src2[2]=2147483648;  src2[1]=0;  src2[0]=1;
+		ret=_baseType->division(src1,src2,dest1,4);
+		src1[3]=0;  src1[2]=0;  src1[1]=0;  src1[0]=4294967294;
+        if(_baseType->compare(src1,dest1,4)!=0 || !ret)
+            generalTestException::throwException("Add back division failed!",locString);
     }
 	//Modulo
 	void base10moduloTest()
@@ -625,6 +795,14 @@ using namespace crypto;
         if(_baseType->compare(src1,dest1,4)!=0 || !ret)
             generalTestException::throwException("0:0:1:3%0:0:1:0 failed!",locString);
 
+		//Quotient estimate too large, requires add back
+		src1[3]=2147483647;  src1[2]=2147483648;  src1[1]=0;  src1[0]=0;
+		src2[3]=0;  src2[2]=2147483648;  src2[1]=0;  src2[0]=1;
+		ret=_baseType->modulo(src1,src2,dest1,4);
+		src1[3]=0;  src1[2]=2147483647;  src1[1]=4294967295;  src1[0]=2;
+        if(_baseType->compare(src1,dest1,4)!=0 || !ret)
+            generalTestException::throwException("Add back modulo failed!",locString);
+
 	}
 	//Base 10 exponentiation
 	void base10exponentiationTest()
@@ -845,10 +1023,332 @@ using namespace crypto;
 		src1[2]=0;
 		src1[3]=0;
 
+		//2^128 does not fit, but is 1 mod 2^64+1
 		src2[0]=4;
 		ret=_baseType->moduloExponentiation(src1,src2,modVal,dest1,4);
-        if(ret)
-            generalTestException::throwException("Overflow failed!",locString);
+		src1[0]=1;
+		src1[1]=0;
+        if(_baseType->compare(src1,dest1,4)!=0 || !ret)
+            generalTestException::throwException("0:0:1:0^4 failed!",locString);
+	}
+	//Base 10 Montgomery exponentiation test
+	void base10MontgomeryTest()
+	{
+		struct numberType* _baseType = typeCheckBase10();
+        std::string locString = "c_cryptoTesting.cpp, base10MontgomeryTest()";
+
+		uint32_t src1[4];
+        uint32_t src2[4];
+		uint32_t modVal[4];
+        uint32_t dest1[4];
+        uint32_t comp[4];
+        int ret;
+		struct montgomeryContext ctx;
+
+        src1[3]=0;  src1[2]=0;  src1[1]=0;  src1[0]=0;
+        src2[3]=0;  src2[2]=0;  src2[1]=0;  src2[0]=0;
+		modVal[3]=0;  modVal[2]=0;  modVal[1]=0;  modVal[0]=8;
+        comp[3]=0;  comp[2]=0;  comp[1]=0;  comp[0]=0;
+
+		//Even modulus
+		if(base10MontgomeryInit(&ctx,modVal,4,NULL))
+			generalTestException::throwException("Even modulus accepted",locString);
+		src1[0]=3;
+		src2[0]=2;
+		ret=_baseType->moduloExponentiation(src1,src2,modVal,dest1,4);
+		comp[0]=1;
+        if(_baseType->compare(comp,dest1,4)!=0 || !ret)
+            generalTestException::throwException("3^2 mod 8 failed!",locString);
+
+		//Largest 64 bit prime
+		modVal[1]=4294967295;  modVal[0]=4294967237;
+		if(!base10MontgomeryInit(&ctx,modVal,4,NULL))
+			generalTestException::throwException("Odd modulus rejected",locString);
+		if(ctx.length!=2 || (uint32_t)(ctx.nPrime*modVal[0])!=4294967295)
+			generalTestException::throwException("Invalid n'",locString);
+		base10MontgomeryFree(&ctx);
+
+		//Fermat: 0:0:1:0^(p-1) mod p
+		src1[0]=0;  src1[1]=1;
+		src2[1]=4294967295;  src2[0]=4294967236;
+		ret=_baseType->moduloExponentiation(src1,src2,modVal,dest1,4);
+        if(_baseType->compare(comp,dest1,4)!=0 || !ret)
+            generalTestException::throwException("Fermat little theorem failed!",locString);
+
+		//Base larger than modulus: (p+63)^2 mod p
+		src1[2]=1;  src1[1]=0;  src1[0]=4;
+		src2[1]=0;  src2[0]=2;
+		ret=_baseType->moduloExponentiation(src1,src2,modVal,dest1,4);
+		comp[0]=3969;
+        if(_baseType->compare(comp,dest1,4)!=0 || !ret)
+            generalTestException::throwException("Unreduced base failed!",locString);
+
+		//Output aliasing the base
+		src1[2]=0;  src1[1]=0;  src1[0]=63;
+		_baseType->moduloExponentiation(src1,src2,modVal,src1,4);
+        if(_baseType->compare(comp,src1,4)!=0)
+            generalTestException::throwException("Aliased output failed!",locString);
+	}
+	//Sliding window exponentiation
+	void base10SlidingWindowTest()
+	{
+		struct numberType* _baseType = typeCheckBase10();
+        std::string locString = "c_cryptoTesting.cpp, base10SlidingWindowTest()";
+
+		//0b10110001 from bit 7: 1011 with 4 bits, 101 with 3
+		uint32_t val;
+		uint32_t exp[8];
+		memset(exp,0,sizeof(uint32_t)*8);
+		exp[0]=177;
+		if(base10BitLength(exp,8)!=8 || base10ExponentWindow(exp,7,4,&val)!=4 || val!=11)
+			generalTestException::throwException("Window scan failed!",locString);
+		if(base10ExponentWindow(exp,7,3,&val)!=3 || val!=5 || base10ExponentWindow(exp,0,4,&val)!=1 || val!=1)
+			generalTestException::throwException("Short window scan failed!",locString);
+
+		//Fermat: 3^(p-1) mod p, p=2^127-1
+		uint32_t src1[8];
+		uint32_t modVal[8];
+		uint32_t dest1[8];
+		uint32_t comp[8];
+		memset(src1,0,sizeof(uint32_t)*8);
+		memset(modVal,0,sizeof(uint32_t)*8);
+		memset(comp,0,sizeof(uint32_t)*8);
+		modVal[3]=2147483647;  modVal[2]=4294967295;  modVal[1]=4294967295;  modVal[0]=4294967295;
+		exp[3]=2147483647;  exp[2]=4294967295;  exp[1]=4294967295;  exp[0]=4294967294;
+		src1[0]=3;
+		comp[0]=1;
+		if(!_baseType->moduloExponentiation(src1,exp,modVal,dest1,8) || _baseType->compare(comp,dest1,8)!=0)
+			generalTestException::throwException("Fermat little theorem failed!",locString);
+
+		//Even modulus: 3^(2^127-2) mod 2^64
+		memset(modVal,0,sizeof(uint32_t)*8);
+		modVal[2]=1;
+		comp[1]=2386092942u;  comp[0]=954437177;
+		if(!_baseType->moduloExponentiation(src1,exp,modVal,dest1,8) || _baseType->compare(comp,dest1,8)!=0)
+			generalTestException::throwException("Even modulus failed!",locString);
+
+		//3^40 fits, 3^41 overflows 64 bits
+		memset(exp,0,sizeof(uint32_t)*8);
+		exp[0]=40;
+		comp[1]=2830677074u;  comp[0]=689956897;
+		if(!_baseType->exponentiation(src1,exp,dest1,2) || _baseType->compare(comp,dest1,2)!=0)
+			generalTestException::throwException("3^40 failed!",locString);
+		exp[0]=41;
+		if(_baseType->exponentiation(src1,exp,dest1,2))
+			generalTestException::throwException("3^41 overflow not detected!",locString);
+	}
+	//Full width products and moduli filling the whole array
+	void base10FullWidthTest()
+	{
+		struct numberType* _baseType = typeCheckBase10();
+		struct numberType* _x64Type = buildBaseTen64Type();
+        std::string locString = "c_cryptoTesting.cpp, base10FullWidthTest()";
+
+		uint32_t src1[8];
+		uint32_t src2[8];
+		uint32_t modVal[8];
+		uint32_t dest1[16];
+		uint32_t dest2[16];
+		uint32_t seed=5;
+		for(int cnt=0;cnt<10;cnt++)
+		{
+			for(int i=0;i<8;i++)
+			{
+				seed=seed*1664525+1013904223;
+				src1[i]=seed;
+				seed=seed*1664525+1013904223;
+				src2[i]=seed;
+				seed=seed*1664525+1013904223;
+				modVal[i]=seed;
+			}
+			if(!_baseType->multiplicationFull(src1,src2,dest1,8) || !_x64Type->multiplicationFull(src1,src2,dest2,8) || memcmp(dest1,dest2,sizeof(uint32_t)*16)!=0)
+				generalTestException::throwException("Full width multiplication mismatch",locString);
+
+			//src1*src2 mod src2 is zero
+			_baseType->moduloFull(dest1,src2,src1,8);
+			if(standardUsedLength(src1,8)!=0)
+				generalTestException::throwException("Full width modulo failed",locString);
+			if(!_baseType->moduloFull(dest2,modVal,dest1,8) || !_x64Type->moduloFull(dest2,modVal,dest2,8) || memcmp(dest1,dest2,sizeof(uint32_t)*8)!=0)
+				generalTestException::throwException("Full width modulo mismatch",locString);
+		}
+
+		//p=2^127-1 fills 4 elements
+		uint32_t exp[4];
+		uint32_t comp[4];
+		modVal[3]=2147483647;  modVal[2]=4294967295;  modVal[1]=4294967295;  modVal[0]=4294967295;
+		exp[3]=2147483647;  exp[2]=4294967295;  exp[1]=4294967295;  exp[0]=4294967294;
+		memset(src1,0,sizeof(uint32_t)*4);
+		memset(comp,0,sizeof(uint32_t)*4);
+		src1[0]=3;
+		comp[0]=1;
+		if(!primeTest(modVal,10,4))
+			generalTestException::throwException("Full width prime test failed!",locString);
+		if(!_baseType->moduloExponentiation(src1,exp,modVal,dest1,4) || _baseType->compare(comp,dest1,4)!=0)
+			generalTestException::throwException("Full width Fermat failed!",locString);
+		if(!_x64Type->moduloExponentiation(src1,exp,modVal,dest1,4) || _baseType->compare(comp,dest1,4)!=0)
+			generalTestException::throwException("Full width x64 Fermat failed!",locString);
+
+		//3*3^-1 mod p is one
+		if(!_baseType->modInverse(src1,modVal,src2,4))
+			generalTestException::throwException("Full width inverse failed!",locString);
+		_baseType->multiplicationFull(src1,src2,dest1,4);
+		_baseType->moduloFull(dest1,modVal,dest1,4);
+		if(_baseType->compare(comp,dest1,4)!=0)
+			generalTestException::throwException("Full width inverse wrong!",locString);
+
+		//Even modulus 2p, 3^(p-1) is 1 mod p and mod 2
+		modVal[0]=4294967294;  modVal[3]=4294967295;
+		if(!_baseType->moduloExponentiation(src1,exp,modVal,dest1,4) || _baseType->compare(comp,dest1,4)!=0)
+			generalTestException::throwException("Full width even modulus failed!",locString);
+		if(numberScratchThread()->used!=0)
+			generalTestException::throwException("Workspace not released",locString);
+	}
+	//Word operand kernels against the full width kernels
+	void base10WordOperandTest()
+	{
+		struct numberType* _baseType = typeCheckBase10();
+        std::string locString = "c_cryptoTesting.cpp, base10WordOperandTest()";
+
+		uint32_t src1[8];
+		uint32_t word[8];
+		uint32_t dest1[8];
+		uint32_t dest2[8];
+		uint32_t rem;
+		uint32_t seed=17;
+		for(int cnt=0;cnt<20;cnt++)
+		{
+			memset(word,0,sizeof(uint32_t)*8);
+			for(int i=0;i<8;i++)
+			{
+				seed=seed*1664525+1013904223;
+				src1[i]=i<6?seed:0;
+			}
+			seed=seed*1664525+1013904223;
+			word[0]=cnt==0?0xFFFFFFFF:seed;
+
+			//Add and multiply
+			if(!_baseType->addWord(src1,word[0],dest1,8) || !_baseType->addition(src1,word,dest2,8) || memcmp(dest1,dest2,sizeof(uint32_t)*8)!=0)
+				generalTestException::throwException("Word addition mismatch",locString);
+			if(!_baseType->mulWord(src1,word[0],dest1,8) || !_baseType->multiplication(src1,word,dest2,8) || memcmp(dest1,dest2,sizeof(uint32_t)*8)!=0)
+				generalTestException::throwException("Word multiplication mismatch",locString);
+
+			//Divide and reduce
+			if(!_baseType->divmodWord(src1,word[0],dest1,&rem,8) || !_baseType->division(src1,word,dest2,8) || memcmp(dest1,dest2,sizeof(uint32_t)*8)!=0)
+				generalTestException::throwException("Word division mismatch",locString);
+			_baseType->modulo(src1,word,dest2,8);
+			if(rem!=dest2[0] || standardUsedLength(dest2,8)>1)
+				generalTestException::throwException("Word division remainder mismatch",locString);
+			rem=0;
+			if(!_baseType->modWord(src1,word[0],&rem,8) || rem!=dest2[0])
+				generalTestException::throwException("Word modulo mismatch",locString);
+
+			//In place
+			memcpy(dest1,src1,sizeof(uint32_t)*8);
+			_baseType->mulWord(dest1,word[0],dest1,8);
+			_baseType->divmodWord(dest1,word[0],dest1,&rem,8);
+			if(rem!=0 || memcmp(dest1,src1,sizeof(uint32_t)*8)!=0)
+				generalTestException::throwException("In place word operation failed",locString);
+		}
+
+		//Overflow and zero divisor
+		memset(src1,0xFF,sizeof(uint32_t)*8);
+		if(_baseType->addWord(src1,1,dest1,8))
+			generalTestException::throwException("Word addition overflow undetected",locString);
+		if(_baseType->mulWord(src1,2,dest1,8))
+			generalTestException::throwException("Word multiplication overflow undetected",locString);
+		if(_baseType->divmodWord(src1,0,dest1,&rem,8) || _baseType->modWord(src1,0,&rem,8))
+			generalTestException::throwException("Word divide by zero undetected",locString);
+	}
+	//Word exponent against the full exponent
+	void base10WordExponentTest()
+	{
+		struct numberType* _baseType = typeCheckBase10();
+		struct numberType* _x64Type = buildBaseTen64Type();
+        std::string locString = "c_cryptoTesting.cpp, base10WordExponentTest()";
+
+		uint32_t src1[16];
+		uint32_t exp[16];
+		uint32_t modVal[16];
+		uint32_t dest1[16];
+		uint32_t dest2[16];
+		uint32_t dest3[16];
+		uint32_t seed=11;
+		uint32_t exps[]={65537,0,1,2,4294967295u};
+		for(int cnt=0;cnt<20;cnt++)
+		{
+			memset(src1,0,sizeof(uint32_t)*16);
+			memset(exp,0,sizeof(uint32_t)*16);
+			memset(modVal,0,sizeof(uint32_t)*16);
+			for(int i=0;i<8;i++)
+			{
+				seed=seed*1664525+1013904223;
+				src1[i]=seed;
+				seed=seed*1664525+1013904223;
+				modVal[i]=seed;
+			}
+			//Every other modulus even
+			if(cnt%2) modVal[0]&=~(uint32_t)1;
+			else modVal[0]|=1;
+			exp[0]=exps[cnt%5];
+
+			int ret1=_baseType->moduloExponentiation(src1,exp,modVal,dest1,16);
+			int ret2=_baseType->moduloExponentiationWord(src1,exp[0],modVal,dest2,16);
+			int ret3=_x64Type->moduloExponentiationWord(src1,exp[0],modVal,dest3,16);
+			if(!ret1 || ret1!=ret2 || ret1!=ret3)
+				generalTestException::throwException("Word exponent failed, e="+std::to_string((long long unsigned int)exp[0]),locString);
+			if(memcmp(dest1,dest2,sizeof(uint32_t)*16)!=0 || memcmp(dest1,dest3,sizeof(uint32_t)*16)!=0)
+				generalTestException::throwException("Word exponent mismatch, e="+std::to_string((long long unsigned int)exp[0]),locString);
+		}
+
+		//Zero modulus
+		memset(modVal,0,sizeof(uint32_t)*16);
+		if(_baseType->moduloExponentiationWord(src1,65537,modVal,dest1,16) || _x64Type->moduloExponentiationWord(src1,65537,modVal,dest1,16))
+			generalTestException::throwException("Zero modulus not rejected!",locString);
+		if(numberScratchThread()->used!=0)
+			generalTestException::throwException("Workspace not released",locString);
+	}
+	//Scratch workspace test
+	void base10ScratchTest()
+	{
+		struct numberType* _baseType = typeCheckBase10();
+        std::string locString = "c_cryptoTesting.cpp, base10ScratchTest()";
+
+		uint32_t src1[4];
+        uint32_t src2[4];
+		uint32_t modVal[4];
+        uint32_t dest1[4];
+		struct numberScratch* scratch=numberScratchThread();
+
+        src1[3]=0;  src1[2]=0;  src1[1]=0;  src1[0]=3;
+        src2[3]=0;  src2[2]=0;  src2[1]=0;  src2[0]=7;
+		modVal[3]=0;  modVal[2]=0;  modVal[1]=4294967295;  modVal[0]=4294967237;
+
+		//First call sizes the workspace
+		_baseType->moduloExponentiation(src1,src2,modVal,dest1,4);
+		if(scratch->used!=0)
+			generalTestException::throwException("Workspace not released",locString);
+		if(scratch->size<NUMBER_SCRATCH_SIZE(4))
+			generalTestException::throwException("Workspace too small",locString);
+
+		//Later calls reuse the same memory
+		uint32_t* data=scratch->data;
+		_baseType->moduloExponentiation(src1,src2,modVal,dest1,4);
+		_baseType->modInverse(src1,modVal,dest1,4);
+		_baseType->gcd(src1,modVal,dest1,4);
+		if(scratch->data!=data || scratch->used!=0)
+			generalTestException::throwException("Workspace reallocated",locString);
+
+		//Full workspace
+		struct numberScratch local;
+		local.data=NULL;  local.size=0;  local.used=0;
+		if(!numberScratchReserve(&local,8) || !numberScratchPush(&local,8))
+			generalTestException::throwException("Local workspace failed",locString);
+		if(numberScratchPush(&local,1) || numberScratchReserve(&local,16))
+			generalTestException::throwException("Local workspace overflow",locString);
+		local.used=0;
+		if(!numberScratchReserve(&local,16))
+			generalTestException::throwException("Local workspace resize failed",locString);
+		numberScratchFree(&local);
 	}
 	//Base 10 GCD test
 	void base10GCDTest()
@@ -960,6 +1460,74 @@ using namespace crypto;
 		src1[0]=1;
 		if(_baseType->compare(src1,dest1,4)!=0 || ret)
             generalTestException::throwException("(6 mod 8)^-1 failed!",locString);
+
+		//((2^32+1) mod (3*2^32+2))^-1, multi-limb even modulus
+		src1[0]=1;  src1[1]=1;
+		src2[0]=2;  src2[1]=3;
+		ret=_baseType->modInverse(src1,src2,dest1,4);
+		src1[0]=3;  src1[1]=0;
+		if(_baseType->compare(src1,dest1,4)!=0 || !ret)
+            generalTestException::throwException("((2^32+1) mod (3*2^32+2))^-1 failed!",locString);
+	}
+	//Lehmer GCD and binary inverse against Euclid
+	void base10LargeGCDTest()
+	{
+		struct numberType* _baseType = typeCheckBase10();
+        std::string locString = "c_cryptoTesting.cpp, base10LargeGCDTest()";
+
+		uint32_t src1[16];
+		uint32_t src2[16];
+		uint32_t atrace[16];
+		uint32_t btrace[16];
+		uint32_t dest1[16];
+		uint32_t prod[32];
+		uint32_t seed=23;
+		for(int cnt=0;cnt<40;cnt++)
+		{
+			memset(src1,0,sizeof(uint32_t)*16);
+			memset(src2,0,sizeof(uint32_t)*16);
+			for(int i=0;i<12;i++)
+			{
+				seed=seed*1664525+1013904223;
+				src1[i]=seed;
+				seed=seed*1664525+1013904223;
+				src2[i]=seed;
+			}
+			if(cnt%4==0) src2[0]&=~1;
+			if(cnt%4==1)
+			{
+				//Shared factor
+				_baseType->mulWord(src1,6,src1,16);
+				_baseType->mulWord(src2,10,src2,16);
+			}
+
+			//Euclid reference
+			memcpy(atrace,src1,sizeof(uint32_t)*16);
+			memcpy(btrace,src2,sizeof(uint32_t)*16);
+			while(standardUsedLength(btrace,16)>0)
+			{
+				_baseType->modulo(atrace,btrace,atrace,16);
+				memcpy(dest1,atrace,sizeof(uint32_t)*16);
+				memcpy(atrace,btrace,sizeof(uint32_t)*16);
+				memcpy(btrace,dest1,sizeof(uint32_t)*16);
+			}
+			if(!_baseType->gcd(src1,src2,dest1,16) || _baseType->compare(atrace,dest1,16)!=0)
+				generalTestException::throwException("Lehmer GCD mismatch",locString);
+			if(!_baseType->gcd(src2,src1,dest1,16) || _baseType->compare(atrace,dest1,16)!=0)
+				generalTestException::throwException("Lehmer GCD reversed mismatch",locString);
+
+			//src1*src1^-1 mod src2 is one
+			int invertible=standardUsedLength(atrace,16)==1 && atrace[0]==1;
+			if(_baseType->modInverse(src1,src2,dest1,16)!=invertible)
+				generalTestException::throwException("Inverse existence wrong",locString);
+			if(!invertible) continue;
+			_baseType->multiplicationFull(src1,dest1,prod,16);
+			_baseType->moduloFull(prod,src2,dest1,16);
+			if(standardUsedLength(dest1,16)!=1 || dest1[0]!=1)
+				generalTestException::throwException("Inverse wrong",locString);
+		}
+		if(numberScratchThread()->used!=0)
+			generalTestException::throwException("Workspace not released",locString);
 	}
 	//Base 10 Primality test
 	void base10PrimealityTest()
@@ -1018,6 +1586,312 @@ using namespace crypto;
 		src1[0]=243407;
 		if(primeTest(src1,10,4))
 			generalTestException::throwException("243407 is not prime!",locString);
+
+		//3215031751, strong pseudoprime to bases 2, 3, 5 and 7
+		src1[0]=3215031751;
+		if(primeTest(src1,10,4))
+			generalTestException::throwException("3215031751 is not prime!",locString);
+	}
+	//Base 10 Baillie-PSW test
+	void base10BPSWTest()
+	{
+        std::string locString = "c_cryptoTesting.cpp, base10BPSWTest()";
+
+		uint32_t src1[4];
+		memset(src1,0,4*sizeof(uint32_t));
+
+		//Small values are screened
+		src1[0]=97;
+		if(!primeTestBPSW(src1,0,4))
+			generalTestException::throwException("97 is prime!",locString);
+		src1[0]=10403;
+		if(primeTestBPSW(src1,0,4))
+			generalTestException::throwException("10403 is not prime!",locString);
+
+		//Strong pseudoprimes to base 2, the last is 1093^2
+		uint32_t strong[]={3215031751,1194649,42799,85489};
+		for(int cnt=0;cnt<4;cnt++)
+		{
+			src1[0]=strong[cnt];
+			if(primeTestBPSW(src1,0,4))
+				generalTestException::throwException(std::to_string((long long unsigned int)strong[cnt])+" is not prime!",locString);
+		}
+
+		//Strong Lucas pseudoprimes
+		uint32_t lucas[]={22499,25199,40309,130139};
+		for(int cnt=0;cnt<4;cnt++)
+		{
+			src1[0]=lucas[cnt];
+			if(primeTestBPSW(src1,0,4))
+				generalTestException::throwException(std::to_string((long long unsigned int)lucas[cnt])+" is not prime!",locString);
+		}
+
+		//Mersenne prime 2^127-1
+		memset(src1,0xFF,4*sizeof(uint32_t));
+		src1[3]=0x7FFFFFFF;
+		if(!primeTestBPSW(src1,0,4))
+			generalTestException::throwException("2^127-1 is prime!",locString);
+		if(!primeTestBPSW(src1,3,4))
+			generalTestException::throwException("2^127-1 is prime with extra rounds!",locString);
+
+		//(2^61-1)*(2^31-1)
+		src1[0]=0x80000001;
+		src1[1]=0xDFFFFFFF;
+		src1[2]=0x0FFFFFFF;
+		src1[3]=0;
+		if(primeTestBPSW(src1,0,4))
+			generalTestException::throwException("(2^61-1)*(2^31-1) is not prime!",locString);
+
+		if(numberScratchThread()->used!=0)
+			generalTestException::throwException("Workspace not released",locString);
+	}
+	//ChaCha20 block, RFC 8439 section 2.3.2
+	void chacha20BlockTest()
+	{
+        std::string locString = "c_cryptoTesting.cpp, chacha20BlockTest()";
+
+		uint32_t key[8];
+		for(int cnt=0;cnt<8;cnt++)
+			key[cnt]=(uint32_t)(4*cnt)|((uint32_t)(4*cnt+1)<<8)|((uint32_t)(4*cnt+2)<<16)|((uint32_t)(4*cnt+3)<<24);
+		uint32_t nonce[3]={0x09000000,0x4a000000,0};
+		uint32_t out[16];
+		static const uint32_t expected[16]={
+			0xe4e7f110,0x15593bd1,0x1fdd0f50,0xc47120a3,
+			0xc7f4d1c7,0x0368c033,0x9aaa2204,0x4e6cd4c3,
+			0x466482d2,0x09aa9f07,0x05d7c214,0xa2028bd9,
+			0xd19c12b5,0xb94e16de,0xe883d0cb,0x4e3c50a2};
+		chacha20Block(key,1,nonce,out);
+		if(memcmp(out,expected,sizeof(expected))!=0)
+			generalTestException::throwException("Block mismatch",locString);
+	}
+	//Random fill
+	void cryptoRandomTest()
+	{
+        std::string locString = "c_cryptoTesting.cpp, cryptoRandomTest()";
+
+		uint8_t buf1[3000];
+		uint8_t buf2[3000];
+		memset(buf1,0,sizeof(buf1));
+		memset(buf2,0,sizeof(buf2));
+		if(!cryptoRandomSeed(buf1,32))
+			generalTestException::throwException("No system entropy",locString);
+		if(!cryptoRandomFill(buf1,sizeof(buf1)))
+			generalTestException::throwException("Weak seed",locString);
+
+		//Odd sized pieces, crossing buffer refills
+		size_t pos=0;
+		for(size_t len=1;pos<sizeof(buf2);len+=7)
+		{
+			size_t take=len<sizeof(buf2)-pos?len:sizeof(buf2)-pos;
+			cryptoRandomFill(buf2+pos,take);
+			pos+=take;
+		}
+		if(memcmp(buf1,buf2,sizeof(buf1))==0)
+			generalTestException::throwException("Repeated output",locString);
+
+		//Every byte value should appear in 6000 bytes
+		uint32_t counts[256];
+		memset(counts,0,sizeof(counts));
+		for(size_t cnt=0;cnt<sizeof(buf1);cnt++)
+		{
+			counts[buf1[cnt]]++;
+			counts[buf2[cnt]]++;
+		}
+		for(int cnt=0;cnt<256;cnt++)
+		{
+			if(counts[cnt]==0 || counts[cnt]>60)
+				generalTestException::throwException("Skewed output at "+std::to_string((long long unsigned int)cnt),locString);
+		}
+		uint32_t words[4];
+		if(!cryptoRandomFill(words,sizeof(words)))
+			generalTestException::throwException("Word fill failed",locString);
+		if(words[0]==words[1] && words[2]==words[3])
+			generalTestException::throwException("Repeated words",locString);
+	}
+	//Base 10 prime sieve
+	void base10SieveTest()
+	{
+        std::string locString = "c_cryptoTesting.cpp, base10SieveTest()";
+
+		uint16_t primes[600];
+		uint16_t count=base10SmallPrimes(primes,600,4096);
+		if(count!=563 || primes[0]!=3 || primes[1]!=5 || primes[count-1]!=4093)
+			generalTestException::throwException("Small prime table failed!",locString);
+		if(base10SmallPrimes(primes,10,4096)!=10 || primes[9]!=31)
+			generalTestException::throwException("Small prime table limit failed!",locString);
+
+		//Base 2^40+1, two intervals checked by trial division
+		uint32_t src1[4];
+		src1[3]=0;  src1[2]=0;  src1[1]=256;  src1[0]=1;
+		uint16_t residues[600];
+		uint8_t sieve[500];
+		count=base10SmallPrimes(primes,600,4096);
+		base10SieveResidues(src1,4,primes,count,residues);
+		uint64_t base=((uint64_t)1<<40)+1;
+		for(int interval=0;interval<2;interval++)
+		{
+			base10SieveInterval(residues,primes,count,sieve,500);
+			for(uint32_t i=0;i<500;i++)
+			{
+				uint64_t cand=base+2*i;
+				uint8_t composite=0;
+				for(uint16_t cnt=0;cnt<count && !composite;cnt++)
+					composite=(cand%primes[cnt]==0);
+				if(sieve[i]!=composite)
+					generalTestException::throwException("Sieve mismatch at "+std::to_string((long long unsigned int)cand),locString);
+			}
+			base+=1000;
+		}
+	}
+	//64-bit limb kernels against base-10
+	void base10x64Test()
+	{
+        std::string locString = "c_cryptoTesting.cpp, base10x64Test()";
+		struct numberType* _baseType = buildBaseTenType();
+		struct numberType* _x64Type = buildBaseTen64Type();
+		if(_x64Type->typeID != crypto::numberType::Base10x64) generalTestException::throwException("Base-10 x64 type ID wrong!",locString);
+		if(std::string(_x64Type->name) != numberName::Base10x64) generalTestException::throwException("Base-10 x64 type name wrong!",locString);
+
+		uint32_t src1[32];
+		uint32_t src2[32];
+		uint32_t dest1[32];
+		uint32_t dest2[32];
+		uint32_t seed=7;
+		uint16_t lengths[]={1,2,3,5,8,17,32};
+		std::string names[]={"Multiplication","Squaring","Division","Modulo","Odd modular exponentiation","Even modular exponentiation"};
+		for(int cnt=0;cnt<7;cnt++)
+		{
+			uint16_t length=lengths[cnt];
+			uint16_t used[]={1,(uint16_t)(length/2+1),length};
+			for(int cnt1=0;cnt1<9;cnt1++)
+			{
+				memset(src1,0,sizeof(uint32_t)*32);
+				memset(src2,0,sizeof(uint32_t)*32);
+				for(uint16_t i=0;i<used[cnt1/3];i++)
+				{
+					seed=seed*1664525+1013904223;
+					src1[i]=seed;
+				}
+				for(uint16_t i=0;i<used[cnt1%3];i++)
+				{
+					seed=seed*1664525+1013904223;
+					src2[i]=seed;
+				}
+
+				for(int op=0;op<6;op++)
+				{
+					int ret1=0;
+					int ret2=0;
+					if(op==4) src2[0]|=1;
+					if(op==5) src2[0]&=~(uint32_t)1;
+					if(op==0)
+					{
+						ret1=_baseType->multiplication(src1,src2,dest1,length);
+						ret2=_x64Type->multiplication(src1,src2,dest2,length);
+					}
+					else if(op==1)
+					{
+						ret1=_baseType->square(src1,dest1,length);
+						ret2=_x64Type->square(src1,dest2,length);
+					}
+					else if(op==2)
+					{
+						ret1=_baseType->division(src1,src2,dest1,length);
+						ret2=_x64Type->division(src1,src2,dest2,length);
+					}
+					else if(op==3)
+					{
+						ret1=_baseType->modulo(src1,src2,dest1,length);
+						ret2=_x64Type->modulo(src1,src2,dest2,length);
+					}
+					else
+					{
+						ret1=_baseType->moduloExponentiation(src1,src1,src2,dest1,length);
+						ret2=_x64Type->moduloExponentiation(src1,src1,src2,dest2,length);
+					}
+					if(ret1!=ret2 || memcmp(dest1,dest2,sizeof(uint32_t)*length)!=0)
+						generalTestException::throwException(names[op]+" mismatch at length "+std::to_string((long long unsigned int)length),locString);
+				}
+			}
+		}
+
+		//Output aliasing the inputs
+		src1[1]=0;  src1[0]=3;
+		src2[1]=0;  src2[0]=5;
+		_x64Type->multiplication(src1,src2,src1,2);
+		_x64Type->square(src1,src1,2);
+		if(src1[0]!=225 || src1[1]!=0)
+			generalTestException::throwException("Aliased output failed!",locString);
+
+		if(numberScratchThread()->used!=0)
+			generalTestException::throwException("Workspace not released",locString);
+	}
+
+	//Runs the linear kernels on one set of inputs
+	static void vectorKernelPass(const uint32_t* src1, const uint32_t* src2, uint16_t length, uint16_t shift, uint32_t* out, int* rets)
+	{
+		rets[0]=standardCompare(src1,src2,length);
+		rets[1]=standardUsedLength(src1,length);
+		rets[2]=standardRightShift(src1,shift,out,length);
+		rets[3]=standardLeftShift(src1,shift,out+length,length);
+		memcpy(out+2*length,src1,sizeof(uint32_t)*length);
+		standardRightShift(out+2*length,shift,out+2*length,length);
+		memcpy(out+3*length,src1,sizeof(uint32_t)*length);
+		rets[4]=standardLeftShift(out+3*length,shift,out+3*length,length);
+		standardOr(src1,src2,out+4*length,length);
+		standardAnd(src1,src2,out+5*length,length);
+		standardXor(src1,src2,out+6*length,length);
+		standardNot(src1,out+7*length,length);
+	}
+	//Vector and scalar kernels agree
+	void vectorKernelTest()
+	{
+		std::string locString = "c_cryptoTesting.cpp, vectorKernelTest()";
+		int level=numberVectorLevel();
+		if(numberVectorSupported()==NUMBER_VECTOR_SCALAR)
+		{
+			if(numberVectorSetLevel(NUMBER_VECTOR_AVX2))
+				generalTestException::throwException("Unsupported level accepted!",locString);
+			return;
+		}
+
+		uint32_t src1[80];
+		uint32_t src2[80];
+		uint32_t out1[8*80];
+		uint32_t out2[8*80];
+		int rets1[5];
+		int rets2[5];
+		uint32_t seed=11;
+		uint16_t lengths[]={1,7,8,9,16,17,31,64,80};
+		uint16_t shifts[]={0,1,31,32,33,95,257,2600};
+		for(int cnt=0;cnt<9;cnt++)
+		{
+			uint16_t length=lengths[cnt];
+			for(int cnt1=0;cnt1<8;cnt1++)
+			{
+				for(uint16_t i=0;i<length;i++)
+				{
+					seed=seed*1664525+1013904223;
+					src1[i]=seed;
+					src2[i]=seed;
+				}
+
+				//Differ at one element, zero a run at the top
+				seed=seed*1664525+1013904223;
+				src2[seed%length]^=1<<(seed%32);
+				seed=seed*1664525+1013904223;
+				for(uint16_t i=length-seed%(length+1);i<length;i++)
+					src1[i]=0;
+
+				numberVectorSetLevel(NUMBER_VECTOR_SCALAR);
+				vectorKernelPass(src1,src2,length,shifts[cnt1],out1,rets1);
+				numberVectorSetLevel(NUMBER_VECTOR_AVX2);
+				vectorKernelPass(src1,src2,length,shifts[cnt1],out2,rets2);
+				numberVectorSetLevel(level);
+				if(memcmp(rets1,rets2,sizeof(rets1))!=0 || memcmp(out1,out2,sizeof(uint32_t)*8*length)!=0)
+					generalTestException::throwException("Vector mismatch at length "+std::to_string((long long unsigned int)length),locString);
+			}
+		}
 	}
 
 /*================================================================
@@ -1036,13 +1910,28 @@ using namespace crypto;
         pushTest("Right Shift",&base10rightShiftTest);
         pushTest("Left Shift",&base10leftShiftTest);
         pushTest("Multiplication",&base10multiplicationTest);
+        pushTest("Squaring",&base10squareTest);
+        pushTest("Karatsuba",&base10KaratsubaTest);
         pushTest("Division",&base10divisionTest);
 		pushTest("Modulo",&base10moduloTest);
 		pushTest("Exponentiation",&base10exponentiationTest);
 		pushTest("Modular Exponentiation",&base10modularExponentiationTest);
+		pushTest("Montgomery Exponentiation",&base10MontgomeryTest);
+		pushTest("Sliding Window",&base10SlidingWindowTest);
+		pushTest("Word Operand",&base10WordOperandTest);
+		pushTest("Word Exponent",&base10WordExponentTest);
+		pushTest("Full Width",&base10FullWidthTest);
+		pushTest("Scratch Workspace",&base10ScratchTest);
 		pushTest("GCD",&base10GCDTest);
 		pushTest("Modular Inverse",&base10ModularInverseTest);
+		pushTest("Large GCD",&base10LargeGCDTest);
 		pushTest("Prime Testing",&base10PrimealityTest);
+		pushTest("BPSW",&base10BPSWTest);
+		pushTest("Prime Sieve",&base10SieveTest);
+		pushTest("ChaCha20",&chacha20BlockTest);
+		pushTest("Random Fill",&cryptoRandomTest);
+		pushTest("64-bit Limbs",&base10x64Test);
+		pushTest("Vector Kernels",&vectorKernelTest);
     }
 
 #endif
@@ -0,0 +1,85 @@
+/**
+ * @file   test/cryptoBenchmark.cpp
+ * @author Jonathan Bedard
+ * @date   10/18/2026
+ * @brief  Benchmarks tuning the Base-Ten suite
+ * @bug No known bugs.
+ *
+ * Times schoolbook arithmetic against one
+ * level of Karatsuba to find the lengths
+ * passed to base10SetKaratsubaThreshold(...).
+ * Built as its own executable, timings do
+ * not belong in the unit tests.
+ *
+ */
+
+///@cond INTERNAL
+
+#ifndef CRYPTO_BENCHMARK_CPP
+#define CRYPTO_BENCHMARK_CPP
+
+#include "../cryptoCHeaders.h"
+#include <ctime>
+#include <iostream>
+
+	//Fastest of several timings of one length
+	static clock_t timeLength(uint16_t len,bool square,bool karatsuba,const uint32_t* src1,const uint32_t* src2,uint32_t* dest,struct numberScratch* scratch)
+	{
+		if(karatsuba) base10SetKaratsubaThreshold(square?65535:len,square?len:65535);
+		else base10SetKaratsubaThreshold(65535,65535);
+
+		int iterations=2000000/(len*len)+16;
+		clock_t best=0;
+		for(int rep=0;rep<5;rep++)
+		{
+			clock_t start=clock();
+			for(int it=0;it<iterations;it++)
+			{
+				if(square) base10SquareFull(src1,len,dest,scratch);
+				else base10MultiplyFull(src1,len,src2,len,dest,scratch);
+			}
+			clock_t elapsed=clock()-start;
+			if(rep==0 || elapsed<best) best=elapsed;
+		}
+		return best;
+	}
+	//Karatsuba crossover
+	int main()
+	{
+		struct numberScratch* scratch=numberScratchThread();
+		numberScratchReserve(scratch,NUMBER_SCRATCH_SIZE(256));
+		uint16_t oldMultiply=base10GetKaratsubaThreshold();
+		uint16_t oldSquare=base10GetKaratsubaSquareThreshold();
+
+		uint32_t src1[128];
+		uint32_t src2[128];
+		uint32_t dest[256];
+		for(int cnt=0;cnt<128;cnt++)
+		{
+			src1[cnt]=(uint32_t)cnt*2654435761u;
+			src2[cnt]=(uint32_t)cnt*2246822519u;
+		}
+
+		//Crossover is the shortest length Karatsuba wins from then on
+		uint16_t lengths[]={8,16,24,32,48,64,96,128};
+		for(int sq=0;sq<2;sq++)
+		{
+			uint16_t crossover=0;
+			std::cout<<(sq?"Squaring":"Multiplication")<<std::endl;
+			for(int cnt=0;cnt<8;cnt++)
+			{
+				clock_t schoolbook=timeLength(lengths[cnt],sq!=0,false,src1,src2,dest,scratch);
+				clock_t karatsuba=timeLength(lengths[cnt],sq!=0,true,src1,src2,dest,scratch);
+				std::cout<<"\t"<<lengths[cnt]<<" uint32_t: "<<schoolbook<<" schoolbook, "<<karatsuba<<" Karatsuba"<<std::endl;
+				if(karatsuba<schoolbook && !crossover) crossover=lengths[cnt];
+				else if(karatsuba>=schoolbook) crossover=0;
+			}
+			std::cout<<"\tCrossover: "<<crossover<<" uint32_t"<<std::endl;
+		}
+		base10SetKaratsubaThreshold(oldMultiply,oldSquare);
+		return 0;
+	}
+
+#endif
+
+///@endcond
@@ -18,6 +18,7 @@
 
 #include "cryptoTest.h"
 #include "../cryptoNumber.h"
+#include "../fixedInteger.h"
 
 using namespace test;
 using namespace os;
@@ -697,6 +698,172 @@ using namespace crypto;
             }
         }
     }
+    //Integer used size test
+    void integerUsedSizeTest()
+    {
+        std::string locString = "cryptoNumberTest.cpp, integerUsedSizeTest()";
+        integer int1(64);
+        integer int2(64);
+        
+        //Zero and element writes
+        if(int1.usedSize()!=0)
+            generalTestException::throwException("Zero used size failed!",locString);
+        int1[1]=5;
+        if(int1.usedSize()!=2)
+            generalTestException::throwException("Write used size failed!",locString);
+        int1[1]=0;
+        int1[0]=0xFFFFFFFF;
+        if(int1.usedSize()!=1)
+            generalTestException::throwException("Clear used size failed!",locString);
+        
+        //Small values in large integers
+        int2[0]=1;
+        integer sum=int1+int2;
+        if(sum.size()!=64 || sum.usedSize()!=2 || sum[1]!=1 || sum[0]!=0)
+            generalTestException::throwException("Addition carry failed!",locString);
+        if(sum.compare(&int1)!=1 || !(int1<sum))
+            generalTestException::throwException("Compare failed!",locString);
+        integer prod=sum*sum;
+        if(prod.size()!=64 || prod.usedSize()!=3 || prod[2]!=1)
+            generalTestException::throwException("Multiplication failed!",locString);
+        integer shift=prod<<40;
+        if(shift.usedSize()!=4 || shift[3]!=(1<<8))
+            generalTestException::throwException("Left shift failed!",locString);
+        shift=shift>>104;
+        if(shift.usedSize()!=1 || shift[0]!=1)
+            generalTestException::throwException("Right shift failed!",locString);
+        
+        //Results reuse a larger target
+        prod-=prod;
+        if(prod.size()!=64 || prod.usedSize()!=0 || prod!=integer())
+            generalTestException::throwException("Subtraction to zero failed!",locString);
+    }
+    //Inline storage test
+    void integerInlineStorageTest()
+    {
+        std::string locString = "cryptoNumberTest.cpp, integerInlineStorageTest()";
+        integer small(CRYPTO_NUMBER_INLINE_LIMBS);
+        integer large(CRYPTO_NUMBER_INLINE_LIMBS+1);
+        const char* lowSmall=(const char*)&small;
+        const char* lowLarge=(const char*)&large;
+        
+        //Storage location by size
+        if((const char*)small.data()<lowSmall || (const char*)small.data()>=lowSmall+sizeof(integer))
+            generalTestException::throwException("Small integer not inline!",locString);
+        if((const char*)large.data()>=lowLarge && (const char*)large.data()<lowLarge+sizeof(integer))
+            generalTestException::throwException("Large integer inline!",locString);
+        
+        //Growing past the inline storage keeps the value
+        small[CRYPTO_NUMBER_INLINE_LIMBS-1]=7;
+        small[0]=3;
+        small.expand(CRYPTO_NUMBER_INLINE_LIMBS+4);
+        if((const char*)small.data()>=lowSmall && (const char*)small.data()<lowSmall+sizeof(integer))
+            generalTestException::throwException("Expanded integer inline!",locString);
+        if(small[0]!=3 || small[CRYPTO_NUMBER_INLINE_LIMBS-1]!=7 || small[CRYPTO_NUMBER_INLINE_LIMBS]!=0)
+            generalTestException::throwException("Expand failed!",locString);
+        
+        //Reduce moves back inline
+        small[CRYPTO_NUMBER_INLINE_LIMBS-1]=0;
+        small.reduce();
+        if(small.size()!=1 || small[0]!=3)
+            generalTestException::throwException("Reduce failed!",locString);
+        if((const char*)small.data()<lowSmall || (const char*)small.data()>=lowSmall+sizeof(integer))
+            generalTestException::throwException("Reduced integer not inline!",locString);
+        
+        //Copies own their storage
+        large[CRYPTO_NUMBER_INLINE_LIMBS]=9;
+        integer copy1(large);
+        integer copy2=small;
+        copy1[CRYPTO_NUMBER_INLINE_LIMBS]=1;
+        copy2[0]=1;
+        if(large[CRYPTO_NUMBER_INLINE_LIMBS]!=9 || small[0]!=3)
+            generalTestException::throwException("Copy shared storage!",locString);
+        copy2=large;
+        copy1=small;
+        if(copy2!=large || copy1!=small || copy1.size()!=1)
+            generalTestException::throwException("Assignment failed!",locString);
+    }
+    //Integer move test
+    void integerMoveTest()
+    {
+        std::string locString = "cryptoNumberTest.cpp, integerMoveTest()";
+        integer large(CRYPTO_NUMBER_INLINE_LIMBS+1);
+        large[CRYPTO_NUMBER_INLINE_LIMBS]=5;
+        large[0]=2;
+        const uint32_t* heap=large.data();
+        
+        //Heap storage is taken, not copied
+        integer moved(std::move(large));
+        if(moved.data()!=heap || moved[CRYPTO_NUMBER_INLINE_LIMBS]!=5 || moved[0]!=2)
+            generalTestException::throwException("Move construction failed!",locString);
+        if(large!=integer::zero())
+            generalTestException::throwException("Moved from integer not zero!",locString);
+        integer assigned;
+        assigned=std::move(moved);
+        if(assigned.data()!=heap)
+            generalTestException::throwException("Move assignment failed!",locString);
+        
+        //Inline storage is copied
+        uint32_t arrA[]={0x23456789,0x89abcdef,0x01234567,0x10};
+        uint32_t arrB[]={0x87654321,0x0fedcba9};
+        integer small(arrA,4);
+        integer smallMoved(std::move(small));
+        if(smallMoved!=integer(arrA,4) || smallMoved.data()==small.data())
+            generalTestException::throwException("Inline move failed!",locString);
+        
+        //Temporaries give the same results as named operands
+        integer a(arrA,4);
+        integer b(arrB,2);
+        integer prod=a*b;
+        if((a*b)+b!=prod+b || (a*b)-b!=prod-b)
+            generalTestException::throwException("Temporary addition failed!",locString);
+        if(integer(a)*b!=prod || integer(prod)/b!=a || (prod+integer::one())%b!=integer::one())
+            generalTestException::throwException("Temporary multiplication failed!",locString);
+    }
+    //Integer word operand test
+    void integerWordOperandTest()
+    {
+        std::string locString = "cryptoNumberTest.cpp, integerWordOperandTest()";
+        
+        //Shared constants
+        if(integer::zero()!=integer() || integer::one()[0]!=1 || integer::two()[0]!=2)
+            generalTestException::throwException("Constant values wrong!",locString);
+        if(&integer::one()!=&integer::one())
+            generalTestException::throwException("Constant not shared!",locString);
+        
+        for(int i=0;i<20;++i)
+        {
+            integer src1;
+            integer src2;
+            generateIntegers(src1, src2);
+            uint32_t word=src2[0]|1;
+            integer wordInt(&word,1);
+            
+            if(src1+word!=src1+wordInt)
+                generalTestException::throwException("Word addition failed!",locString);
+            if(src1*word!=src1*wordInt)
+                generalTestException::throwException("Word multiplication failed!",locString);
+            if(src1/word!=src1/wordInt)
+                generalTestException::throwException("Word division failed!",locString);
+            integer rem=src1%wordInt;
+            if(src1%word!=rem[0])
+                generalTestException::throwException("Word modulo failed!",locString);
+            
+            integer cpy(src1);
+            cpy*=word;
+            cpy+=word;
+            cpy/=word;
+            if(cpy!=src1+integer::one())
+                generalTestException::throwException("Word equals operators failed!",locString);
+        }
+        
+        //Carry into a new element
+        uint32_t top=0xFFFFFFFF;
+        integer int1(&top,1);
+        int1=int1*(uint32_t)2;
+        if(int1.size()!=2 || int1[1]!=1 || int1[0]!=0xFFFFFFFE)
+            generalTestException::throwException("Word multiplication growth failed!",locString);
+    }
     //Integer addition test
     void integerAdditionTest()
     {
@@ -718,6 +885,14 @@ using namespace crypto;
         if(int1!=int2)
             generalTestException::throwException("Variable size failed!",locString);
         
+        //Product grows past the operand size
+        integer wide(2);
+        wide[0]=0xFFFFFFFF;
+        wide[1]=0xFFFFFFFF;
+        wide=wide*wide;
+        if(wide.size()!=4 || wide[0]!=1 || wide[1]!=0 || wide[2]!=0xFFFFFFFE || wide[3]!=0xFFFFFFFF)
+            generalTestException::throwException("Full width failed!",locString);
+        
         //Run compare tests, 20 iterations
         for(int i=0;i<20;++i)
         {
@@ -766,6 +941,14 @@ using namespace crypto;
         if(int1!=int2)
             generalTestException::throwException("Variable size failed!",locString);
         
+        //Product grows past the operand size
+        integer wide(2);
+        wide[0]=0xFFFFFFFF;
+        wide[1]=0xFFFFFFFF;
+        wide=wide*wide;
+        if(wide.size()!=4 || wide[0]!=1 || wide[1]!=0 || wide[2]!=0xFFFFFFFE || wide[3]!=0xFFFFFFFF)
+            generalTestException::throwException("Full width failed!",locString);
+        
         //Run compare tests, 20 iterations
         for(int i=0;i<20;++i)
         {
@@ -921,6 +1104,14 @@ using namespace crypto;
         if(int1!=int2)
             generalTestException::throwException("Variable size failed!",locString);
         
+        //Product grows past the operand size
+        integer wide(2);
+        wide[0]=0xFFFFFFFF;
+        wide[1]=0xFFFFFFFF;
+        wide=wide*wide;
+        if(wide.size()!=4 || wide[0]!=1 || wide[1]!=0 || wide[2]!=0xFFFFFFFE || wide[3]!=0xFFFFFFFF)
+            generalTestException::throwException("Full width failed!",locString);
+        
         //Run compare tests, 20 iterations
         for(int i=0;i<20;++i)
         {
@@ -968,6 +1159,14 @@ using namespace crypto;
         if(int1!=int2)
             generalTestException::throwException("Variable size failed!",locString);
         
+        //Product grows past the operand size
+        integer wide(2);
+        wide[0]=0xFFFFFFFF;
+        wide[1]=0xFFFFFFFF;
+        wide=wide*wide;
+        if(wide.size()!=4 || wide[0]!=1 || wide[1]!=0 || wide[2]!=0xFFFFFFFE || wide[3]!=0xFFFFFFFF)
+            generalTestException::throwException("Full width failed!",locString);
+        
         //Run compare tests, 20 iterations
         for(int i=0;i<20;++i)
         {
@@ -1017,6 +1216,14 @@ using namespace crypto;
         if(int1!=int2)
             generalTestException::throwException("Variable size failed!",locString);
         
+        //Product grows past the operand size
+        integer wide(2);
+        wide[0]=0xFFFFFFFF;
+        wide[1]=0xFFFFFFFF;
+        wide=wide*wide;
+        if(wide.size()!=4 || wide[0]!=1 || wide[1]!=0 || wide[2]!=0xFFFFFFFE || wide[3]!=0xFFFFFFFF)
+            generalTestException::throwException("Full width failed!",locString);
+        
         //Run compare tests, 20 iterations
         for(int i=0;i<20;++i)
         {
@@ -1066,6 +1273,14 @@ using namespace crypto;
         if(int1!=int2)
             generalTestException::throwException("Variable size failed!",locString);
         
+        //Product grows past the operand size
+        integer wide(2);
+        wide[0]=0xFFFFFFFF;
+        wide[1]=0xFFFFFFFF;
+        wide=wide*wide;
+        if(wide.size()!=4 || wide[0]!=1 || wide[1]!=0 || wide[2]!=0xFFFFFFFE || wide[3]!=0xFFFFFFFF)
+            generalTestException::throwException("Full width failed!",locString);
+        
         //Run compare tests, 20 iterations
         for(int i=0;i<20;++i)
         {
@@ -1119,6 +1334,14 @@ using namespace crypto;
         if(int1!=int2)
             generalTestException::throwException("Variable size failed!",locString);
         
+        //Product grows past the operand size
+        integer wide(2);
+        wide[0]=0xFFFFFFFF;
+        wide[1]=0xFFFFFFFF;
+        wide=wide*wide;
+        if(wide.size()!=4 || wide[0]!=1 || wide[1]!=0 || wide[2]!=0xFFFFFFFE || wide[3]!=0xFFFFFFFF)
+            generalTestException::throwException("Full width failed!",locString);
+        
         //Run compare tests, 20 iterations
         for(int i=0;i<20;++i)
         {
@@ -1147,6 +1370,90 @@ using namespace crypto;
                 generalTestException::throwException("Op= failed",locString);
         }
     }
+    //Fixed size integer test
+    void integerFixedSizeTest()
+    {
+        std::string locString = "cryptoNumberTest.cpp, integerFixedSizeTest()";
+        const uint16_t sizes[]={8,12,16,24,32,48,64};
+        
+        //Compare against the general kernels
+        for(int i=0;i<7;++i)
+        {
+            uint16_t limbs=sizes[i];
+            integer mod(limbs);
+            integer base(2*limbs);
+            integer exp(limbs);
+            for(uint16_t j=0;j<limbs;++j)
+            {
+                mod[j]=rand();
+                base[j]=rand();
+                base[j+limbs]=rand();
+                exp[j]=rand();
+            }
+            mod[0]|=1;
+            mod[limbs-1]|=0x80000000;
+            
+            integer ans;
+            if(!fixedModuloExponentiation(base,exp.data(),limbs,mod,limbs,ans))
+                generalTestException::throwException("Fixed size rejected!",locString);
+            if(ans!=base.moduloExponentiation(exp,mod))
+                generalTestException::throwException("Fixed size failed, "+std::to_string(limbs)+" limbs!",locString);
+            uint32_t word=65537;
+            if(!fixedModuloExponentiation(base,&word,1,mod,limbs,ans) || ans!=base.moduloExponentiation(word,mod))
+                generalTestException::throwException("Fixed size word failed, "+std::to_string(limbs)+" limbs!",locString);
+
+            //Shorter moduli run on the same instantiation
+            integer shortMod(mod);
+            shortMod[limbs-1]=0;
+            shortMod[limbs-2]|=0x80000000;
+            if(fixedIntegerLimbs(shortMod.usedSize())!=limbs)
+                generalTestException::throwException("Wrong instantiation for short modulus!",locString);
+            if(!fixedModuloExponentiation(base,exp.data(),limbs,shortMod,limbs,ans) || ans!=base.moduloExponentiation(exp,shortMod))
+                generalTestException::throwException("Short modulus failed, "+std::to_string(limbs)+" limbs!",locString);
+            
+            //Even moduli have no Montgomery form
+            mod[0]&=~(uint32_t)1;
+            if(fixedModuloExponentiation(base,exp.data(),limbs,mod,limbs,ans))
+                generalTestException::throwException("Even modulus accepted!",locString);
+        }
+        
+        //Only instantiated sizes are dispatched
+        integer mod(20);
+        mod[0]=3;
+        integer ans;
+        if(fixedIntegerSupported(20) || fixedModuloExponentiation(mod,mod.data(),20,mod,20,ans))
+            generalTestException::throwException("Unsupported size accepted!",locString);
+        if(!fixedIntegerSupported(size::public2048))
+            generalTestException::throwException("2048 bit keys unsupported!",locString);
+
+        //Other sizes build a general context
+        const uint16_t generalSizes[]={20,65,128};
+        for(int i=0;i<3;++i)
+        {
+            uint16_t limbs=generalSizes[i];
+            integer genMod(limbs);
+            integer base(limbs+3);
+            integer exp(4);
+            for(uint16_t j=0;j<limbs;++j)
+                genMod[j]=rand();
+            for(uint16_t j=0;j<limbs+3;++j)
+                base[j]=rand();
+            for(uint16_t j=0;j<4;++j)
+                exp[j]=rand();
+            genMod[0]|=1;
+            genMod[limbs-1]|=0x80000000;
+
+            os::smart_ptr<modularContext> ctx=modularContext::build(genMod,limbs);
+            if(!ctx)
+                generalTestException::throwException("General context rejected, "+std::to_string(limbs)+" limbs!",locString);
+            ctx->exponentiation(base,exp.data(),4,ans);
+            if(ans!=base.moduloExponentiation(exp,genMod))
+                generalTestException::throwException("General context failed, "+std::to_string(limbs)+" limbs!",locString);
+            genMod[0]&=~(uint32_t)1;
+            if(modularContext::build(genMod,limbs))
+                generalTestException::throwException("Even general modulus accepted!",locString);
+        }
+    }
     //Integer gcd test
     void integerGCDTest()
     {
@@ -1169,6 +1476,14 @@ using namespace crypto;
         if(int1!=int2)
             generalTestException::throwException("Variable size failed!",locString);
         
+        //Product grows past the operand size
+        integer wide(2);
+        wide[0]=0xFFFFFFFF;
+        wide[1]=0xFFFFFFFF;
+        wide=wide*wide;
+        if(wide.size()!=4 || wide[0]!=1 || wide[1]!=0 || wide[2]!=0xFFFFFFFE || wide[3]!=0xFFFFFFFF)
+            generalTestException::throwException("Full width failed!",locString);
+        
         //Run compare tests, 20 iterations
         for(int i=0;i<20;++i)
         {
@@ -1218,6 +1533,14 @@ using namespace crypto;
         if(int1!=int2)
             generalTestException::throwException("Variable size failed!",locString);
         
+        //Product grows past the operand size
+        integer wide(2);
+        wide[0]=0xFFFFFFFF;
+        wide[1]=0xFFFFFFFF;
+        wide=wide*wide;
+        if(wide.size()!=4 || wide[0]!=1 || wide[1]!=0 || wide[2]!=0xFFFFFFFE || wide[3]!=0xFFFFFFFF)
+            generalTestException::throwException("Full width failed!",locString);
+        
         //Run compare tests, 20 iterations
         for(int i=0;i<20;++i)
         {
@@ -1270,7 +1593,17 @@ using namespace crypto;
             //ans1 is the ref value
             if(ans1!=ans2)
                 generalTestException::throwException("OO function failed!",locString);
+            if(src1.prime(0,crypto::algo::primeBPSW)!=ans1)
+                generalTestException::throwException("BPSW mode failed!",locString);
         }
+
+        //Mersenne prime 2^127-1
+        uint32_t mersenneData[]={0xFFFFFFFF,0xFFFFFFFF,0xFFFFFFFF,0x7FFFFFFF};
+        integer mersenne(mersenneData,4);
+        if(!mersenne.prime(0,crypto::algo::primeBPSW) || !mersenne.prime(2,crypto::algo::primeMillerRabin))
+            generalTestException::throwException("2^127-1 is prime!",locString);
+        if(mersenne.prime(crypto::algo::primeTestCycle,7))
+            generalTestException::throwException("Unknown mode accepted!",locString);
     }
 
 /*================================================================
@@ -1300,6 +1633,10 @@ using namespace crypto;
     {
         pushTest("Type",&integerTypeTest);
         pushTest("Integer Compare",&integerCompareTest);
+        pushTest("Used Size",&integerUsedSizeTest);
+        pushTest("Word Operand",&integerWordOperandTest);
+        pushTest("Inline Storage",&integerInlineStorageTest);
+        pushTest("Move",&integerMoveTest);
         pushTest("Addition",&integerAdditionTest);
         pushTest("Subtraction",&integerSubtractionTest);
         pushTest("Increment",&integerIncrementTest);
@@ -1310,6 +1647,7 @@ using namespace crypto;
         pushTest("Modulo",&integerModuloTest);
         pushTest("Exponentiation",&integerExponentiationTest);
         pushTest("Modulo Exponentiation",&integerModuloExponentiationTest);
+        pushTest("Fixed Size",&integerFixedSizeTest);
         pushTest("GCD",&integerGCDTest);
         pushTest("Modulo Inverse",&integerModInverseTest);
         pushTest("Prime",&integerPrimeTest);
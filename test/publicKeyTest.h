@@ -20,8 +20,12 @@
 
 #include "UnitTest/UnitTest.h"
 #include "../publicKeyPackage.h"
+#include "../binaryEncryption.h"
 #include "../cryptoPublicKey.h"
 #include "testKeyGeneration.h"
+#include <condition_variable>
+#include <future>
+#include <mutex>
 
 namespace test
 {
@@ -266,6 +270,558 @@ namespace test
 		}
 	};
 
+	//RSA CRT decode test
+	class RSACRTTest:public singleTest
+	{
+	public:
+		RSACRTTest():singleTest("CRT Decode"){}
+		virtual ~RSACRTTest(){}
+
+		void test()
+		{
+			std::string locString = "publicKeyTest.h, RSACRTTest::test()";
+
+			try
+			{
+				crypto::publicRSA pk(crypto::size::public256);
+				while(!pk.getN()) os::sleep(50);
+				if(!pk.getCRT())
+					throw os::smart_ptr<std::exception>(new generalTestException("Generated key has no CRT parameters",locString),os::shared_type);
+
+				//Decode over the full modulus
+				crypto::publicRSA slowKey((uint32_t*)pk.getN()->data(),(uint32_t*)pk.getD()->data(),crypto::size::public256);
+				if(slowKey.getCRT())
+					throw os::smart_ptr<std::exception>(new generalTestException("Key without primes has CRT parameters",locString),os::shared_type);
+
+				crypto::integer n1(crypto::size::public256);
+				for(uint16_t i=0;i<crypto::size::public256-1;++i)
+					n1[i]=rand();
+				os::smart_ptr<crypto::number> en1=pk.encode(os::smart_ptr<crypto::number>(new crypto::integer(n1),os::shared_type));
+				if(*pk.decode(en1)!=*slowKey.decode(en1))
+					throw os::smart_ptr<std::exception>(new generalTestException("CRT and full decode do not match",locString),os::shared_type);
+				if(*os::cast<crypto::integer,crypto::number>(pk.decode(en1))!=n1)
+					throw os::smart_ptr<std::exception>(new generalTestException("CRT decode failed",locString),os::shared_type);
+
+				//Parameters move to history
+				pk.addKeyPair(slowKey.getN(),slowKey.getD());
+				if(pk.getCRT() || !pk.getCRT(0))
+					throw os::smart_ptr<std::exception>(new generalTestException("CRT parameters not bound to history",locString),os::shared_type);
+				if(*os::cast<crypto::integer,crypto::number>(pk.decode(en1,0))!=n1)
+					throw os::smart_ptr<std::exception>(new generalTestException("Historical CRT decode failed",locString),os::shared_type);
+
+				//Save and load
+				pk.setFileName("crttest.dmp");
+				pk.save();
+				crypto::publicRSA readKey("crttest.dmp");
+				if(readKey.getCRT() || !readKey.getCRT(0))
+					throw os::smart_ptr<std::exception>(new generalTestException("CRT parameters failed to load",locString),os::shared_type);
+				if(*os::cast<crypto::integer,crypto::number>(readKey.decode(en1,0))!=n1)
+					throw os::smart_ptr<std::exception>(new generalTestException("Loaded CRT decode failed",locString),os::shared_type);
+
+				//A file without key data replaces the CRT parameters
+				{
+					crypto::binaryEncryptor ben("crttest.dmp","default");
+					uint16_t dumpVal=os::to_comp_mode((uint16_t)crypto::size::public256);
+					ben.write((unsigned char*)&dumpVal,2);
+					dumpVal=os::to_comp_mode(pk.algorithm());
+					ben.write((unsigned char*)&dumpVal,2);
+					uint64_t tsTemp=os::to_comp_mode(pk.timestamp());
+					ben.write((unsigned char*)&tsTemp,8);
+					for(unsigned int i1=0;i1<2;i1++)
+					{
+						os::smart_ptr<crypto::number> t=i1==0?slowKey.getN():slowKey.getD();
+						for(uint16_t i2=0;i2<crypto::size::public256;i2++)
+						{
+							uint32_t ldval=os::to_comp_mode(t->data()[i2]);
+							ben.write((unsigned char*)&ldval,4);
+						}
+					}
+					dumpVal=0;
+					ben.write((unsigned char*)&dumpVal,2);
+					ben.close();
+				}
+				crypto::publicRSA stale(crypto::size::public256);
+				while(!stale.getN()) os::sleep(50);
+				stale.setFileName("crttest.dmp");
+				stale.loadFile();
+				if(stale.getCRT() || stale.getCRT(0))
+					throw os::smart_ptr<std::exception>(new generalTestException("Stale CRT parameters kept on load",locString),os::shared_type);
+				if(*os::cast<crypto::integer,crypto::number>(stale.decode(en1))!=n1)
+					throw os::smart_ptr<std::exception>(new generalTestException("Decode after load failed",locString),os::shared_type);
+			}
+			catch(crypto::errorPointer e)
+			{
+				if(os::check_exists("crttest.dmp"))
+					os::delete_file("crttest.dmp");
+				throw os::smart_ptr<std::exception>(new generalTestException(e->errorTitle(),e->errorDescription()),os::shared_type);
+			}
+			catch(os::smart_ptr<std::exception> e)
+			{
+				if(os::check_exists("crttest.dmp"))
+					os::delete_file("crttest.dmp");
+				throw e;
+			}
+			catch(...)
+			{
+				if(os::check_exists("crttest.dmp"))
+					os::delete_file("crttest.dmp");
+				throw os::smart_ptr<std::exception>(new unknownException(locString),os::shared_type);
+			}
+			if(os::check_exists("crttest.dmp")) os::delete_file("crttest.dmp");
+		}
+	};
+	//RSA cached context test
+	class RSAContextTest:public singleTest
+	{
+	public:
+		RSAContextTest():singleTest("Cached Context"){}
+		virtual ~RSAContextTest(){}
+
+		void test()
+		{
+			std::string locString = "publicKeyTest.h, RSAContextTest::test()";
+
+			try
+			{
+				crypto::publicRSA gen(crypto::size::public512);
+				while(!gen.getN()) os::sleep(50);
+
+				//Without primes, every decode runs on the modulus context
+				crypto::publicRSA pk((uint32_t*)gen.getN()->data(),(uint32_t*)gen.getD()->data(),crypto::size::public512);
+				pk.setHistory(3);
+				crypto::integer n1(crypto::size::public512);
+				for(uint16_t i=0;i<crypto::size::public512-1;++i)
+					n1[i]=rand();
+				os::smart_ptr<crypto::number> en1=pk.encode(os::smart_ptr<crypto::number>(new crypto::integer(n1),os::shared_type));
+				if(*os::cast<crypto::integer,crypto::number>(pk.decode(en1))!=n1)
+					throw os::smart_ptr<std::exception>(new generalTestException("Current decode failed",locString),os::shared_type);
+
+				//Contexts follow keys through the history
+				gen.generateNewKeys();
+				while(gen.generating()) os::sleep(50);
+				pk.addKeyPair(gen.getN(),gen.getD());
+				os::smart_ptr<crypto::number> en2=pk.encode(os::smart_ptr<crypto::number>(new crypto::integer(n1),os::shared_type));
+				if(*os::cast<crypto::integer,crypto::number>(pk.decode(en1,0))!=n1)
+					throw os::smart_ptr<std::exception>(new generalTestException("Historical decode failed",locString),os::shared_type);
+				if(*os::cast<crypto::integer,crypto::number>(pk.decode(en2))!=n1)
+					throw os::smart_ptr<std::exception>(new generalTestException("Decode after key change failed",locString),os::shared_type);
+
+				pk.addKeyPair(pk.getOldN(0),pk.getOldD(0));
+				if(*os::cast<crypto::integer,crypto::number>(pk.decode(en1))!=n1)
+					throw os::smart_ptr<std::exception>(new generalTestException("Re-added key decode failed",locString),os::shared_type);
+				if(*os::cast<crypto::integer,crypto::number>(pk.decode(en2,0))!=n1 || *os::cast<crypto::integer,crypto::number>(pk.decode(en1,1))!=n1)
+					throw os::smart_ptr<std::exception>(new generalTestException("Rotated historical decode failed",locString),os::shared_type);
+			}
+			catch(crypto::errorPointer e)
+			{
+				throw os::smart_ptr<std::exception>(new generalTestException(e->errorTitle(),e->errorDescription()),os::shared_type);
+			}
+		}
+	};
+
+	//RSA multi-prime test
+	class RSAMultiPrimeTest:public singleTest
+	{
+	public:
+		RSAMultiPrimeTest():singleTest("Multi-Prime"){}
+		virtual ~RSAMultiPrimeTest(){}
+
+		void test()
+		{
+			std::string locString = "publicKeyTest.h, RSAMultiPrimeTest::test()";
+			unsigned int oldCount=crypto::publicRSA::primeCount();
+
+			try
+			{
+				if(crypto::publicRSA::setPrimeCount(1) || crypto::publicRSA::setPrimeCount(crypto::publicRSA::MAX_PRIMES+1))
+					throw os::smart_ptr<std::exception>(new generalTestException("Invalid prime count accepted",locString),os::shared_type);
+				crypto::publicRSA::setPrimeCount(3);
+				crypto::publicRSA pk(crypto::size::public1024);
+				while(!pk.getN()) os::sleep(50);
+				crypto::publicRSA::setPrimeCount(oldCount);
+				if(!pk.getCRT() || pk.getCRT()->primes()!=3)
+					throw os::smart_ptr<std::exception>(new generalTestException("Generated key does not have three primes",locString),os::shared_type);
+				if(!(pk.getN()->data()[crypto::size::public1024-1]&0x80000000))
+					throw os::smart_ptr<std::exception>(new generalTestException("Multi-prime modulus is short",locString),os::shared_type);
+
+				//Matches the full modulus
+				crypto::publicRSA slowKey((uint32_t*)pk.getN()->data(),(uint32_t*)pk.getD()->data(),crypto::size::public1024);
+				crypto::integer n1(crypto::size::public1024);
+				for(uint16_t i=0;i<crypto::size::public1024-1;++i)
+					n1[i]=rand();
+				os::smart_ptr<crypto::number> en1=pk.encode(os::smart_ptr<crypto::number>(new crypto::integer(n1),os::shared_type));
+				if(*pk.decode(en1)!=*slowKey.decode(en1))
+					throw os::smart_ptr<std::exception>(new generalTestException("Multi-prime and full decode do not match",locString),os::shared_type);
+				if(*os::cast<crypto::integer,crypto::number>(pk.decode(en1))!=n1)
+					throw os::smart_ptr<std::exception>(new generalTestException("Multi-prime decode failed",locString),os::shared_type);
+
+				//Extra primes persist
+				pk.setFileName("mptest.dmp");
+				pk.save();
+				crypto::publicRSA readKey("mptest.dmp");
+				if(!readKey.getCRT() || readKey.getCRT()->primes()!=3)
+					throw os::smart_ptr<std::exception>(new generalTestException("Primes failed to load",locString),os::shared_type);
+				if(*os::cast<crypto::integer,crypto::number>(readKey.decode(en1))!=n1)
+					throw os::smart_ptr<std::exception>(new generalTestException("Loaded multi-prime decode failed",locString),os::shared_type);
+			}
+			catch(crypto::errorPointer e)
+			{
+				crypto::publicRSA::setPrimeCount(oldCount);
+				if(os::check_exists("mptest.dmp"))
+					os::delete_file("mptest.dmp");
+				throw os::smart_ptr<std::exception>(new generalTestException(e->errorTitle(),e->errorDescription()),os::shared_type);
+			}
+			catch(os::smart_ptr<std::exception> e)
+			{
+				crypto::publicRSA::setPrimeCount(oldCount);
+				if(os::check_exists("mptest.dmp"))
+					os::delete_file("mptest.dmp");
+				throw e;
+			}
+			if(os::check_exists("mptest.dmp")) os::delete_file("mptest.dmp");
+		}
+	};
+
+	//RSA large key test
+	class RSALargeKeyTest:public singleTest
+	{
+	public:
+		RSALargeKeyTest():singleTest("Large Keys"){}
+		virtual ~RSALargeKeyTest(){}
+
+		void test()
+		{
+			std::string locString = "publicKeyTest.h, RSALargeKeyTest::test()";
+			unsigned int oldCount=crypto::publicRSA::primeCount();
+
+			try
+			{
+				//Four primes keep 4096-bit generation short
+				crypto::publicRSA::setPrimeCount(4);
+				crypto::publicRSA pk(crypto::size::public4096);
+				while(!pk.getN()) os::sleep(50);
+				crypto::publicRSA::setPrimeCount(oldCount);
+				if(!pk.getCRT() || pk.getCRT()->primes()!=4)
+					throw os::smart_ptr<std::exception>(new generalTestException("Generated key does not have four primes",locString),os::shared_type);
+				if(!(pk.getN()->data()[crypto::size::public4096-1]&0x80000000))
+					throw os::smart_ptr<std::exception>(new generalTestException("4096-bit modulus is short",locString),os::shared_type);
+
+				//Full modulus uses the generic Montgomery context
+				crypto::publicRSA slowKey((uint32_t*)pk.getN()->data(),(uint32_t*)pk.getD()->data(),crypto::size::public4096);
+				crypto::integer n1(crypto::size::public4096);
+				for(uint16_t i=0;i<crypto::size::public4096-1;++i)
+					n1[i]=rand();
+				os::smart_ptr<crypto::number> en1=pk.encode(os::smart_ptr<crypto::number>(new crypto::integer(n1),os::shared_type));
+				if(*slowKey.encode(os::smart_ptr<crypto::number>(new crypto::integer(n1),os::shared_type))!=*en1)
+					throw os::smart_ptr<std::exception>(new generalTestException("4096-bit encodes do not match",locString),os::shared_type);
+				if(*os::cast<crypto::integer,crypto::number>(pk.decode(en1))!=n1)
+					throw os::smart_ptr<std::exception>(new generalTestException("4096-bit CRT decode failed",locString),os::shared_type);
+				if(*os::cast<crypto::integer,crypto::number>(slowKey.decode(en1))!=n1)
+					throw os::smart_ptr<std::exception>(new generalTestException("4096-bit full decode failed",locString),os::shared_type);
+
+				//4096-bit key file
+				pk.setFileName("largetest.dmp");
+				pk.save();
+				crypto::publicRSA readKey("largetest.dmp");
+				if(readKey.size()!=crypto::size::public4096 || *readKey.getN()!=*pk.getN() || *readKey.getD()!=*pk.getD())
+					throw os::smart_ptr<std::exception>(new generalTestException("4096-bit key failed to load",locString),os::shared_type);
+				if(!readKey.getCRT() || readKey.getCRT()->primes()!=4)
+					throw os::smart_ptr<std::exception>(new generalTestException("4096-bit primes failed to load",locString),os::shared_type);
+				if(*os::cast<crypto::integer,crypto::number>(readKey.decode(en1))!=n1)
+					throw os::smart_ptr<std::exception>(new generalTestException("Loaded 4096-bit decode failed",locString),os::shared_type);
+				os::delete_file("largetest.dmp");
+
+				//8192-bit key file, generation is too slow for a unit test
+				crypto::integer n8(crypto::size::public8192);
+				crypto::integer d8(crypto::size::public8192);
+				for(uint16_t i=0;i<crypto::size::public8192;++i)
+				{
+					n8[i]=rand();
+					d8[i]=rand();
+				}
+				n8[0]|=1;
+				n8[crypto::size::public8192-1]|=0x80000000;
+				crypto::publicRSA bigKey(n8.data(),d8.data(),crypto::size::public8192);
+				bigKey.setFileName("largetest.dmp");
+				bigKey.save();
+				crypto::publicRSA readBig("largetest.dmp");
+				if(readBig.size()!=crypto::size::public8192 || *readBig.getN()!=n8 || *readBig.getD()!=d8)
+					throw os::smart_ptr<std::exception>(new generalTestException("8192-bit key failed to load",locString),os::shared_type);
+				crypto::integer n2(crypto::size::public8192);
+				for(uint16_t i=0;i<crypto::size::public8192-1;++i)
+					n2[i]=rand();
+				if(*readBig.encode(os::smart_ptr<crypto::number>(new crypto::integer(n2),os::shared_type))!=*bigKey.encode(os::smart_ptr<crypto::number>(new crypto::integer(n2),os::shared_type)))
+					throw os::smart_ptr<std::exception>(new generalTestException("8192-bit encodes do not match",locString),os::shared_type);
+			}
+			catch(crypto::errorPointer e)
+			{
+				crypto::publicRSA::setPrimeCount(oldCount);
+				if(os::check_exists("largetest.dmp"))
+					os::delete_file("largetest.dmp");
+				throw os::smart_ptr<std::exception>(new generalTestException(e->errorTitle(),e->errorDescription()),os::shared_type);
+			}
+			catch(os::smart_ptr<std::exception> e)
+			{
+				crypto::publicRSA::setPrimeCount(oldCount);
+				if(os::check_exists("largetest.dmp"))
+					os::delete_file("largetest.dmp");
+				throw e;
+			}
+			if(os::check_exists("largetest.dmp")) os::delete_file("largetest.dmp");
+		}
+	};
+
+	//Encode and decode a random code
+	static bool roundTrip(crypto::publicKey& pk)
+	{
+		crypto::integer n1(pk.size());
+		for(uint16_t i=0;i<pk.size()-1;++i)
+			n1[i]=rand();
+		os::smart_ptr<crypto::number> en1=pk.encode(os::smart_ptr<crypto::number>(new crypto::integer(n1),os::shared_type));
+		return *os::cast<crypto::integer,crypto::number>(pk.decode(en1))==n1;
+	}
+	//RSA key pool test
+	class RSAKeyPoolTest:public singleTest
+	{
+	public:
+		RSAKeyPoolTest():singleTest("Key Pool"){}
+		virtual ~RSAKeyPoolTest(){}
+
+		void test()
+		{
+			std::string locString = "publicKeyTest.h, RSAKeyPoolTest::test()";
+			os::smart_ptr<crypto::keyPool> pool=crypto::keyPool::singleton();
+
+			try
+			{
+				//Generation takes ready keys
+				pool->setStock(crypto::algo::publicRSA,crypto::size::public256,2);
+				pool->waitFull();
+				if(pool->stockSize(crypto::algo::publicRSA,crypto::size::public256)!=2)
+					throw os::smart_ptr<std::exception>(new generalTestException("Stock not filled",locString),os::shared_type);
+				crypto::publicRSA pk(crypto::size::public256);
+				if(pk.generating() || !pk.getN() || !pk.getCRT())
+					throw os::smart_ptr<std::exception>(new generalTestException("Pooled key not bound",locString),os::shared_type);
+				if(!roundTrip(pk))
+					throw os::smart_ptr<std::exception>(new generalTestException("Pooled key decode failed",locString),os::shared_type);
+				crypto::publicKeyPackage<crypto::publicRSA> pkg(crypto::size::public256);
+				os::smart_ptr<crypto::publicKey> gen=pkg.generate();
+				if(!gen || gen->generating() || !gen->getN())
+					throw os::smart_ptr<std::exception>(new generalTestException("Package did not take a pooled key",locString),os::shared_type);
+				pool->setStock(crypto::algo::publicRSA,crypto::size::public256,0);
+
+				//Stock persists
+				{
+					crypto::keyPool saving;
+					saving.setStorage("pooltest.dmp","password");
+					saving.setStock(crypto::algo::publicRSA,crypto::size::public256,2);
+					saving.waitFull();
+					saving.save();
+				}
+				crypto::keyPool loading;
+				loading.setStorage("pooltest.dmp","password");
+				if(loading.stockSize(crypto::algo::publicRSA,crypto::size::public256)!=2)
+					throw os::smart_ptr<std::exception>(new generalTestException("Stock failed to load",locString),os::shared_type);
+				os::smart_ptr<crypto::publicRSA> loaded=os::cast<crypto::publicRSA,crypto::publicKey>(loading.take(crypto::algo::publicRSA,crypto::size::public256));
+				if(!loaded || !loaded->getCRT() || !roundTrip(*loaded))
+					throw os::smart_ptr<std::exception>(new generalTestException("Loaded key decode failed",locString),os::shared_type);
+				loading.take(crypto::algo::publicRSA,crypto::size::public256);
+				if(loading.take(crypto::algo::publicRSA,crypto::size::public256))
+					throw os::smart_ptr<std::exception>(new generalTestException("Took from an empty stock",locString),os::shared_type);
+
+				//Taken keys leave the file before the pool is destroyed
+				{
+					crypto::keyPool saving;
+					saving.setStorage("pooltest.dmp","password");
+					saving.setStock(crypto::algo::publicRSA,crypto::size::public256,2);
+					saving.waitFull();
+					saving.save();
+				}
+				crypto::keyPool taking;
+				taking.setStorage("pooltest.dmp","password");
+				if(!taking.take(crypto::algo::publicRSA,crypto::size::public256))
+					throw os::smart_ptr<std::exception>(new generalTestException("Stored key not taken",locString),os::shared_type);
+				crypto::keyPool reloaded;
+				reloaded.setStorage("pooltest.dmp","password");
+				if(reloaded.stockSize(crypto::algo::publicRSA,crypto::size::public256)!=1)
+					throw os::smart_ptr<std::exception>(new generalTestException("Taken key still stored",locString),os::shared_type);
+
+				//Wrong password
+				bool thrown=false;
+				crypto::keyPool wrong;
+				try{wrong.setStorage("pooltest.dmp","wrong");}
+				catch(crypto::errorPointer e){thrown=true;}
+				if(!thrown)
+					throw os::smart_ptr<std::exception>(new generalTestException("Wrong password accepted",locString),os::shared_type);
+			}
+			catch(crypto::errorPointer e)
+			{
+				pool->setStock(crypto::algo::publicRSA,crypto::size::public256,0);
+				if(os::check_exists("pooltest.dmp"))
+					os::delete_file("pooltest.dmp");
+				throw os::smart_ptr<std::exception>(new generalTestException(e->errorTitle(),e->errorDescription()),os::shared_type);
+			}
+			catch(os::smart_ptr<std::exception> e)
+			{
+				pool->setStock(crypto::algo::publicRSA,crypto::size::public256,0);
+				if(os::check_exists("pooltest.dmp"))
+					os::delete_file("pooltest.dmp");
+				throw e;
+			}
+			if(os::check_exists("pooltest.dmp")) os::delete_file("pooltest.dmp");
+		}
+	};
+
+	//RSA asynchronous generation test
+	class RSAAsyncTest:public singleTest
+	{
+	public:
+		RSAAsyncTest():singleTest("Async Generation"){}
+		virtual ~RSAAsyncTest(){}
+
+		void test()
+		{
+			std::string locString = "publicKeyTest.h, RSAAsyncTest::test()";
+			crypto::publicKeyPackage<crypto::publicRSA> pkg(crypto::size::public256);
+
+			try
+			{
+				//Many keys share the worker pool
+				std::vector<std::future<os::smart_ptr<crypto::publicKey> > > futures;
+				for(unsigned int i=0;i<8;++i)
+					futures.push_back(pkg.generateAsync());
+				for(unsigned int i=0;i<futures.size();++i)
+				{
+					os::smart_ptr<crypto::publicKey> key=futures[i].get();
+					if(!key || key->generating() || !roundTrip(*key))
+						throw os::smart_ptr<std::exception>(new generalTestException("Future key failed",locString),os::shared_type);
+				}
+
+				//Completion callback
+				std::mutex callLock;
+				std::condition_variable callDone;
+				os::smart_ptr<crypto::publicKey> called;
+				bool done=false;
+				pkg.generateAsync([&](os::smart_ptr<crypto::publicKey> key)
+				{
+					std::lock_guard<std::mutex> lock(callLock);
+					called=key;
+					done=true;
+					callDone.notify_all();
+				});
+				{
+					std::unique_lock<std::mutex> lock(callLock);
+					while(!done) callDone.wait(lock);
+				}
+				if(!called || !roundTrip(*called))
+					throw os::smart_ptr<std::exception>(new generalTestException("Callback key failed",locString),os::shared_type);
+
+				//Rotation resolves once bound
+				crypto::publicRSA pk(crypto::size::public256);
+				if(!pk.generateNewKeysAsync().get())
+					throw os::smart_ptr<std::exception>(new generalTestException("Initial generation failed",locString),os::shared_type);
+				os::smart_ptr<crypto::number> oldN=pk.getN();
+				if(!pk.generateNewKeysAsync().get() || pk.generating())
+					throw os::smart_ptr<std::exception>(new generalTestException("Rotation failed",locString),os::shared_type);
+				if(*pk.getN()==*oldN || *pk.getOldN()!=*oldN || !roundTrip(pk))
+					throw os::smart_ptr<std::exception>(new generalTestException("Rotated keys not bound",locString),os::shared_type);
+
+				//Cancelled generation binds nothing
+				os::smart_ptr<crypto::generationToken> token(new crypto::generationToken(),os::shared_type);
+				token->cancel();
+				if(pkg.generateAsync(token).get())
+					throw os::smart_ptr<std::exception>(new generalTestException("Cancelled future returned a key",locString),os::shared_type);
+				oldN=pk.getN();
+				if(pk.generateNewKeysAsync(token).get() || *pk.getN()!=*oldN)
+					throw os::smart_ptr<std::exception>(new generalTestException("Cancelled rotation bound keys",locString),os::shared_type);
+
+				//Destroyed while generating
+				{
+					crypto::publicRSA big(crypto::size::public2048);
+				}
+			}
+			catch(crypto::errorPointer e)
+			{
+				throw os::smart_ptr<std::exception>(new generalTestException(e->errorTitle(),e->errorDescription()),os::shared_type);
+			}
+		}
+	};
+
+	//Batch encode and decode test
+	template <class pkType,class numberType>
+	class batchKeyTest:public singleTest
+	{
+		uint16_t publicLen;
+	public:
+		batchKeyTest(uint16_t pl):singleTest("Batch Test: "+std::to_string((long long unsigned int)pl*32)){publicLen=pl;}
+		virtual ~batchKeyTest(){}
+
+		void test()
+		{
+			std::string locString = "publicKeyTest.h, batchKeyTest::test()";
+			crypto::workerPool::setThreads(3);
+
+			try
+			{
+				os::smart_ptr<pkType> pk1=getStaticKeys<pkType>(publicLen,0);
+				crypto::publicKeyPackage<pkType> pkg(publicLen);
+
+				std::vector<os::smart_ptr<crypto::number> > codes;
+				for(unsigned int i=0;i<10;++i)
+				{
+					numberType n1(publicLen);
+					for(uint16_t j=0;j<publicLen-1;++j)
+						n1[j]=rand();
+					codes.push_back(os::smart_ptr<crypto::number>(new numberType(n1),os::shared_type));
+				}
+
+				//Results match single calls, in order
+				std::vector<os::smart_ptr<crypto::number> > enc=pkg.encodeBatch(codes,pk1->getN());
+				std::vector<os::smart_ptr<crypto::number> > memberEnc=pk1->encodeBatch(codes);
+				std::vector<os::smart_ptr<crypto::number> > dec=pk1->decodeBatch(enc);
+				if(enc.size()!=codes.size() || dec.size()!=codes.size())
+					throw os::smart_ptr<std::exception>(new generalTestException("Batch size mismatch",locString),os::shared_type);
+				for(unsigned int i=0;i<codes.size();++i)
+				{
+					if(*enc[i]!=*pk1->encode(codes[i]) || *memberEnc[i]!=*enc[i])
+						throw os::smart_ptr<std::exception>(new generalTestException("Batch encode failed",locString),os::shared_type);
+					if(*dec[i]!=*codes[i])
+						throw os::smart_ptr<std::exception>(new generalTestException("Batch decode failed",locString),os::shared_type);
+				}
+
+				//Byte buffers
+				unsigned int len=publicLen*sizeof(uint32_t);
+				std::vector<os::smart_ptr<unsigned char> > bufs;
+				std::vector<unsigned char*> ptrs;
+				for(unsigned int i=0;i<4;++i)
+				{
+					bufs.push_back(os::smart_ptr<unsigned char>(new unsigned char[len],os::shared_type_array));
+					memset(bufs[i].get(),0,len);
+					for(unsigned int j=0;j<len-1;++j)
+						bufs[i][j]=rand();
+					ptrs.push_back(bufs[i].get());
+				}
+				os::smart_ptr<unsigned char> first(new unsigned char[len],os::shared_type_array);
+				memcpy(first.get(),bufs[0].get(),len);
+				pkg.encodeBatch(ptrs.data(),ptrs.size(),len,pk1->getN());
+				pk1->decodeBatch(ptrs.data(),ptrs.size(),len);
+				if(memcmp(first.get(),bufs[0].get(),len)!=0)
+					throw os::smart_ptr<std::exception>(new generalTestException("Batch byte encryption failed",locString),os::shared_type);
+			}
+			catch(crypto::errorPointer ep)
+			{
+				crypto::workerPool::setThreads(0);
+				throw os::smart_ptr<std::exception>(new generalTestException(ep->what(),locString),os::shared_type);
+			}
+			catch(os::smart_ptr<std::exception> e)
+			{
+				crypto::workerPool::setThreads(0);
+				throw e;
+			}
+			crypto::workerPool::setThreads(0);
+		}
+	};
+
     //General public key Test suite
     template <class pkType, class numberType>
     class publicKeySuite:public testSuite
@@ -294,6 +850,9 @@ namespace test
             pushTest(os::smart_ptr<singleTest>(new publicKeySearchTest<pkType,numberType>(crypto::size::public2048),os::shared_type));
 
 			pushTest(os::smart_ptr<singleTest>(new packageSearchTest<pkType>(),os::shared_type));
+
+			pushTest(os::smart_ptr<singleTest>(new batchKeyTest<pkType,numberType>(crypto::size::public512),os::shared_type));
+			pushTest(os::smart_ptr<singleTest>(new batchKeyTest<pkType,numberType>(crypto::size::public2048),os::shared_type));
         }
         virtual ~publicKeySuite(){}
     };
@@ -302,7 +861,14 @@ namespace test
     {
     public:
         RSASuite():publicKeySuite<crypto::publicRSA,crypto::integer>("RSA")
-        {}
+        {
+			pushTest(os::smart_ptr<singleTest>(new RSACRTTest(),os::shared_type));
+			pushTest(os::smart_ptr<singleTest>(new RSAContextTest(),os::shared_type));
+			pushTest(os::smart_ptr<singleTest>(new RSAMultiPrimeTest(),os::shared_type));
+			pushTest(os::smart_ptr<singleTest>(new RSALargeKeyTest(),os::shared_type));
+			pushTest(os::smart_ptr<singleTest>(new RSAKeyPoolTest(),os::shared_type));
+			pushTest(os::smart_ptr<singleTest>(new RSAAsyncTest(),os::shared_type));
+		}
         virtual ~RSASuite(){}
     };
 }
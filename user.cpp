@@ -718,9 +718,13 @@ namespace crypto {
 			memcpy(ret+trc,hsh.data(),hsh.size());
 			trc+=stmpk->hashSize();
 
-			for(uint16_t i=0;i<targKey->keySize()*4;++i)
-				ret[trc+i]=rand();
-			ret[trc+targKey->keySize()*4-1]=rand()&0x0F;
+			if(!cryptoRandomFill(ret+trc,targKey->keySize()*4))
+			{
+				delete [] ret;
+				len=0;
+				throw errorPointer(new randomSeedError(),os::shared_type);
+			}
+			ret[trc+targKey->keySize()*4-1]&=0x0F;
 			cipher=stmpk->buildStream(ret+trc,targKey->keySize()*4);
 			trc+=targKey->keySize()*4;
 			cipherStart=trc;
@@ -903,9 +907,13 @@ namespace crypto {
 		size_t cipherStart;
 		size_t tempLen;
 
-		for(int i=0;i<targKey->keySize()*4;++i)
-			ret[trc+i]=rand();
-		ret[trc+targKey->keySize()*4-1]=rand()&0x0F;
+		if(!cryptoRandomFill(ret+trc,targKey->keySize()*4))
+		{
+			delete [] ret;
+			finishedLen=0;
+			throw errorPointer(new randomSeedError(),os::shared_type);
+		}
+		ret[trc+targKey->keySize()*4-1]&=0x0F;
 		cipher=stmpk->buildStream(ret+trc,targKey->keySize()*4);
 		trc+=targKey->keySize()*4;
 		cipherStart=trc;
@@ -0,0 +1,174 @@
+/**
+ * @file   workerPool.cpp
+ * @author Jonathan Bedard
+ * @date   10/18/2026
+ * @brief  Implementation of the worker pool
+ * @bug No known bugs.
+ *
+ * Implements the worker threads batch
+ * operations run on.  Consult workerPool.h
+ * for details.
+ *
+ */
+
+///@cond INTERNAL
+
+#ifndef WORKER_POOL_CPP
+#define WORKER_POOL_CPP
+
+#include "workerPool.h"
+
+namespace crypto
+{
+	//Threads per batch
+	std::atomic<unsigned int> workerPool::_threads(0);
+	void workerPool::setThreads(unsigned int threads)
+	{
+		_threads=threads;
+	}
+	unsigned int workerPool::threads()
+	{
+		unsigned int threads=_threads;
+		if(threads==0) threads=std::thread::hardware_concurrency();
+		if(threads==0) threads=1;
+		return threads;
+	}
+
+	//Process-wide pool
+	os::smart_ptr<workerPool> workerPool::singleton()
+	{
+		static os::smart_ptr<workerPool> _singleton(new workerPool(),os::shared_type);
+		return _singleton;
+	}
+
+	//Default constructor
+	workerPool::workerPool()
+	{
+		_stop=false;
+	}
+	//Stop and join workers
+	workerPool::~workerPool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(_lock);
+			_stop=true;
+		}
+		_wake.notify_all();
+		for(size_t i=0;i<_workers.size();++i)
+			_workers[i].join();
+	}
+
+	//Claim indices until none are left
+	void workerPool::runBatch(batch& bt)
+	{
+		while(true)
+		{
+			size_t index=bt.next++;
+			if(index>=bt.count) return;
+			try
+			{
+				(*bt.task)(index);
+			}
+			catch(...)
+			{
+				std::lock_guard<std::mutex> lock(_lock);
+				if(!bt.error) bt.error=std::current_exception();
+				bt.next=bt.count;
+			}
+		}
+	}
+	//Join open batches, then run posted tasks
+	void workerPool::workerLoop()
+	{
+		std::unique_lock<std::mutex> lock(_lock);
+		while(!_stop)
+		{
+			batch* bt=NULL;
+			for(auto it=_queue.begin();it!=_queue.end();++it)
+			{
+				if((*it)->active<(*it)->helpers && (*it)->next<(*it)->count)
+				{
+					bt=*it;
+					break;
+				}
+			}
+			if(!bt && !_tasks.empty())
+			{
+				//Task is released before re-locking
+				{
+					std::function<void()> task=std::move(_tasks.front());
+					_tasks.pop_front();
+					lock.unlock();
+					try{task();}
+					catch(...){}
+				}
+				lock.lock();
+				continue;
+			}
+			if(!bt)
+			{
+				_wake.wait(lock);
+				continue;
+			}
+
+			bt->active++;
+			lock.unlock();
+			runBatch(*bt);
+			lock.lock();
+			bt->active--;
+			if(bt->active==0) _finished.notify_all();
+		}
+	}
+
+	//Fan a task out across the workers
+	void workerPool::parallelFor(size_t count,const std::function<void(size_t)>& task)
+	{
+		if(count==0) return;
+		unsigned int helpers=threads()-1;
+		if(helpers>count-1) helpers=(unsigned int)(count-1);
+		if(helpers==0)
+		{
+			for(size_t i=0;i<count;++i)
+				task(i);
+			return;
+		}
+
+		batch bt;
+		bt.task=&task;
+		bt.count=count;
+		bt.next=0;
+		bt.helpers=helpers;
+		bt.active=0;
+		{
+			std::lock_guard<std::mutex> lock(_lock);
+			while(_workers.size()<helpers)
+				_workers.push_back(std::thread(&workerPool::workerLoop,this));
+			_queue.push_back(&bt);
+		}
+		_wake.notify_all();
+		runBatch(bt);
+
+		//No worker may join or hold the batch once it returns
+		std::unique_lock<std::mutex> lock(_lock);
+		_queue.remove(&bt);
+		while(bt.active>0)
+			_finished.wait(lock);
+		lock.unlock();
+		if(bt.error) std::rethrow_exception(bt.error);
+	}
+	//Queue for a worker
+	void workerPool::post(std::function<void()> task)
+	{
+		{
+			std::lock_guard<std::mutex> lock(_lock);
+			_tasks.push_back(std::move(task));
+			while(_workers.size()<threads())
+				_workers.push_back(std::thread(&workerPool::workerLoop,this));
+		}
+		_wake.notify_one();
+	}
+}
+
+#endif
+
+///@endcond
@@ -0,0 +1,159 @@
+/**
+ * @file   workerPool.h
+ * @author Jonathan Bedard
+ * @date   10/18/2026
+ * @brief  Worker threads for batch operations
+ * @bug No known bugs.
+ *
+ * Declares the pool of worker threads which
+ * batch public key operations fan out across
+ * and asynchronous key generation runs on.
+ * Workers start on first use and idle between
+ * batches, so a batch does not pay for thread
+ * creation.
+ *
+ */
+
+#ifndef WORKER_POOL_H
+#define WORKER_POOL_H
+
+#include "Datastructures/Datastructures.h"
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace crypto
+{
+	/** @brief Shared worker threads
+	 *
+	 * Runs a task over a range of indices on
+	 * up to crypto::workerPool::threads() threads,
+	 * the calling thread included.  The caller
+	 * always works on its own batch, so a task
+	 * may itself start a batch.
+	 */
+	class workerPool
+	{
+		/** @brief Range of indices being processed
+		 */
+		struct batch
+		{
+			/** @brief Task run on each index
+			 */
+			const std::function<void(size_t)>* task;
+			/** @brief Number of indices
+			 */
+			size_t count;
+			/** @brief Next unclaimed index
+			 */
+			std::atomic<size_t> next;
+			/** @brief Workers which may join
+			 */
+			unsigned int helpers;
+			/** @brief Workers currently in the batch
+			 */
+			unsigned int active;
+			/** @brief First error thrown by the task
+			 */
+			std::exception_ptr error;
+		};
+
+		/** @brief Number of threads per batch
+		 *
+		 * Zero selects the hardware concurrency.
+		 */
+		static std::atomic<unsigned int> _threads;
+
+		/** @brief Protects the pool state
+		 */
+		std::mutex _lock;
+		/** @brief Signals workers of a new batch
+		 */
+		std::condition_variable _wake;
+		/** @brief Signals callers of finished workers
+		 */
+		std::condition_variable _finished;
+		/** @brief Batches open to workers
+		 */
+		std::list<batch*> _queue;
+		/** @brief Posted tasks, oldest first
+		 */
+		std::list<std::function<void()> > _tasks;
+		/** @brief Worker threads
+		 */
+		std::vector<std::thread> _workers;
+		/** @brief Stops the workers
+		 */
+		bool _stop;
+
+		/** @brief Claim and run indices
+		 * @param [in/out] bt Batch to work on
+		 * @return void
+		 */
+		void runBatch(batch& bt);
+		/** @brief Worker thread loop
+		 * @return void
+		 */
+		void workerLoop();
+	public:
+		/** @brief Default constructor
+		 */
+		workerPool();
+		/** @brief Virtual destructor
+		 *
+		 * Stops and joins the worker threads.
+		 */
+		virtual ~workerPool();
+
+		/** @brief Process-wide pool
+		 * @return Pool shared by batch operations
+		 */
+		static os::smart_ptr<workerPool> singleton();
+		/** @brief Sets the number of threads per batch
+		 *
+		 * Counts the calling thread.  Zero, the default,
+		 * uses the hardware concurrency and one runs
+		 * batches on the calling thread alone.
+		 *
+		 * @param [in] threads Number of threads, 0 for hardware concurrency
+		 * @return void
+		 */
+		static void setThreads(unsigned int threads);
+		/** @brief Number of threads per batch
+		 * @return Threads used by a batch, at least 1
+		 */
+		static unsigned int threads();
+
+		/** @brief Run a task over a range
+		 *
+		 * Calls task once for every index below count
+		 * and returns when all calls are finished.  If
+		 * calls throw, the remaining indices are skipped
+		 * and the first exception is re-thrown.
+		 *
+		 * @param [in] count Number of indices
+		 * @param [in] task Task, safe to call concurrently
+		 * @return void
+		 */
+		void parallelFor(size_t count,const std::function<void(size_t)>& task);
+		/** @brief Queue a task
+		 *
+		 * Returns immediately, a worker runs the task
+		 * once earlier tasks have started.  Posted tasks
+		 * run on at most crypto::workerPool::threads()
+		 * workers, open batches are joined first.
+		 * Exceptions thrown by the task are discarded.
+		 *
+		 * @param [in] task Task to run
+		 * @return void
+		 */
+		void post(std::function<void()> task);
+	};
+}
+
+#endif